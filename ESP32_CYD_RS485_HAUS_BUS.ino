@@ -18,6 +18,19 @@
 #include "service_manager.h"
 #include <EEPROM.h>
 #include "header_display.h"
+#include "report_scheduler.h"
+#include "timer_wheel.h"
+#include "profiler.h"
+#include "serial_commands.h"
+#include "trace.h"
+#include "stall_monitor.h"
+#include "idle_manager.h"
+#include "cpu_freq.h"
+#include "boot_report.h"
+#include "rtc_snapshot.h"
+#include "ui_compositor.h"
+#include "spi_bus.h"
+#include "screensaver.h"
 
 // *** NEU: Display-Kalibrierung (nur für Inbetriebnahme) ***
 #include "display_calibration.h"
@@ -27,9 +40,6 @@
 // *** NUR DAS TFT-OBJEKT DEFINIEREN ***
 TFT_eSPI tft = TFT_eSPI();
 
-// Timing für Hintergrundbeleuchtungs-Status  
-unsigned long lastBacklightStatusTime = 0;
-
 // *** NEU: Button-Timing Variablen ***
 struct ButtonTiming {
     bool touchActive;
@@ -57,13 +67,26 @@ ButtonTiming buttonTiming = {
 // *** NEU: Externe Funktion aus communication.cpp ***
 extern void applyAllPendingLedStates();
 
+// *** NEU: Aufgaben im Timer-Rad für Button-Timing und Timeout-Warnung ***
+int buttonConfirmTimerId = -1;
+int buttonTimeoutTimerId = -1;
+int timeoutWarningTimerId = -1;
+
 // Timing-Konstanten
 const unsigned long BUTTON_CONFIRM_DELAY = 50;    // 50ms Verzögerung für STATUS.1
 const unsigned long BUTTON_MAX_TIMEOUT = 10000;   // 10 Sekunden maximale Druckzeit
 
 void setup() {
   Serial.begin(115200);
-  delay(100);
+  
+  // *** NEU: Boot in Stufen - Bus zuerst, Display danach, Konfiguration und Menü verzögert ***
+  bootStage("core");
+  
+  // *** NEU: Stall-Überwachung zuerst (gibt das Log des letzten Boots aus) ***
+  setupStallMonitor();
+  
+  // *** NEU: Zustand des letzten Boots aus dem RTC-Speicher prüfen (Warmstart) ***
+  setupRtcSnapshot();
 
     #if DB_INFO == 1
       Serial.println("\nESP32 Touch-Panel - Touch-Modus System");
@@ -88,83 +111,111 @@ void setup() {
   Serial.print("SCREEN_WIDTH: "); Serial.println(SCREEN_WIDTH);
   Serial.print("SCREEN_HEIGHT: "); Serial.println(SCREEN_HEIGHT);
   
-  // *** NEU: DISPLAY-KALIBRIERUNG (vor allem anderen!) ***
-  #ifdef DISPLAY_CALIBRATION_H
-    startDisplayCalibration();
-    
-    // Optional: Warten auf Bestätigung vor normalem Start
-    Serial.println("Drücken Sie Enter um mit normalem Betrieb fortzufahren...");
-    while (!Serial.available()) {
-      delay(100);
-    }
-    Serial.readString(); // Input lesen
-  #endif
-
   // *** NEU: Service-Manager initialisieren (lädt gespeicherte Konfiguration) ***
+  // Device ID aus dem EEPROM wird für die Adressierung am Bus gebraucht
+  bootStage("serviceConfig");
   setupServiceManager();
   
+  // ===== Stufe 1: Bus =====
+  // Kommunikation initialisieren (mit CSMA/CD)
+  bootStage("bus");
+  setupCommunication();
+  
+  // *** NEU: Serial-Befehle (Module registrieren ihre Befehle im Setup) ***
+  setupSerialCommands();
+  
+  // *** NEU: Loop-Profiler (nur mit ENABLE_LOOP_PROFILER == 1 aktiv) ***
+  setupProfiler();
+  
+  // *** NEU: Ereignis-Trace (Ringpuffer, Export über /api/trace) ***
+  setupTrace();
+  
+  // *** NEU: Periodische und einmalige Aufgaben im Timer-Rad ***
+  timerWheelAddPeriodic("header", HEADER_UPDATE_INTERVAL, [](void*) {
+    PROFILE_SCOPE(PROF_HEADER);
+    if (!serviceManager.isServiceMode()) {  // Nur im Hauptmenü
+      updateHeaderTime();
+    }
+  });
+  buttonConfirmTimerId = timerWheelRegister("btnConfirm", [](void*) {
+    PROFILE_SCOPE(PROF_BUTTON_TIMING);
+    onButtonConfirmTimer();
+  });
+  buttonTimeoutTimerId = timerWheelRegister("btnTimeout", [](void*) {
+    PROFILE_SCOPE(PROF_BUTTON_TIMING);
+    onButtonTimeoutTimer();
+  });
+  timeoutWarningTimerId = timerWheelRegister("btnWarning", [](void*) { uiHideOverlay(); });
+  
+  // UART ist offen und puffert eingehende Bytes - ausgeführt werden Telegramme
+  // erst ab updateCommunication() im ersten loop()-Durchlauf
+  bootMarkBusReady();
+  
+  // ===== Stufe 2: Display und Eingabe =====
+  // Bleibt in setup(): uiRender() läuft ab dem ersten loop()-Durchlauf und zeichnet
+  // mit den Band-Puffern aus setupUiCompositor(), die ein initialisiertes TFT brauchen.
+  // Empfangene LED-Telegramme markieren Buttons nur (Compositor), zeichnen nicht selbst.
+  bootStage("display");
+  
   // *** NEU: Header-Display initialisieren ***
   setupHeaderDisplay();
+  restoreRtcSnapshotClock();
   
-// *** NEU: Converter Web Service initialisieren ***
-  Serial.println("🔄 Initialisiere Converter Web Service...");
-  if (!webConverter.begin()) {
-    Serial.println("❌ Converter Web Service konnte nicht initialisiert werden!");
-  } else {
-    Serial.println("✅ Converter Web Service erfolgreich initialisiert");
-    
-    // Callback für Konfigurationsänderungen setzen
-    webConverter.setConfigChangedCallback([](String configType) {
-      Serial.println("📡 Konfiguration geändert: " + configType);
-      
-      if (configType == "buttons") {
-        Serial.println("🔄 Aktualisiere Button-Display...");
-        drawButtons();
-      } else if (configType == "system") {
-        Serial.println("🔄 Aktualisiere System-Konfiguration...");
-        // Header neu zeichnen falls Device ID geändert
-        if (!serviceManager.isServiceMode()) {
-          drawHeader();
-        }
-      }
-    });
-    
-    // Gespeicherte Konfiguration laden und anwenden
-    Serial.println("📥 Lade gespeicherte Button-Konfiguration...");
-    // webConverter.loadAll() wird bereits in begin() aufgerufen
-    webConverter.begin();
-    webConverter.printStatus();
-  }
-
   // *** NEU: Gespeicherte Orientierung anwenden ***
   if (serviceManager.getOrientation() != SCREEN_ORIENTATION) {
     Serial.println("DEBUG: Wende gespeicherte Orientierung an");
     serviceManager.setOrientation(serviceManager.getOrientation());
   }
   
-  // Kommunikation initialisieren (mit CSMA/CD)
-  setupCommunication();
-  
   // Initialisiere die RGB-LED
   setupLed();
   
   // Initialisiere Hintergrundbeleuchtung
   setupBacklight();
-  setBacklight(DEFAULT_BACKLIGHT);
+  setBacklight(getRestoredBacklight(DEFAULT_BACKLIGHT));  // Warmstart: letzte Helligkeit
+  
+  // *** NEU: Bildschirmschoner / automatisches Dimmen (DisplayConfig.screenTimeout) ***
+  setupScreensaver();
+  
+  // *** NEU: Display und Touch teilen sich den HSPI-Bus ***
+  setupSpiBus();
   
   // Initialisiere den Touchscreen
   setupTouch();
   
+  // *** NEU: Weck-Quellen für den Leerlauf (RS485, Touch-IRQ, andere Tasks) ***
+  setupIdleManager();
+  
+  // *** NEU: CPU-Takt abhängig von der Aktivität (80 / 240 MHz) ***
+  setupCpuFreq();
+  
   // Initialisiere die Button-IDs
   initializeButtons();
   
-  // Initialisiere das Display (nur falls Kalibrierung nicht lief)
-  #ifndef DISPLAY_CALIBRATION_H
+  // Initialisiere das Display
+  // *** GEÄNDERT: Kalibrierung nur mit DISPLAY_CALIBRATION_AT_BOOT und erst nach der
+  // Stufe "bus" (initialisiert das TFT selbst; UART puffert, Loop steht währenddessen) ***
+  #if DISPLAY_CALIBRATION_AT_BOOT == 1
+  {
+    STALL_PHASE(STALL_PHASE_CALIBRATION);
+    startDisplayCalibration();
+    
+    // Optional: Bestätigung vor normalem Start (höchstens CALIBRATION_CONFIRM_TIMEOUT_MS)
+    Serial.println("Drücken Sie Enter um mit normalem Betrieb fortzufahren...");
+    if (waitForSerialInput()) {
+      Serial.readString(); // Input lesen
+    }
+  }
+  #else
     setupDisplay();
   #endif
   
+  // *** NEU: Band-Puffer und DMA für den Compositor (nach der TFT-Initialisierung) ***
+  setupUiCompositor();
+  
   // *** ERZWINGE PORTRAIT NACH ALLEM ***
   Serial.println("=== ERZWINGE PORTRAIT ===");
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.setRotation(SCREEN_ORIENTATION);
   Serial.print("Nach setRotation - TFT Rotation: "); 
   Serial.println(tft.getRotation());
@@ -173,7 +224,7 @@ void setup() {
   Serial.print("x"); 
   Serial.println(tft.height());
 
-  // Anzeige einiger Infos
+  // Anzeige einiger Infos (bleibt stehen, bis das Menü verzögert gezeichnet wird)
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   tft.drawCentreString("ESP32 ST7789 mit Header-Display", SCREEN_WIDTH/2, 40, 2);
@@ -181,53 +232,121 @@ void setup() {
   tft.drawCentreString("Initialisierung...", SCREEN_WIDTH/2, SCREEN_HEIGHT/2 + 20, 1);
   tft.drawCentreString("Device ID: " + serviceManager.getDeviceID(), SCREEN_WIDTH/2, SCREEN_HEIGHT - 50, 1);
   tft.drawCentreString("Button: 50ms + 10s Timeout", SCREEN_WIDTH/2, SCREEN_HEIGHT - 30, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
+  
+  // *** NEU: Backlight-Status über den Report-Scheduler ***
+  // Erste Meldung nach gerätespezifischem Phasenversatz statt sofort beim Boot,
+  // damit nach einem Netzausfall nicht alle Panels gleichzeitig senden.
+  // Unveränderte Werte unterdrückt der Statuswert-Cache (sendStatusValue).
+  registerPeriodicReport("backlight", BACKLIGHT_STATUS_INTERVAL, []() { sendBacklightStatus(); });
+  
+  // ===== Stufe 3: Konfiguration und Menü (verzögert) =====
+  // Läuft im ersten loop()-Durchlauf aus timerWheelDispatch(), also noch vor dem
+  // ersten updateCommunication() - während setup() empfangene Telegramme werden erst
+  // danach ausgeführt und treffen so bereits auf die geladene Button-Konfiguration.
+  // Der Web-Server startet erst mit dem Service-Modus.
+  bootStage("firstLoop");
+  int bootDeferredTimerId = timerWheelRegister("bootDeferred", [](void*) { bootDeferred(); });
+  timerWheelStart(bootDeferredTimerId, 0);
+}
+
+// *** NEU: Verzögerter Teil des Boots (einmalig über das Timer-Rad) ***
+void bootDeferred() {
+  // *** NEU: Converter Web Service initialisieren (SPIFFS + gespeicherte Buttons) ***
+  bootStage("converter");
+  Serial.println("🔄 Initialisiere Converter Web Service...");
+  if (!webConverter.begin()) {
+    Serial.println("❌ Converter Web Service konnte nicht initialisiert werden!");
+  } else {
+    Serial.println("✅ Converter Web Service erfolgreich initialisiert");
+    
+    // Callback für Konfigurationsänderungen setzen
+    webConverter.setConfigChangedCallback([](String configType) {
+      Serial.println("📡 Konfiguration geändert: " + configType);
+      
+      if (configType == "buttons") {
+        Serial.println("🔄 Aktualisiere Button-Display...");
+        drawButtons();
+      } else if (configType == "system") {
+        Serial.println("🔄 Aktualisiere System-Konfiguration...");
+        // Header neu zeichnen falls Device ID geändert
+        if (!serviceManager.isServiceMode()) {
+          drawHeader();
+        }
+      }
+    });
+    // Gespeicherte Konfiguration lädt bereits begin() (loadAll) - kein zweiter Aufruf
+  }
   
-  // Erste Statusmeldung der Hintergrundbeleuchtung
-  sendBacklightStatus();
-  lastBacklightStatusTime = millis();
+  // Gehe direkt zum Menü (ohne feste Wartezeit für den Startbildschirm)
+  bootStage("menu");
+  loadMenuButtons();
   
-  delay(3000);  // Längere Anzeige für neue Infos
+  // *** NEU: Button-Zustände aus dem RTC-Schnappschuss (Warmstart ohne Bus-Verkehr) ***
+  // Vor dem ersten Zeichnen - sonst stünden kurz die Standardfarben auf dem Display
+  restoreRtcSnapshotButtons();
+  drawMenuScene();
   
-  // Gehe direkt zum Menü
-  showMenu();
+  bootComplete();
 }
 
 void loop() {
-  // LED-Status aktualisieren
-  updateLedStatus();
-  
-  // Service-Manager Update
-  updateServiceManager();
+  // *** NEU: Profiler-Reset aus dem Web-Task (kein Messabschnitt offen) ***
+  processProfilerReset();
   
-  // *** NEU: Button-Timing verwalten ***
-  updateButtonTiming();
-  
-  // Header-Zeit aktualisieren (alle 1000ms)
-  static unsigned long lastHeaderUpdate = 0;
-  if (millis() - lastHeaderUpdate > 1000) {
-    if (!serviceManager.isServiceMode()) {  // Nur im Hauptmenü
-      updateHeaderTime();
+  {
+    // *** NEU: Laufzeit des gesamten Durchlaufs messen (Loop-Frequenz) ***
+    PROFILE_SCOPE(PROF_LOOP);
+    STALL_PHASE(STALL_PHASE_LOOP);
+    
+    // *** NEU: Fällige Aufgaben aus dem Timer-Rad ausführen ***
+    // (Header-Uhr, Sendepuffer, LED-Timeout, Button-Timing, Service-Fortschritt,
+    //  Statusmeldungen, Statistik)
+    {
+      PROFILE_SCOPE(PROF_TIMER_WHEEL);
+      STALL_PHASE(STALL_PHASE_TIMER);
+      processReportReschedule();  // Device ID aus dem Web-Task geändert
+      timerWheelDispatch();
+    }
+    
+    // Kommunikation mit CSMA/CD verwalten (Empfang)
+    updateCommunication();
+    
+    // *** NEU: Touch-Eingaben über nicht-blockierende Zustandsmaschine ***
+    // (Entprellung und Abtastrate in pollTouch, kein delay(50) mehr)
+    handleTouchInput();
+    
+    // *** NEU: Markierte Bereiche (Buttons, Header, Overlay) zeichnen ***
+    {
+      PROFILE_SCOPE(PROF_RENDER);
+      STALL_PHASE(STALL_PHASE_DRAW);
+      processScreensaver();    // Einstellungen aus dem Web-Task übernehmen
+      processBacklightWake();  // Helligkeit aus dem Web-Task: aus dunkel erst zeichnen, dann Licht an
+      uiRender();
     }
-    lastHeaderUpdate = millis();
   }
   
-  // Kommunikation mit CSMA/CD verwalten
-  updateCommunication();
+  // *** NEU: CPU-Takt nachführen (zwischen den Messabschnitten, Profiler rechnet um) ***
+  updateCpuFreq();
+  
+  // *** NEU: Bis zum nächsten Ereignis warten (außerhalb von Profiler und Stall-Überwachung) ***
+  idleUntilNextEvent();
+}
+
+// Touch abfragen und an Service-Manager, Service-Icon oder Buttons weiterleiten
+void handleTouchInput() {
+  PROFILE_SCOPE(PROF_TOUCH);
+  STALL_PHASE(STALL_PHASE_TOUCH);
+  
+  int x, y;
+  TouchPollResult touchResult = pollTouch(&x, &y);
   
-  // Prüfen, ob ein Statusupdate für die Hintergrundbeleuchtung fällig ist
-  unsigned long currentMillis = millis();
-  if (currentMillis - lastBacklightStatusTime >= BACKLIGHT_STATUS_INTERVAL) {
-    sendBacklightStatus();
-    lastBacklightStatusTime = currentMillis;
+  // *** NEU: Touch weckt den Bildschirmschoner und löst dabei keinen Button aus ***
+  if (screensaverHandleTouch(touchResult)) {
+    return;
   }
   
-  // Touch-Eingaben verarbeiten
-  if (touchscreen.tirqTouched() && touchscreen.touched()) {
-        delay(50);
-        
-        int x, y;
-        getTouchPoint(&x, &y);
-        
+  if (touchResult == TOUCH_POLL_PRESSED) {
         Serial.print("DEBUG: Touch bei X=");
         Serial.print(x);
         Serial.print(", Y=");
@@ -250,7 +369,7 @@ void loop() {
         
         // *** NUR DANN Button-Touch verarbeiten ***
         handleButtonTouch(x, y);
-    } else {
+    } else if (touchResult == TOUCH_POLL_RELEASED) {
     // *** Touch nicht aktiv - prüfe ob Button-Timing läuft ***
     if (buttonTiming.touchActive) {
       // Touch wurde losgelassen
@@ -262,13 +381,6 @@ void loop() {
       handleServiceTouch(0, 0, false);  // Touch = false
     }
   }
-  
-  // Statistiken alle 60 Sekunden ausgeben (optional)
-  static unsigned long lastStatsOutput = 0;
-  if (millis() - lastStatsOutput > 60000) {
-    printCommunicationStats();
-    lastStatsOutput = millis();
-  }
 }
 
 // *** NEUE FUNKTION: Timing-basierte Button-Touch-Verarbeitung ***
@@ -278,11 +390,7 @@ void handleButtonTouch(int x, int y) {
         int buttonPressed = checkButtonPress(x, y);
         if (buttonPressed >= 0) {
             if (!buttonTiming.touchActive || buttonTiming.activeButtonIndex != buttonPressed) {
-                buttonTiming.touchActive = true;
-                buttonTiming.touchStartTime = millis();
-                buttonTiming.status1Sent = false;
-                buttonTiming.activeButtonIndex = buttonPressed;
-                setButtonActive(buttonPressed, true);
+                startButtonTiming(buttonPressed);
             }
         }
         return;
@@ -339,15 +447,23 @@ void handleButtonTouch(int x, int y) {
                 Serial.println(")");
             #endif
             
-            buttonTiming.touchActive = true;
-            buttonTiming.touchStartTime = millis();
-            buttonTiming.status1Sent = false;
-            buttonTiming.activeButtonIndex = buttonPressed;
-            setButtonActive(buttonPressed, true);
+            startButtonTiming(buttonPressed);
         }
     }
 }
 
+// *** NEU: Button-Timing starten (STATUS.1 nach 50ms, Timeout nach 10s über das Timer-Rad) ***
+void startButtonTiming(int buttonIndex) {
+    buttonTiming.touchActive = true;
+    buttonTiming.touchStartTime = millis();
+    buttonTiming.status1Sent = false;
+    buttonTiming.activeButtonIndex = buttonIndex;
+    setButtonActive(buttonIndex, true);
+    
+    timerWheelStart(buttonConfirmTimerId, BUTTON_CONFIRM_DELAY);
+    timerWheelStart(buttonTimeoutTimerId, BUTTON_MAX_TIMEOUT);
+}
+
 // *** NEUE FUNKTION: Button-Release-Verarbeitung ***
 void handleButtonRelease() {
   if (buttonTiming.touchActive && buttonTiming.activeButtonIndex >= 0) {
@@ -387,68 +503,65 @@ void handleButtonRelease() {
   }
 }
 
-// *** NEUE FUNKTION: Button-Timing Update (in loop() aufgerufen) ***
-void updateButtonTiming() {
-  if (!buttonTiming.touchActive) {
+// *** PHASE 1: Nach 50ms STATUS.1 senden (Einmal-Aufgabe im Timer-Rad) ***
+void onButtonConfirmTimer() {
+  if (!buttonTiming.touchActive || buttonTiming.status1Sent) {
     return; // Kein aktiver Button-Touch
   }
   
-  unsigned long elapsed = millis() - buttonTiming.touchStartTime;
+  #if DB_INFO == 1
+    Serial.println("DEBUG: 50ms erreicht - sende STATUS.1");
+  #endif
   
-  // *** PHASE 1: Nach 50ms STATUS.1 senden ***
-  if (elapsed >= BUTTON_CONFIRM_DELAY && !buttonTiming.status1Sent) {
-    
-    #if DB_INFO == 1
-      Serial.println("DEBUG: 50ms erreicht - sende STATUS.1");
-    #endif
-    
-    // STEIGENDE FLANKE: STATUS.1 senden
-    sendTelegram("BTN", buttons[buttonTiming.activeButtonIndex].instanceID, "STATUS", "1");
-    
-    // Button als gedrückt markieren
-    buttons[buttonTiming.activeButtonIndex].pressed = true;
-    buttonTiming.status1Sent = true;
-    
-    #if DB_INFO == 1
-      Serial.println("DEBUG: STEIGENDE FLANKE - Telegramm STATUS.1 gesendet");
-    #endif
+  // STEIGENDE FLANKE: STATUS.1 senden
+  sendTelegram("BTN", buttons[buttonTiming.activeButtonIndex].instanceID, "STATUS", "1");
+  
+  // Button als gedrückt markieren
+  buttons[buttonTiming.activeButtonIndex].pressed = true;
+  buttonTiming.status1Sent = true;
+  
+  #if DB_INFO == 1
+    Serial.println("DEBUG: STEIGENDE FLANKE - Telegramm STATUS.1 gesendet");
+  #endif
+}
+
+// *** PHASE 2: Nach 10 Sekunden Timeout (Einmal-Aufgabe im Timer-Rad) ***
+void onButtonTimeoutTimer() {
+  if (!buttonTiming.touchActive) {
+    return; // Kein aktiver Button-Touch
   }
   
-  // *** PHASE 2: Nach 10 Sekunden Timeout ***
-  if (elapsed >= BUTTON_MAX_TIMEOUT) {
-    
-    #if DB_INFO == 1
-      Serial.println("DEBUG: 10-Sekunden Timeout erreicht - forciere STATUS.0");
-    #endif
-    
-    // Timeout erreicht - forciere STATUS.0
-    if (buttonTiming.status1Sent) {
-      sendTelegram("BTN", buttons[buttonTiming.activeButtonIndex].instanceID, "STATUS", "0");
-      
-      #if DB_INFO == 1
-        Serial.println("DEBUG: TIMEOUT - Telegramm STATUS.0 gesendet");
-      #endif
-    }
-    
-    // Button visuell deaktivieren
-    setButtonActive(buttonTiming.activeButtonIndex, false);
-    buttons[buttonTiming.activeButtonIndex].pressed = false;
+  #if DB_INFO == 1
+    Serial.println("DEBUG: 10-Sekunden Timeout erreicht - forciere STATUS.0");
+  #endif
+  
+  // Timeout erreicht - forciere STATUS.0
+  if (buttonTiming.status1Sent) {
+    sendTelegram("BTN", buttons[buttonTiming.activeButtonIndex].instanceID, "STATUS", "0");
     
     #if DB_INFO == 1
-      Serial.print("DEBUG: Button ");
-      Serial.print(buttonTiming.activeButtonIndex + 1);
-      Serial.println(" nach Timeout zurückgesetzt");
+      Serial.println("DEBUG: TIMEOUT - Telegramm STATUS.0 gesendet");
     #endif
-    
-    // *** NEU: Pending LED States anwenden ***
-    applyAllPendingLedStates();
-    
-    // Timeout-Warnung anzeigen (optional)
-    showTimeoutWarning();
-    
-    // Timing zurücksetzen
-    resetButtonTiming();
   }
+  
+  // Button visuell deaktivieren
+  setButtonActive(buttonTiming.activeButtonIndex, false);
+  buttons[buttonTiming.activeButtonIndex].pressed = false;
+  
+  #if DB_INFO == 1
+    Serial.print("DEBUG: Button ");
+    Serial.print(buttonTiming.activeButtonIndex + 1);
+    Serial.println(" nach Timeout zurückgesetzt");
+  #endif
+  
+  // *** NEU: Pending LED States anwenden ***
+  applyAllPendingLedStates();
+  
+  // Timeout-Warnung anzeigen (optional)
+  showTimeoutWarning();
+  
+  // Timing zurücksetzen
+  resetButtonTiming();
 }
 
 // *** NEUE FUNKTION: Button-Timing zurücksetzen ***
@@ -458,6 +571,9 @@ void resetButtonTiming() {
   buttonTiming.status1Sent = false;
   buttonTiming.activeButtonIndex = -1;
   
+  timerWheelStop(buttonConfirmTimerId);
+  timerWheelStop(buttonTimeoutTimerId);
+  
   #if DB_INFO == 1
     Serial.println("DEBUG: Button-Timing zurückgesetzt");
   #endif
@@ -469,15 +585,11 @@ void showTimeoutWarning() {
     Serial.println("DEBUG: Zeige Timeout-Warnung");
   #endif
   
-  // Kurze visuelle Warnung am unteren Bildschirmrand
-  tft.fillRect(0, SCREEN_HEIGHT - 30, SCREEN_WIDTH, 30, TFT_ORANGE);
-  tft.setTextColor(TFT_BLACK);
-  tft.drawCentreString("Button-Timeout (10s erreicht)", SCREEN_WIDTH/2, SCREEN_HEIGHT - 20, 1);
-  
-  delay(1000); // 1 Sekunde anzeigen
+  // Kurze visuelle Warnung am unteren Bildschirmrand (Overlay, nur dieser Bereich wird gezeichnet)
+  uiShowOverlay("Button-Timeout (10s erreicht)", TFT_ORANGE);
   
-  // Warnung entfernen - zurück zum normalen Menü
-  showMenu();
+  // Nach 1 Sekunde Warnung entfernen - nur der Overlay-Bereich wird neu gezeichnet
+  timerWheelStart(timeoutWarningTimerId, 1000);
 }
 
 void initializeButtons() {
@@ -503,6 +615,7 @@ void initializeButtons() {
 }
 
 void showStartupScreen() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   
@@ -532,6 +645,7 @@ void showStartupScreen() {
 // handleNormalTouch() - nicht mehr benötigt
 
 void redrawUIElements() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   // Test-Button neu zeichnen (falls vorhanden)
   if (SCREEN_WIDTH > 240) { // Nur bei ausreichender Breite
     tft.fillRect(SCREEN_WIDTH - 60, 5, 55, 30, TFT_BLUE);
@@ -1,6 +1,10 @@
 #include "backlight.h"
 #include "communication.h"
 #include "service_manager.h"  // ← NEU: ServiceManager Include hinzufügen
+#include "ui_compositor.h"
+#include "idle_manager.h"
+#include "screensaver.h"
+#include "timer_wheel.h"
 #include <Arduino.h>
 
 // Einige Definitionen für die direkte Register-Manipulation
@@ -13,6 +17,49 @@ int backlightValue = DEFAULT_BACKLIGHT;
 // PWM-Initialisierung Flag
 static bool pwmInitialized = false;
 
+// *** NEU: Display dunkel - Compositor zeichnet nicht (siehe isDisplayDark) ***
+volatile bool backlightDark = false;
+volatile int backlightPendingDuty = -1;  // Helligkeit aus dem Web-Task, übernommen im Loop
+
+// *** NEU: Tatsächlicher PWM-Wert und Hardware-Fade (Bildschirmschoner) ***
+// Der ESP32 kann einen laufenden LEDC-Fade nicht abbrechen - ledcWrite() würde bis zu
+// dessen Ende blockieren. Währenddessen angeforderte Werte werden danach gesetzt.
+int backlightDuty = 0;
+bool backlightFading = false;
+int backlightDeferredDuty = -1;
+int backlightFadeTimerId = -1;
+uint32_t backlightFades = 0;
+
+// Setzt die PWM (nur im Loop-Task) - vor dem Einschalten aus dunkel wird die Szene gezeichnet
+void backlightWriteDuty(int duty) {
+  if (duty == 0) {
+    backlightDark = true;
+  } else if (backlightDark) {
+    backlightDark = false;
+    uiRepaintBeforeWake();
+  }
+
+  if (backlightFading) {
+    backlightDeferredDuty = duty;
+    return;
+  }
+  ledcWrite(TFT_BL_PIN, duty);
+  backlightDuty = duty;
+}
+
+// Fade abgelaufen (Timer-Rad) - erst jetzt ist ein auf 0 gedimmtes Display dunkel
+void backlightFadeDone() {
+  backlightFading = false;
+  if (backlightDuty == 0) {
+    backlightDark = true;
+  }
+  if (backlightDeferredDuty >= 0) {
+    int duty = backlightDeferredDuty;
+    backlightDeferredDuty = -1;
+    backlightWriteDuty(duty);
+  }
+}
+
 
 // Initialisiere die Hintergrundbeleuchtung - KORRIGIERT: PWM sofort initialisieren
 void setupBacklight() {
@@ -21,6 +68,9 @@ void setupBacklight() {
   // PWM sofort initialisieren (wie im funktionierenden Test-Sketch)
   ledcAttach(TFT_BL_PIN, PWM_FREQ, PWM_RESOLUTION);
   pwmInitialized = true;
+  if (backlightFadeTimerId < 0) {
+    backlightFadeTimerId = timerWheelRegister("blFade", [](void*) { backlightFadeDone(); });
+  }
   
   Serial.print("DEBUG: PWM initialisiert - Pin: ");
   Serial.print(TFT_BL_PIN);
@@ -53,8 +103,18 @@ void setBacklight(int percent) {
     return;
   }
 
-  // PWM-Wert setzen
-  ledcWrite(TFT_BL_PIN, duty);
+  // *** GEÄNDERT: PWM, Fades und Zeichnen nur im Loop-Task - aus dem Web-Task dort übernehmen ***
+  if (!idleIsLoopTask()) {
+    backlightPendingDuty = duty;
+    idleWakeFromTask();
+    return;
+  }
+
+  // Helligkeit ausdrücklich gesetzt - Bildschirmschoner beginnt von vorn
+  screensaverReset();
+
+  // PWM-Wert setzen (aus dunkel: erst die Szene zeichnen, dann die Beleuchtung)
+  backlightWriteDuty(duty);
 
   // Detaillierte Debug-Ausgabe
   Serial.print("DEBUG: Hintergrundbeleuchtung gesetzt - ");
@@ -70,32 +130,78 @@ void setBacklight(int percent) {
   Serial.println(duty);
 }
 
+bool isDisplayDark() {
+  return backlightDark;
+}
+
+void processBacklightWake() {
+  int duty = backlightPendingDuty;
+  if (duty < 0) {
+    return;
+  }
+  backlightPendingDuty = -1;
+  screensaverReset();
+  backlightWriteDuty(duty);
+}
+
+bool backlightFadeTo(int percent, int fadeMs) {
+  if (backlightFading) {
+    return false;
+  }
+  int duty = map(constrain(percent, 0, 100), 0, 100, 0, 255);
+  if (duty == backlightDuty) {
+    backlightDark = (duty == 0);
+    return true;
+  }
+  if (duty > 0 && backlightDark) {
+    backlightDark = false;
+    uiRepaintBeforeWake();
+  }
+
+  if (!ledcFade(TFT_BL_PIN, backlightDuty, duty, fadeMs)) {
+    backlightWriteDuty(duty);
+    return true;
+  }
+  backlightDuty = duty;
+  backlightFading = true;
+  backlightFades++;
+  timerWheelStart(backlightFadeTimerId, fadeMs + 1);
+  return true;
+}
+
+void backlightRestore() {
+  backlightWriteDuty(map(currentBacklight, 0, 100, 0, 255));
+}
+
+bool isBacklightFading() {
+  return backlightFading;
+}
+
+int getEffectiveBacklight() {
+  return map(backlightDuty, 0, 255, 0, 100);
+}
+
+uint32_t getBacklightFadeCount() {
+  return backlightFades;
+}
+
 void setBacklightPWM(int value) {
   // Einfach die vorhandene setBacklight-Funktion nutzen
   setBacklight(value);
 }
 
 // Sendet den aktuellen Status der Hintergrundbeleuchtung
-void sendBacklightStatus() {
-  // *** KORRIGIERT: Device ID vom ServiceManager holen ***
-  String currentDeviceID = serviceManager.getDeviceID();
-  
-  // Telegramm manuell aufbauen um sicherzustellen, dass die richtige Device ID verwendet wird
-  String telegram = String((char)START_BYTE) + currentDeviceID + ".LBN.16.STATUS." + String(currentBacklight) + String((char)END_BYTE);
-  
+void sendBacklightStatus(bool force) {
   #if DB_TX_INFO == 1
-    Serial.print("DEBUG: Sende Backlight-Status mit Device ID ");
-    Serial.print(currentDeviceID);
-    Serial.print(": ");
+    Serial.print("DEBUG: Backlight-Status ");
     Serial.print(currentBacklight);
-    Serial.print("% - Telegramm: ");
-    Serial.println(telegram);
+    Serial.println(force ? "% (erzwungen)" : "%");
   #endif
   
-  // Direkt über CSMA/CD senden
-  if (!addToSendQueue(telegram, 7, false)) {  // Niedrige Priorität für Status
+  // *** NEU: Über den Statuswert-Cache - unveränderte Werte werden unterdrückt ***
+  if (!sendStatusValue("LBN", "16", currentBacklight, BACKLIGHT_STATUS_DEADBAND, force)) {
     #if DB_TX_INFO == 1
-      Serial.println("DEBUG: Konnte Backlight-Status nicht senden");
+      Serial.println("DEBUG: Backlight-Status nicht gesendet (unverändert oder Puffer voll)");
     #endif
   }
 }
\ No newline at end of file
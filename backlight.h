@@ -19,10 +19,33 @@ void setBacklightPWM(int value);  // Funktion deklarieren
 void setBacklightDigital(int percent);
 
 // Sendet den aktuellen Status der Hintergrundbeleuchtung
-void sendBacklightStatus();
+// Unveränderte Werte (innerhalb BACKLIGHT_STATUS_DEADBAND) werden unterdrückt,
+// force=true sendet immer (z.B. als Antwort auf GET)
+void sendBacklightStatus(bool force = false);
+
+// *** NEU: Display dunkel (Helligkeit 0) - der Compositor aktualisiert nur den Zustand
+// und zeichnet die Szene einmal, bevor die Beleuchtung wieder eingeschaltet wird ***
+bool isDisplayDark();
+
+// Aus einem anderen Task (Web) gesetzte Helligkeit übernehmen - im Loop vor uiRender()
+void processBacklightWake();
+
+// *** NEU: Hardware-Fade (LEDC) für den Bildschirmschoner - currentBacklight bleibt der
+// Sollwert. false, solange noch ein Fade läuft (nur im Loop-Task aufrufen) ***
+bool backlightFadeTo(int percent, int fadeMs);
+
+// Sollhelligkeit (currentBacklight) sofort wiederherstellen, aus dunkel vorher zeichnen
+void backlightRestore();
+
+bool isBacklightFading();
+
+// Tatsächliche Helligkeit an der PWM in % (inkl. Bildschirmschoner)
+int getEffectiveBacklight();
+
+// Anzahl gestarteter Hardware-Fades (Statistik)
+uint32_t getBacklightFadeCount();
 
 // Extern deklariert, wird in anderen Dateien verwendet
-extern unsigned long lastBacklightStatusTime;
 extern int currentBacklight;
 
 #endif // BACKLIGHT_H
\ No newline at end of file
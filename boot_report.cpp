@@ -0,0 +1,73 @@
+#include "boot_report.h"
+
+// Eine Boot-Stufe (Zeiten in µs seit Start des esp_timer)
+struct BootStageEntry {
+  const char* name;
+  uint32_t startUs;
+  uint32_t durationUs;
+};
+
+BootStageEntry bootStages[BOOT_MAX_STAGES];
+int bootStageCount = 0;
+bool bootStageOpen = false;
+
+uint32_t bootBusReadyUs = 0;
+uint32_t bootCompleteUs = 0;
+
+void bootCloseStage(uint32_t nowUs) {
+  if (bootStageOpen) {
+    BootStageEntry& stage = bootStages[bootStageCount - 1];
+    stage.durationUs = nowUs - stage.startUs;
+    bootStageOpen = false;
+  }
+}
+
+void bootStage(const char* name) {
+  uint32_t nowUs = micros();
+  bootCloseStage(nowUs);
+
+  if (bootStageCount >= BOOT_MAX_STAGES) {
+    return;
+  }
+  BootStageEntry& stage = bootStages[bootStageCount++];
+  stage.name = name;
+  stage.startUs = nowUs;
+  stage.durationUs = 0;
+  bootStageOpen = true;
+}
+
+void bootMarkBusReady() {
+  bootBusReadyUs = micros();
+  Serial.printf("Bus bereit nach %lu ms\n", (unsigned long)(bootBusReadyUs / 1000));
+}
+
+void bootComplete() {
+  bootCompleteUs = micros();
+  bootCloseStage(bootCompleteUs);
+  printBootReport();
+}
+
+void printBootReport() {
+  Serial.println("=== Boot-Bericht ===");
+  Serial.println("Stufe           Start ms   Dauer ms");
+  for (int i = 0; i < bootStageCount; i++) {
+    BootStageEntry& stage = bootStages[i];
+    Serial.printf("%-14s %9.1f %10.1f\n", stage.name,
+                  stage.startUs / 1000.0f, stage.durationUs / 1000.0f);
+  }
+  Serial.printf("Bus bereit:      %.1f ms\n", bootBusReadyUs / 1000.0f);
+  Serial.printf("Boot komplett:   %.1f ms\n", bootCompleteUs / 1000.0f);
+}
+
+void getBootStats(JsonObject obj) {
+  obj["busReadyMs"] = bootBusReadyUs / 1000.0f;
+  obj["completeMs"] = bootCompleteUs / 1000.0f;
+
+  JsonArray stages = obj.createNestedArray("stages");
+  for (int i = 0; i < bootStageCount; i++) {
+    JsonObject s = stages.createNestedObject();
+    s["name"] = bootStages[i].name;
+    s["startMs"] = bootStages[i].startUs / 1000.0f;
+    s["durationMs"] = bootStages[i].durationUs / 1000.0f;
+  }
+}
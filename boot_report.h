@@ -0,0 +1,31 @@
+/**
+ * boot_report.h - Zeitmessung der Boot-Stufen
+ *
+ * setup() ist in Stufen gegliedert (Bus zuerst, dann Display, zuletzt
+ * Konfiguration und Menü verzögert im Timer-Rad). Jede Stufe wird mit
+ * bootStage() begonnen; die vorherige endet dabei automatisch.
+ *
+ * Der Boot-Bericht (Dauer pro Stufe, Zeitpunkt "Bus bereit") wird nach
+ * bootComplete() auf Serial ausgegeben und steht unter "boot" in /api/status.
+ */
+#ifndef BOOT_REPORT_H
+#define BOOT_REPORT_H
+
+#include "config.h"
+
+// Beendet die laufende Stufe und beginnt eine neue (name: String-Literal)
+void bootStage(const char* name);
+
+// RS485-UART geöffnet - eingehende Bytes werden gepuffert, ausgeführt ab dem ersten loop()
+void bootMarkBusReady();
+
+// Beendet die letzte Stufe und gibt den Boot-Bericht aus
+void bootComplete();
+
+// Gibt den Boot-Bericht auf Serial aus
+void printBootReport();
+
+// Boot-Stufen als JSON (für /api/status)
+void getBootStats(JsonObject obj);
+
+#endif // BOOT_REPORT_H
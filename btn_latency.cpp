@@ -0,0 +1,213 @@
+#include "btn_latency.h"
+
+// Stufen (Abschnitte zwischen zwei Zeitstempeln)
+enum BtnLatencyStage {
+  STAGE_DEBOUNCE = 0,   // Touch → Entprellung abgeschlossen
+  STAGE_CONFIRM,        // Entprellung → Sendepuffer (inkl. BUTTON_CONFIRM_DELAY)
+  STAGE_QUEUE,          // Sendepuffer → Senden beginnt (Wartezeit + Carrier Sense)
+  STAGE_WIRE,           // Senden beginnt → UART geleert
+  STAGE_TOTAL,          // Touch (bzw. Sendepuffer) → UART geleert
+  STAGE_COUNT
+};
+
+const char* btnLatencyStageNames[STAGE_COUNT] = {
+  "debounce", "confirm", "queue", "wire", "total"
+};
+
+// Stufe nicht zutreffend (Telegramm ohne Touch, z.B. STATUS.0)
+#define STAGE_NOT_APPLICABLE 0xFFFFFFFFUL
+
+// Laufende Messung eines eingereihten Telegramms
+struct BtnLatencyInFlight {
+  bool used;
+  bool fromTouch;
+  uint32_t touchUs;
+  uint32_t debounceUs;
+  uint32_t enqueueUs;
+  uint32_t txStartUs;
+  uint32_t txEndUs;
+};
+
+BtnLatencyInFlight btnLatencyInFlight[BTN_LATENCY_IN_FLIGHT];
+
+// Ringpuffer der abgeschlossenen Messungen (Dauer pro Stufe in µs)
+uint32_t btnLatencySamples[BTN_LATENCY_SAMPLES][STAGE_COUNT];
+int btnLatencySampleHead = 0;
+int btnLatencySampleCount = 0;
+unsigned long btnLatencyTotalCount = 0;
+
+// Zeitstempel der letzten Berührung (noch keinem Telegramm zugeordnet)
+uint32_t pendingTouchUs = 0;
+uint32_t pendingDebounceUs = 0;
+bool pendingTouchValid = false;
+
+void btnLatencyMarkTouch() {
+  pendingTouchUs = micros();
+  pendingTouchValid = false;
+}
+
+void btnLatencyMarkDebounced() {
+  pendingDebounceUs = micros();
+  pendingTouchValid = true;
+}
+
+int btnLatencyBegin(bool fromTouch) {
+  for (int i = 0; i < BTN_LATENCY_IN_FLIGHT; i++) {
+    BtnLatencyInFlight& m = btnLatencyInFlight[i];
+    if (m.used) {
+      continue;
+    }
+
+    uint32_t now = micros();
+    m.used = true;
+    m.enqueueUs = now;
+    m.txStartUs = now;
+    m.txEndUs = now;
+
+    // Touch-Zeitstempel nur übernehmen, wenn sie zu diesem Druck gehören
+    m.fromTouch = fromTouch && pendingTouchValid &&
+                  (now - pendingDebounceUs) < (uint32_t)BTN_LATENCY_MAX_TOUCH_AGE_MS * 1000UL;
+    if (m.fromTouch) {
+      m.touchUs = pendingTouchUs;
+      m.debounceUs = pendingDebounceUs;
+      pendingTouchValid = false;
+    }
+    return i;
+  }
+  return -1;
+}
+
+void btnLatencyMarkTxStart(int slot) {
+  if (slot >= 0 && slot < BTN_LATENCY_IN_FLIGHT) {
+    btnLatencyInFlight[slot].txStartUs = micros();
+  }
+}
+
+void btnLatencyMarkTxEnd(int slot) {
+  if (slot >= 0 && slot < BTN_LATENCY_IN_FLIGHT) {
+    btnLatencyInFlight[slot].txEndUs = micros();
+  }
+}
+
+void btnLatencyComplete(int slot) {
+  if (slot < 0 || slot >= BTN_LATENCY_IN_FLIGHT || !btnLatencyInFlight[slot].used) {
+    return;
+  }
+
+  BtnLatencyInFlight& m = btnLatencyInFlight[slot];
+  uint32_t* sample = btnLatencySamples[btnLatencySampleHead];
+
+  if (m.fromTouch) {
+    sample[STAGE_DEBOUNCE] = m.debounceUs - m.touchUs;
+    sample[STAGE_CONFIRM] = m.enqueueUs - m.debounceUs;
+    sample[STAGE_TOTAL] = m.txEndUs - m.touchUs;
+  } else {
+    sample[STAGE_DEBOUNCE] = STAGE_NOT_APPLICABLE;
+    sample[STAGE_CONFIRM] = STAGE_NOT_APPLICABLE;
+    sample[STAGE_TOTAL] = m.txEndUs - m.enqueueUs;
+  }
+  sample[STAGE_QUEUE] = m.txStartUs - m.enqueueUs;
+  sample[STAGE_WIRE] = m.txEndUs - m.txStartUs;
+
+  btnLatencySampleHead = (btnLatencySampleHead + 1) % BTN_LATENCY_SAMPLES;
+  if (btnLatencySampleCount < BTN_LATENCY_SAMPLES) {
+    btnLatencySampleCount++;
+  }
+  btnLatencyTotalCount++;
+  m.used = false;
+
+  #if DB_TX_INFO == 1
+    Serial.print("DEBUG: BTN-Latenz ");
+    Serial.print(m.fromTouch ? "Touch→Bus " : "Puffer→Bus ");
+    Serial.print(sample[STAGE_TOTAL] / 1000.0f, 1);
+    Serial.println(" ms");
+  #endif
+}
+
+void btnLatencyAbort(int slot) {
+  if (slot >= 0 && slot < BTN_LATENCY_IN_FLIGHT) {
+    btnLatencyInFlight[slot].used = false;
+  }
+}
+
+void resetBtnLatency() {
+  btnLatencySampleHead = 0;
+  btnLatencySampleCount = 0;
+  btnLatencyTotalCount = 0;
+}
+
+unsigned long getBtnLatencyCount() {
+  return btnLatencyTotalCount;
+}
+
+/**
+ * Sortiert die gültigen Werte einer Stufe in values[]
+ * @return Anzahl gültiger Werte
+ */
+int collectSortedStage(int stage, uint32_t* values) {
+  int n = 0;
+  for (int i = 0; i < btnLatencySampleCount; i++) {
+    uint32_t v = btnLatencySamples[i][stage];
+    if (v == STAGE_NOT_APPLICABLE) {
+      continue;
+    }
+
+    // Insertion Sort - maximal BTN_LATENCY_SAMPLES Werte
+    int j = n++;
+    while (j > 0 && values[j - 1] > v) {
+      values[j] = values[j - 1];
+      j--;
+    }
+    values[j] = v;
+  }
+  return n;
+}
+
+uint32_t percentileOf(const uint32_t* sorted, int n, int percent) {
+  if (n == 0) {
+    return 0;
+  }
+  return sorted[((n - 1) * percent + 50) / 100];
+}
+
+void getBtnLatencyStats(JsonObject obj) {
+  obj["count"] = btnLatencyTotalCount;
+  obj["window"] = btnLatencySampleCount;
+
+  uint32_t values[BTN_LATENCY_SAMPLES];
+  for (int stage = 0; stage < STAGE_COUNT; stage++) {
+    int n = collectSortedStage(stage, values);
+    JsonObject s = obj.createNestedObject(btnLatencyStageNames[stage]);
+    s["n"] = n;
+    s["p50Us"] = percentileOf(values, n, 50);
+    s["p90Us"] = percentileOf(values, n, 90);
+    s["p99Us"] = percentileOf(values, n, 99);
+    s["maxUs"] = n > 0 ? values[n - 1] : 0;
+  }
+}
+
+String getBtnLatencySummary() {
+  uint32_t values[BTN_LATENCY_SAMPLES];
+
+  // Nur Messungen mit Touch-Zeitstempel ergeben die Ende-zu-Ende-Latenz
+  int n = 0;
+  for (int i = 0; i < btnLatencySampleCount; i++) {
+    if (btnLatencySamples[i][STAGE_DEBOUNCE] == STAGE_NOT_APPLICABLE) {
+      continue;
+    }
+    uint32_t v = btnLatencySamples[i][STAGE_TOTAL];
+    int j = n++;
+    while (j > 0 && values[j - 1] > v) {
+      values[j] = values[j - 1];
+      j--;
+    }
+    values[j] = v;
+  }
+
+  if (n == 0) {
+    return "Touch->Bus: keine Messung";
+  }
+  return "Touch->Bus p50 " + String(percentileOf(values, n, 50) / 1000) + "ms" +
+         " p90 " + String(percentileOf(values, n, 90) / 1000) + "ms" +
+         " (n=" + String(n) + ")";
+}
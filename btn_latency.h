@@ -0,0 +1,56 @@
+/**
+ * btn_latency.h - Messung der Latenz Touch → Bus für Taster-Telegramme
+ *
+ * Zeitstempel pro BTN-Telegramm:
+ *   1. Touch erkannt (IRQ-Flag des Touch-Controllers in pollTouch)
+ *   2. Entprellung abgeschlossen
+ *   3. Telegramm in den Sendepuffer eingereiht
+ *   4. Senden beginnt (nach Carrier Sense / Rahmenabstand)
+ *   5. Senden beendet (UART geleert)
+ *
+ * Für STATUS.1 (Druck) werden alle Stufen erfasst, für übrige BTN-Telegramme
+ * (z.B. STATUS.0 beim Loslassen) nur Sendepuffer und Bus.
+ * Perzentile über die letzten BTN_LATENCY_SAMPLES Messungen.
+ */
+#ifndef BTN_LATENCY_H
+#define BTN_LATENCY_H
+
+#include "config.h"
+
+// Touch-Controller meldet eine Berührung (vor der Entprellung)
+void btnLatencyMarkTouch();
+
+// Entprellung abgeschlossen, erste gültige Koordinate
+void btnLatencyMarkDebounced();
+
+/**
+ * Beginnt die Messung eines eingereihten BTN-Telegramms
+ *
+ * @param fromTouch     true für STATUS.1 - übernimmt die Touch-Zeitstempel
+ * @return Messplatz für das Sendepuffer-Element oder -1 wenn keiner frei ist
+ */
+int btnLatencyBegin(bool fromTouch);
+
+// Senden beginnt / ist beendet (bei Wiederholungen zählt der letzte Versuch)
+void btnLatencyMarkTxStart(int slot);
+void btnLatencyMarkTxEnd(int slot);
+
+// Telegramm erfolgreich gesendet - Messung übernehmen und Platz freigeben
+void btnLatencyComplete(int slot);
+
+// Telegramm verworfen - Platz ohne Messung freigeben
+void btnLatencyAbort(int slot);
+
+// Setzt alle Messwerte zurück
+void resetBtnLatency();
+
+// Perzentile pro Stufe als JSON (für /api/status)
+void getBtnLatencyStats(JsonObject obj);
+
+// Kurzfassung für die Anzeige im Service-Menü, z.B. "Touch->Bus p50 58ms p90 64ms (n=12)"
+String getBtnLatencySummary();
+
+// Anzahl abgeschlossener Messungen seit dem Start
+unsigned long getBtnLatencyCount();
+
+#endif // BTN_LATENCY_H
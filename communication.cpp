@@ -8,6 +8,7 @@
  * - Backoff-Algorithmus bei Kollisionen
  * - Priorisierung von Nachrichten
  * - *** NEU: Button-Touch-Priorität für LED-Steuerung ***
+ * - *** NEU: Empfang und Ausführung getrennt (Arbeitspuffer mit Zeitbudget) ***
  */
 #include "communication.h"
 #include "backlight.h"
@@ -15,6 +16,15 @@
 #include "led.h"
 #include "service_manager.h"  // NEU: Include für ServiceManager
 #include "header_display.h"  // Für Zeit/Datum Funktionen
+#include "timer_wheel.h"
+#include "profiler.h"
+#include "btn_latency.h"
+#include "trace.h"
+#include "stall_monitor.h"
+#include "idle_manager.h"
+#include "cpu_freq.h"
+#include "rtc_snapshot.h"
+#include "screensaver.h"
 
 // Separate UART2-Instanz für RS485
 HardwareSerial RS485Serial(2);
@@ -31,7 +41,6 @@ unsigned long telegramStartTime = 0;
 // CSMA/CD Variablen
 bool busIdle = true;
 unsigned long lastBusActivity = 0;
-const unsigned long BUS_IDLE_TIME = 10;      // 10ms ohne Aktivität = Bus frei
 const unsigned long COLLISION_DETECT_TIME = 5; // 5ms nach Sendebeginn auf Kollision prüfen
 
 // Sendepuffer-Struktur
@@ -41,6 +50,8 @@ struct SendQueueItem {
   int retryCount;
   int priority;        // 0=höchste Priorität, 9=niedrigste
   bool urgent;         // Sofort senden (für Antworten)
+  unsigned long idleTimeMs;  // Prioritätsabhängiger Rahmenabstand (AIFS)
+  int latencySlot;     // Messplatz der Touch→Bus-Latenz (nur BTN), -1 = keiner
 };
 
 // Sendepuffer (Ring-Buffer) - verwendet #define aus config.h
@@ -49,11 +60,193 @@ int sendQueueHead = 0;
 int sendQueueTail = 0;
 int sendQueueCount = 0;
 
+// *** NEU: Telegramme aus anderen Tasks (Web-Server) ***
+// Sendepuffer und Token-Buckets gehören dem Loop-Task - andere Tasks legen das fertige
+// Telegramm hier ab, updateCommunication() reiht es im Loop ein
+struct TaskTelegram {
+  char telegram[MAX_TELEGRAM_LENGTH];
+  int priority;
+  bool urgent;
+};
+
+TaskTelegram taskTelegrams[TASK_TELEGRAM_QUEUE_SIZE];
+int taskTelegramTail = 0;
+int taskTelegramCount = 0;
+unsigned long taskTelegramsDropped = 0;
+portMUX_TYPE taskTelegramMux = portMUX_INITIALIZER_UNLOCKED;
+
+// *** NEU: Sendepuffer-Aufgabe läuft nur, solange Telegramme warten ***
+// (sonst weckt der 2-ms-Takt die loop() ständig aus dem Leerlauf)
+int sendQueueTimerId = -1;
+
 // Statistiken
 unsigned long totalSent = 0;
 unsigned long totalCollisions = 0;
 unsigned long totalRetries = 0;
 
+// *** NEU: Wartezeit-Verteilung (Sendepuffer → Bus) pro Priorität ***
+struct PriorityLatencyStats {
+  unsigned long count;
+  unsigned long sumMs;
+  unsigned long maxMs;
+  unsigned long histogram[LATENCY_HIST_BUCKETS];
+};
+
+PriorityLatencyStats priorityLatency[PRIORITY_BACKGROUND + 1];
+
+// Obere Grenzen der Histogramm-Klassen (ms), letzte Klasse = alles darüber
+const unsigned long LATENCY_HIST_LIMITS[LATENCY_HIST_BUCKETS - 1] = {5, 10, 20, 50, 100, 200, 500};
+
+// *** NEU: Wartezeit eines erfolgreich gesendeten Telegramms erfassen ***
+void recordPriorityLatency(int priority, unsigned long latencyMs) {
+  priority = constrain(priority, 0, PRIORITY_BACKGROUND);
+  PriorityLatencyStats& stats = priorityLatency[priority];
+  
+  stats.count++;
+  stats.sumMs += latencyMs;
+  if (latencyMs > stats.maxMs) {
+    stats.maxMs = latencyMs;
+  }
+  
+  int bucket = LATENCY_HIST_BUCKETS - 1;
+  for (int i = 0; i < LATENCY_HIST_BUCKETS - 1; i++) {
+    if (latencyMs < LATENCY_HIST_LIMITS[i]) {
+      bucket = i;
+      break;
+    }
+  }
+  stats.histogram[bucket]++;
+}
+
+// *** NEU: Token-Bucket Ratenbegrenzung pro Telegramm-Klasse ***
+enum RateClass {
+  RATE_CLASS_BTN = 0,     // Taster (PRIORITY_HIGH)
+  RATE_CLASS_NORMAL,      // Standard-Telegramme
+  RATE_CLASS_STATUS,      // Status/Hintergrund (z.B. Backlight-Status)
+  RATE_CLASS_COUNT
+};
+
+struct TokenBucket {
+  const char* name;
+  uint16_t burst;              // Maximale Token-Anzahl (Burst)
+  unsigned long refillMs;      // Zeit für ein neues Token
+  uint16_t tokens;             // Aktuell verfügbare Token
+  unsigned long lastRefill;    // Zeitpunkt der letzten Auffüllung
+  unsigned long limited;       // Wegen Ratenbegrenzung verworfene Telegramme
+};
+
+TokenBucket rateBuckets[RATE_CLASS_COUNT] = {
+  {"btn",    RATE_BTN_BURST,    RATE_BTN_REFILL_MS,    RATE_BTN_BURST,    0, 0},
+  {"normal", RATE_NORMAL_BURST, RATE_NORMAL_REFILL_MS, RATE_NORMAL_BURST, 0, 0},
+  {"status", RATE_STATUS_BURST, RATE_STATUS_REFILL_MS, RATE_STATUS_BURST, 0, 0}
+};
+
+unsigned long totalRateLimited = 0;
+
+// Einreihen ohne Ratenbegrenzung / aus anderen Tasks ablegen (Definitionen weiter unten)
+bool enqueueSendQueueItem(const String& telegram, int priority, bool urgent, int latencySlot);
+bool postTaskTelegram(const String& telegram, int priority, bool urgent);
+
+// Klasse aus der Priorität ableiten
+int getRateClass(int priority) {
+  if (priority <= PRIORITY_HIGH) return RATE_CLASS_BTN;
+  if (priority <= PRIORITY_NORMAL) return RATE_CLASS_NORMAL;
+  return RATE_CLASS_STATUS;
+}
+
+// Token entnehmen - false wenn die Klasse ihr Budget ausgeschöpft hat
+bool consumeRateToken(int priority) {
+  TokenBucket& bucket = rateBuckets[getRateClass(priority)];
+  unsigned long now = millis();
+
+  // Auffüllen: nur ganze Token gutschreiben, Rest der Zeit bleibt erhalten
+  unsigned long newTokens = (now - bucket.lastRefill) / bucket.refillMs;
+  if (newTokens > 0) {
+    bucket.tokens = min((unsigned long)bucket.burst, bucket.tokens + newTokens);
+    bucket.lastRefill += newTokens * bucket.refillMs;
+  }
+  if (bucket.tokens >= bucket.burst) {
+    bucket.lastRefill = now;
+  }
+
+  if (bucket.tokens == 0) {
+    bucket.limited++;
+    totalRateLimited++;
+    return false;
+  }
+
+  bucket.tokens--;
+  return true;
+}
+
+// *** NEU: Statuswert-Cache (zuletzt gesendeter Wert pro Funktion/Instanz) ***
+struct StatusCacheEntry {
+  char function[8];
+  char instanceID[8];
+  int value;
+  unsigned long lastSentTime;
+  bool used;
+};
+
+StatusCacheEntry statusCache[STATUS_CACHE_SIZE];
+unsigned long statusReportsSent = 0;
+unsigned long statusReportsSuppressed = 0;
+
+// *** NEU: Arbeitspuffer für empfangene Telegramme ***
+// Empfang/Zerlegung erfolgt sofort, die Ausführung (Display, Backlight, ...)
+// pro loop()-Durchlauf nur bis RX_WORK_BUDGET_US
+struct RxWorkItem {
+  String function;
+  String instanceId;
+  String action;
+  String params;
+  unsigned long receivedTime;
+};
+
+RxWorkItem rxWorkQueue[RX_WORK_QUEUE_SIZE];
+int rxWorkHead = 0;
+int rxWorkTail = 0;
+int rxWorkCount = 0;
+
+// Statistik Arbeitspuffer
+unsigned long rxWorkQueued = 0;       // Eingereihte Telegramme
+unsigned long rxWorkExecuted = 0;     // Ausgeführte Telegramme
+unsigned long rxWorkCoalesced = 0;    // Durch neueren LED-Zustand ersetzt
+unsigned long rxWorkOverflow = 0;     // Puffer voll - ältestes sofort ausgeführt
+int rxWorkMaxDepth = 0;               // Höchster Füllstand
+unsigned long rxWorkMaxExecUs = 0;    // Längste Einzelausführung
+unsigned long rxWorkMaxWaitMs = 0;    // Längste Wartezeit im Puffer
+
+// Ältesten Eintrag ausführen (Definition weiter unten)
+void executeNextRxWork();
+
+// Eintrag suchen oder anlegen (bei vollem Cache wird der älteste ersetzt)
+StatusCacheEntry& getStatusCacheEntry(const String& function, const String& instanceID, bool& isNew) {
+  int freeIndex = -1;
+  int oldestIndex = 0;
+  isNew = false;
+  
+  for (int i = 0; i < STATUS_CACHE_SIZE; i++) {
+    if (!statusCache[i].used) {
+      if (freeIndex < 0) freeIndex = i;
+      continue;
+    }
+    if (function == statusCache[i].function && instanceID == statusCache[i].instanceID) {
+      return statusCache[i];
+    }
+    if ((long)(statusCache[i].lastSentTime - statusCache[oldestIndex].lastSentTime) < 0) {
+      oldestIndex = i;
+    }
+  }
+  
+  StatusCacheEntry& entry = statusCache[freeIndex >= 0 ? freeIndex : oldestIndex];
+  strlcpy(entry.function, function.c_str(), sizeof(entry.function));
+  strlcpy(entry.instanceID, instanceID.c_str(), sizeof(entry.instanceID));
+  entry.used = true;
+  isNew = true;
+  return entry;
+}
+
 // *** NEU: Button-Touch-Priorität Variablen ***
 // Diese müssen extern deklariert werden, damit sie in main INO zugänglich sind
 extern struct ButtonTiming {
@@ -72,6 +265,12 @@ struct PendingLedState {
 
 PendingLedState pendingLedStates[NUM_BUTTONS];
 
+// *** NEU: Benchmark-Modus (Szenen-Burst-Benchmark in ui_compositor.cpp) ***
+// Eingespielte Telegramme ohne Empfangs-LED und ohne Wecken des Bildschirmschoners,
+// isRxPending() meldet den simulierten Empfang statt des UART-Zustands
+bool rxBenchmarkMode = false;
+bool rxBenchmarkPending = false;
+
 // *** NEU: Hilfsfunktion - Prüft ob Button gerade lokal gedrückt wird ***
 bool isButtonLocallyPressed(int buttonIndex) {
   return (buttonTiming.touchActive && 
@@ -93,6 +292,17 @@ void setPendingLedState(int buttonIndex, uint16_t color, bool active) {
   }
 }
 
+// *** NEU: Wartenden LED-Status abfragen (für den RTC-Schnappschuss) ***
+bool getPendingLedState(int buttonIndex, uint16_t* color, bool* active) {
+  if (buttonIndex < 0 || buttonIndex >= NUM_BUTTONS ||
+      !pendingLedStates[buttonIndex].hasPending) {
+    return false;
+  }
+  *color = pendingLedStates[buttonIndex].pendingColor;
+  *active = pendingLedStates[buttonIndex].pendingActive;
+  return true;
+}
+
 // *** NEU: Hilfsfunktion - Wendet gespeicherten LED-Status an ***
 void applyPendingLedState(int buttonIndex) {
   if (buttonIndex >= 0 && buttonIndex < NUM_BUTTONS && 
@@ -125,7 +335,7 @@ void applyAllPendingLedStates() {
 /**
  * Prüft, ob der Bus frei ist (Carrier Sense)
  */
-bool isBusIdle() {
+bool isBusIdle(unsigned long requiredIdleMs) {
   // Prüfe, ob Daten im Empfangspuffer sind
   if (RS485Serial.available() > 0) {
     lastBusActivity = millis();
@@ -134,7 +344,7 @@ bool isBusIdle() {
   }
   
   // Prüfe, ob genug Zeit vergangen ist seit der letzten Aktivität
-  if (millis() - lastBusActivity >= BUS_IDLE_TIME) {
+  if (millis() - lastBusActivity >= requiredIdleMs) {
     busIdle = true;
     return true;
   }
@@ -142,12 +352,110 @@ bool isBusIdle() {
   return false;
 }
 
+/**
+ * Prioritätsabhängiger Rahmenabstand (AIFS-ähnlich)
+ */
+unsigned long calculateInterFrameSpacing(int priority) {
+  priority = constrain(priority, 0, PRIORITY_BACKGROUND);
+  
+  // Feste Ruhezeit pro Prioritätsstufe + Zufallsslot innerhalb der Stufe
+  unsigned long ifs = BUS_IDLE_TIME_MS + (unsigned long)priority * PRIORITY_IFS_STEP_MS;
+  ifs += random(0, PRIORITY_IFS_SLOTS) * PRIORITY_IFS_SLOT_MS;
+  
+  return ifs;
+}
+
 /**
  * Fügt ein Telegramm zum Sendepuffer hinzu
+ * Neue Telegramme durchlaufen die Ratenbegrenzung ihrer Klasse,
+ * kritische und dringende Telegramme (Antworten) sind ausgenommen.
  */
-bool addToSendQueue(const String& telegram, int priority, bool urgent) {
+bool addToSendQueue(const String& telegram, int priority, bool urgent, int latencySlot) {
+  // Aus einem anderen Task: nur ablegen, eingereiht wird im Loop-Task
+  // (Latenz-Messplätze gehören dem Loop-Task - abgelegte Telegramme werden nicht gemessen)
+  if (!idleIsLoopTask()) {
+    return postTaskTelegram(telegram, priority, urgent);
+  }
+
+  // Voller Puffer verwirft das Telegramm - dann auch kein Token verbrauchen
+  if (sendQueueCount >= SEND_QUEUE_SIZE) {
+    TRACE_INSTANT(TRACE_TX_DROPPED, priority);
+    #if DB_TX_INFO == 1
+      Serial.println("DEBUG: Sendepuffer voll! Telegramm verworfen.");
+    #endif
+    return false;
+  }
+
+  #if RATE_LIMIT_ENABLED == 1
+    if (!urgent && priority > PRIORITY_CRITICAL && !consumeRateToken(priority)) {
+      TRACE_INSTANT(TRACE_TX_DROPPED, priority);
+      #if DB_TX_INFO == 1
+        Serial.print("DEBUG: Ratenbegrenzung aktiv, Telegramm verworfen (Priorität ");
+        Serial.print(priority);
+        Serial.println(")");
+      #endif
+      return false;
+    }
+  #endif
+
+  return enqueueSendQueueItem(telegram, priority, urgent, latencySlot);
+}
+
+/**
+ * Legt ein Telegramm aus einem anderen Task für den Loop-Task ab
+ * (die Strings werden außerhalb des kritischen Abschnitts gebaut, hier nur kopiert)
+ */
+bool postTaskTelegram(const String& telegram, int priority, bool urgent) {
+  bool posted = false;
+  portENTER_CRITICAL(&taskTelegramMux);
+  if (taskTelegramCount < TASK_TELEGRAM_QUEUE_SIZE) {
+    TaskTelegram& slot = taskTelegrams[(taskTelegramTail + taskTelegramCount) % TASK_TELEGRAM_QUEUE_SIZE];
+    strlcpy(slot.telegram, telegram.c_str(), sizeof(slot.telegram));
+    slot.priority = priority;
+    slot.urgent = urgent;
+    taskTelegramCount++;
+    posted = true;
+  } else {
+    taskTelegramsDropped++;
+  }
+  portEXIT_CRITICAL(&taskTelegramMux);
+
+  if (posted) {
+    idleWakeFromTask();
+  }
+  return posted;
+}
+
+/**
+ * Reiht die aus anderen Tasks abgelegten Telegramme ein (nur im Loop-Task)
+ */
+void processTaskTelegrams() {
+  while (true) {
+    TaskTelegram item;
+    portENTER_CRITICAL(&taskTelegramMux);
+    bool available = taskTelegramCount > 0;
+    if (available) {
+      item = taskTelegrams[taskTelegramTail];
+      taskTelegramTail = (taskTelegramTail + 1) % TASK_TELEGRAM_QUEUE_SIZE;
+      taskTelegramCount--;
+    }
+    portEXIT_CRITICAL(&taskTelegramMux);
+
+    if (!available) {
+      return;
+    }
+    addToSendQueue(String(item.telegram), item.priority, item.urgent);
+  }
+}
+
+/**
+ * Reiht ein Telegramm ohne Ratenbegrenzung in den Sendepuffer ein
+ * (für Wiederholungen, deren Token bereits beim ersten Einreihen verbraucht wurde)
+ */
+bool enqueueSendQueueItem(const String& telegram, int priority, bool urgent, int latencySlot) {
   // Prüfe, ob der Puffer voll ist
   if (sendQueueCount >= SEND_QUEUE_SIZE) {
+    TRACE_INSTANT(TRACE_TX_DROPPED, priority);
     #if DB_TX_INFO == 1
       Serial.println("DEBUG: Sendepuffer voll! Telegramm verworfen.");
     #endif
@@ -160,10 +468,15 @@ bool addToSendQueue(const String& telegram, int priority, bool urgent) {
   sendQueue[sendQueueHead].retryCount = 0;
   sendQueue[sendQueueHead].priority = priority;
   sendQueue[sendQueueHead].urgent = urgent;
+  sendQueue[sendQueueHead].idleTimeMs = urgent ? BUS_IDLE_TIME_MS : calculateInterFrameSpacing(priority);
+  sendQueue[sendQueueHead].latencySlot = latencySlot;
   
   sendQueueHead = (sendQueueHead + 1) % SEND_QUEUE_SIZE;
   sendQueueCount++;
   
+  // Loop-Task wecken, falls das Telegramm aus einem anderen Task kommt (Web-Server)
+  idleWakeFromTask();
+  
   #if DB_TX_INFO == 1
     Serial.print("DEBUG: Telegramm in Sendepuffer, Priorität ");
     Serial.print(priority);
@@ -175,11 +488,12 @@ bool addToSendQueue(const String& telegram, int priority, bool urgent) {
 }
 
 /**
- * Holt das nächste Telegramm aus dem Sendepuffer (höchste Priorität zuerst)
+ * Ermittelt den Index des nächsten zu sendenden Telegramms (ohne Entnahme)
+ * @return Index im Sendepuffer oder -1 wenn leer
  */
-bool getNextFromSendQueue(SendQueueItem& item) {
+int findNextSendQueueIndex() {
   if (sendQueueCount == 0) {
-    return false;
+    return -1;
   }
   
   // Finde das Element mit der höchsten Priorität (niedrigste Zahl)
@@ -202,6 +516,18 @@ bool getNextFromSendQueue(SendQueueItem& item) {
     }
   }
   
+  return bestIndex;
+}
+
+/**
+ * Holt das nächste Telegramm aus dem Sendepuffer (höchste Priorität zuerst)
+ */
+bool getNextFromSendQueue(SendQueueItem& item) {
+  int bestIndex = findNextSendQueueIndex();
+  if (bestIndex < 0) {
+    return false;
+  }
+  
   // Kopiere das Element
   item = sendQueue[bestIndex];
   
@@ -269,16 +595,12 @@ bool detectCollision(const String& sentTelegram) {
  * Initialisierung mit CSMA/CD-Unterstützung
  */
 void setupCommunication() {
-  // UART0 für USB-Debug
-  Serial.begin(115200);
-  delay(100);
+  // UART0 für USB-Debug startet bereits in setup()
   
-  // UART2 für RS485
+  // UART2 für RS485 (ohne Wartezeiten - Bus soll nach dem Boot sofort empfangen)
   RS485Serial.begin(57600, SERIAL_8E1, UART_RX_PIN, UART_TX_PIN);
   RS485Serial.setTimeout(10);
   
-  delay(100);
-  
   // Zufallsgenerator initialisieren
   randomSeed(analogRead(A0) + millis());
   
@@ -298,7 +620,7 @@ void setupCommunication() {
     Serial.print("RS485 TX Pin: ");
     Serial.println(UART_TX_PIN);
     Serial.print("Bus Idle Time: ");
-    Serial.print(BUS_IDLE_TIME);
+    Serial.print(BUS_IDLE_TIME_MS);
     Serial.println(" ms");
     Serial.print("Sendepuffer-Größe: ");
     Serial.println(SEND_QUEUE_SIZE);
@@ -321,17 +643,29 @@ void setupCommunication() {
     RS485Serial.read();
   }
   
-  delay(100);
+  // *** NEU: Periodische Aufgaben über das Timer-Rad ***
+  // Sendepuffer-Aufgabe wird bei Bedarf in updateCommunication() gestartet
+  sendQueueTimerId = timerWheelRegister("sendQueue", [](void*) {
+    PROFILE_SCOPE(PROF_SEND_QUEUE);
+    processSendQueue();
+  });
+  timerWheelAddPeriodic("commStats", STATS_OUTPUT_INTERVAL, [](void*) { printCommunicationStats(); });
 }
 
+// *** NEU: Messplatz des gerade gesendeten Telegramms (Touch→Bus-Latenz) ***
+int currentTxLatencySlot = -1;
+
 /**
  * Hauptfunktion für das Senden mit CSMA/CD
  */
-bool transmitWithCSMA(const String& telegram, int maxRetries) {
+bool transmitWithCSMA(const String& telegram, int maxRetries, unsigned long idleTimeMs) {
+  TRACE_SCOPE(TRACE_TX);
+  STALL_PHASE(STALL_PHASE_TX);
+  
   for (int attempt = 0; attempt < maxRetries; attempt++) {
-    // 1. Carrier Sense - Warte, bis der Bus frei ist
+    // 1. Carrier Sense - Warte, bis der Bus für den Rahmenabstand dieser Priorität frei ist
     unsigned long waitStart = millis();
-    while (!isBusIdle()) {
+    while (!isBusIdle(idleTimeMs)) {
       delay(1);
       // Timeout nach 100ms
       if (millis() - waitStart > 100) {
@@ -353,7 +687,7 @@ bool transmitWithCSMA(const String& telegram, int maxRetries) {
       delay(backoffTime);
       
       // Erneut prüfen, ob der Bus noch frei ist
-      if (!isBusIdle()) {
+      if (!isBusIdle(idleTimeMs)) {
         continue;  // Nächster Versuch
       }
     }
@@ -366,8 +700,10 @@ bool transmitWithCSMA(const String& telegram, int maxRetries) {
       printTelegramHex(telegram);
     #endif
     
+    btnLatencyMarkTxStart(currentTxLatencySlot);
     RS485Serial.print(telegram);
     RS485Serial.flush();
+    btnLatencyMarkTxEnd(currentTxLatencySlot);
     
     // LED-Signal
     ledSendSignal();
@@ -385,6 +721,7 @@ bool transmitWithCSMA(const String& telegram, int maxRetries) {
     } else {
       // Kollision erkannt
       totalRetries++;
+      TRACE_INSTANT(TRACE_TX_COLLISION, attempt + 1);
       
       #if DB_TX_INFO == 1
         Serial.print("DEBUG: Kollision bei Versuch ");
@@ -436,33 +773,74 @@ void sendTelegram(String function, String instanceID, String action, String para
     urgent = false;
   }
   
+  // *** NEU: Touch→Bus-Latenz für Taster-Telegramme messen (nur im Loop-Task) ***
+  // Der Messplatz wird beim Einreihen im Element gesetzt, nicht nachträglich gesucht
+  int latencySlot = -1;
+  if (function == "BTN" && idleIsLoopTask()) {
+    latencySlot = btnLatencyBegin(action == "STATUS" && params == "1");
+  }
+  
   // Zum Sendepuffer hinzufügen
-  if (!addToSendQueue(telegram, priority, urgent)) {
+  if (!addToSendQueue(telegram, priority, urgent, latencySlot)) {
+    btnLatencyAbort(latencySlot);
     #if DB_TX_INFO == 1
       Serial.println("DEBUG: Konnte Telegramm nicht zum Sendepuffer hinzufügen");
     #endif
+    return;
   }
 }
 
 /**
- * Sendepuffer abarbeiten - muss regelmäßig aufgerufen werden
+ * Sendet einen Statuswert nur bei Änderung (Delta-Meldung)
  */
-void processSendQueue() {
-  static unsigned long lastProcessTime = 0;
+bool sendStatusValue(const String& function, const String& instanceID, int value,
+                     int deadband, bool force, int priority) {
+  bool isNew;
+  StatusCacheEntry& entry = getStatusCacheEntry(function, instanceID, isNew);
+  unsigned long now = millis();
   
-  // Nur alle 2ms prüfen, um CPU zu schonen
-  if (millis() - lastProcessTime < 2) {
-    return;
+  // Unterdrücken, wenn innerhalb des Totbands und Heartbeat noch nicht fällig
+  if (!force && !isNew &&
+      abs(value - entry.value) <= deadband &&
+      now - entry.lastSentTime < STATUS_REFRESH_INTERVAL) {
+    statusReportsSuppressed++;
+    return false;
   }
-  lastProcessTime = millis();
   
-  // Prüfe, ob etwas zu senden ist
-  if (sendQueueCount == 0) {
+  String telegram = String((char)START_BYTE) + serviceManager.getDeviceID() + "." + function + "." +
+                    instanceID + ".STATUS." + String(value) + String((char)END_BYTE);
+  
+  if (!addToSendQueue(telegram, priority, false)) {
+    // Cache nicht aktualisieren - beim nächsten Mal erneut versuchen
+    if (isNew) {
+      entry.used = false;
+    }
+    return false;
+  }
+  
+  entry.value = value;
+  entry.lastSentTime = now;
+  statusReportsSent++;
+  return true;
+}
+
+/**
+ * Sendepuffer abarbeiten - muss regelmäßig aufgerufen werden
+ */
+void processSendQueue() {
+  // Aufruf alle SEND_QUEUE_INTERVAL ms über das Timer-Rad (setupCommunication)
+  
+  // Prüfe, ob etwas zu senden ist - sonst Aufgabe bis zum nächsten Telegramm anhalten
+  int nextIndex = findNextSendQueueIndex();
+  if (nextIndex < 0) {
+    timerWheelStop(sendQueueTimerId);
     return;
   }
   
-  // Prüfe, ob der Bus frei ist
-  if (!isBusIdle()) {
+  // *** NEU: Prüfe, ob der Bus für den Rahmenabstand dieser Priorität frei ist ***
+  // Niedrige Prioritäten warten länger und lassen dringende Telegramme
+  // anderer Panels zuerst auf den Bus
+  if (!isBusIdle(sendQueue[nextIndex].idleTimeMs)) {
     return;
   }
   
@@ -470,7 +848,14 @@ void processSendQueue() {
   SendQueueItem item;
   if (getNextFromSendQueue(item)) {
     // Versuche zu senden
-    if (!transmitWithCSMA(item.telegram, 3)) {
+    currentTxLatencySlot = item.latencySlot;
+    bool sent = transmitWithCSMA(item.telegram, 3, item.idleTimeMs);
+    currentTxLatencySlot = -1;
+    
+    if (sent) {
+      recordPriorityLatency(item.priority, millis() - item.timestamp);
+      btnLatencyComplete(item.latencySlot);
+    } else {
       // Senden fehlgeschlagen - zurück in den Puffer wenn noch Versuche übrig
       item.retryCount++;
       
@@ -478,12 +863,22 @@ void processSendQueue() {
         // Mit niedrigerer Priorität zurück in den Puffer
         item.priority = min(item.priority + 1, 9);
         
-        if (!addToSendQueue(item.telegram, item.priority, false)) {
+        // Wiederholungen umgehen die Ratenbegrenzung (Token schon verbraucht)
+        if (enqueueSendQueueItem(item.telegram, item.priority, false, item.latencySlot)) {
+          // Ursprünglichen Zeitstempel und Versuchszähler beibehalten
+          // (nur der Loop-Task reiht ein - das zuletzt eingereihte Element ist dieses)
+          int lastIndex = (sendQueueHead - 1 + SEND_QUEUE_SIZE) % SEND_QUEUE_SIZE;
+          sendQueue[lastIndex].timestamp = item.timestamp;
+          sendQueue[lastIndex].retryCount = item.retryCount;
+        } else {
+          btnLatencyAbort(item.latencySlot);
           #if DB_TX_INFO == 1
             Serial.println("DEBUG: Konnte fehlgeschlagenes Telegramm nicht erneut einreihen");
           #endif
         }
       } else {
+        btnLatencyAbort(item.latencySlot);
+        TRACE_INSTANT(TRACE_TX_DROPPED, item.priority);
         #if DB_TX_INFO == 1
           Serial.println("DEBUG: Telegramm nach 5 Versuchen verworfen");
         #endif
@@ -500,6 +895,7 @@ void processIncomingTelegrams() {
   if (receivingTelegram && (millis() - telegramStartTime > TELEGRAM_TIMEOUT_MS)) {
     receivingTelegram = false;
     bufferPos = 0;
+    cpuFreqNoteRxAborted();
     #if DB_RX_INFO == 1
       Serial.println("DEBUG: Telegramm-Timeout, Empfang abgebrochen");
     #endif
@@ -578,6 +974,7 @@ void processIncomingTelegrams() {
           
           // Telegramm verarbeiten
           processTelegram(telegramStr);
+          cpuFreqNoteRxTelegram();
           
           // Zurücksetzen für das nächste Telegramm
           receivingTelegram = false;
@@ -588,6 +985,7 @@ void processIncomingTelegrams() {
         // Puffer-Überlauf - Empfang abbrechen
         receivingTelegram = false;
         bufferPos = 0;
+        cpuFreqNoteRxAborted();
         #if DB_RX_INFO == 1
           Serial.println("DEBUG: Telegramm zu lang, verworfen");
         #endif
@@ -615,32 +1013,285 @@ void printCommunicationStats() {
     Serial.println(SEND_QUEUE_SIZE);
     Serial.print("Bus-Status: ");
     Serial.println(busIdle ? "Frei" : "Belegt");
+    Serial.print("Statusmeldungen gesendet/unterdrückt: ");
+    Serial.print(statusReportsSent);
+    Serial.print("/");
+    Serial.println(statusReportsSuppressed);
+    Serial.printf("Empfangs-Arbeitspuffer: %d/%d, max %d, ausgeführt %lu, zusammengefasst %lu, Überlauf %lu, max %luus\n",
+                  rxWorkCount, RX_WORK_QUEUE_SIZE, rxWorkMaxDepth, rxWorkExecuted,
+                  rxWorkCoalesced, rxWorkOverflow, rxWorkMaxExecUs);
+    Serial.print("Ratenbegrenzt verworfen: ");
+    Serial.print(totalRateLimited);
+    for (int c = 0; c < RATE_CLASS_COUNT; c++) {
+      Serial.printf(" %s=%lu (Token %u/%u)", rateBuckets[c].name, rateBuckets[c].limited,
+                    rateBuckets[c].tokens, rateBuckets[c].burst);
+    }
+    Serial.println();
+    
+    // Wartezeit-Verteilung pro Priorität (nur benutzte Stufen)
+    Serial.println("Wartezeit Puffer→Bus (ms) <5/<10/<20/<50/<100/<200/<500/>500:");
+    for (int p = 0; p <= PRIORITY_BACKGROUND; p++) {
+      if (priorityLatency[p].count == 0) continue;
+      Serial.printf("  Prio %d: n=%lu avg=%lu max=%lu |", p, priorityLatency[p].count,
+                    priorityLatency[p].sumMs / priorityLatency[p].count, priorityLatency[p].maxMs);
+      for (int b = 0; b < LATENCY_HIST_BUCKETS; b++) {
+        Serial.printf(" %lu", priorityLatency[p].histogram[b]);
+      }
+      Serial.println();
+    }
     Serial.println("================================");
   #endif
 }
 
+/**
+ * Statistiken zurücksetzen
+ */
+void resetCommunicationStats() {
+  totalSent = 0;
+  totalCollisions = 0;
+  totalRetries = 0;
+  memset(priorityLatency, 0, sizeof(priorityLatency));
+  totalRateLimited = 0;
+  for (int c = 0; c < RATE_CLASS_COUNT; c++) {
+    rateBuckets[c].limited = 0;
+  }
+  statusReportsSent = 0;
+  statusReportsSuppressed = 0;
+  rxWorkQueued = 0;
+  rxWorkExecuted = 0;
+  rxWorkCoalesced = 0;
+  rxWorkOverflow = 0;
+  rxWorkMaxDepth = 0;
+  rxWorkMaxExecUs = 0;
+  rxWorkMaxWaitMs = 0;
+  resetBtnLatency();
+}
+
+/**
+ * Statistik des Statuswert-Caches als JSON (für /api/status)
+ */
+void getStatusCacheStats(JsonObject obj) {
+  obj["sent"] = statusReportsSent;
+  obj["suppressed"] = statusReportsSuppressed;
+  
+  JsonArray entries = obj.createNestedArray("entries");
+  for (int i = 0; i < STATUS_CACHE_SIZE; i++) {
+    if (!statusCache[i].used) continue;
+    JsonObject e = entries.createNestedObject();
+    e["function"] = statusCache[i].function;
+    e["instance"] = statusCache[i].instanceID;
+    e["value"] = statusCache[i].value;
+    e["ageMs"] = millis() - statusCache[i].lastSentTime;
+  }
+}
+
+/**
+ * Ratenbegrenzungs-Statistik pro Klasse als JSON (für /api/status)
+ */
+void getRateLimitStats(JsonObject obj) {
+  obj["enabled"] = (RATE_LIMIT_ENABLED == 1);
+  obj["total"] = totalRateLimited;
+  obj["taskDropped"] = taskTelegramsDropped;
+  for (int c = 0; c < RATE_CLASS_COUNT; c++) {
+    JsonObject cls = obj.createNestedObject(rateBuckets[c].name);
+    cls["limited"] = rateBuckets[c].limited;
+    cls["tokens"] = rateBuckets[c].tokens;
+    cls["burst"] = rateBuckets[c].burst;
+    cls["refillMs"] = rateBuckets[c].refillMs;
+  }
+}
+
+/**
+ * Wartezeit-Verteilung pro Priorität als JSON (für /api/status)
+ */
+void getPriorityLatencyStats(JsonArray array) {
+  for (int p = 0; p <= PRIORITY_BACKGROUND; p++) {
+    if (priorityLatency[p].count == 0) continue;
+    
+    JsonObject obj = array.createNestedObject();
+    obj["priority"] = p;
+    obj["count"] = priorityLatency[p].count;
+    obj["avgMs"] = priorityLatency[p].sumMs / priorityLatency[p].count;
+    obj["maxMs"] = priorityLatency[p].maxMs;
+    
+    JsonArray hist = obj.createNestedArray("histogram");
+    for (int b = 0; b < LATENCY_HIST_BUCKETS; b++) {
+      hist.add(priorityLatency[p].histogram[b]);
+    }
+  }
+}
+
+/**
+ * Prüft, ob Empfang, Sendepuffer und Arbeitspuffer leer sind (für den Leerlauf)
+ */
+bool isCommunicationIdle() {
+  return !receivingTelegram &&
+         RS485Serial.available() == 0 &&
+         sendQueueCount == 0 &&
+         rxWorkCount == 0;
+}
+
+/**
+ * Prüft, ob noch Telegramme ankommen oder auf Ausführung warten (für den Frame-Takt)
+ */
+bool isRxPending() {
+  if (rxBenchmarkMode) {
+    return rxBenchmarkPending || rxWorkCount > 0;
+  }
+  return receivingTelegram ||
+         RS485Serial.available() > 0 ||
+         rxWorkCount > 0;
+}
+
+void setRxBenchmarkMode(bool active) {
+  rxBenchmarkMode = active;
+  rxBenchmarkPending = false;
+}
+
+void setRxBenchmarkPending(bool pending) {
+  rxBenchmarkPending = pending;
+}
+
 /**
  * Hauptupdate-Funktion - muss regelmäßig aufgerufen werden
  */
 void updateCommunication() {
-  // Sendepuffer abarbeiten
-  processSendQueue();
+  // Sendepuffer und Statistik laufen über das Timer-Rad (siehe setupCommunication)
+  
+  // *** NEU: Telegramme aus dem Web-Task einreihen ***
+  processTaskTelegrams();
+  
+  // *** NEU: Sendepuffer-Aufgabe starten, sobald Telegramme warten ***
+  // (Timer-Rad nur aus dem Loop-Task bedienen)
+  if (sendQueueCount > 0 && !timerWheelIsActive(sendQueueTimerId)) {
+    timerWheelStart(sendQueueTimerId, 0, SEND_QUEUE_INTERVAL);
+  }
   
   // Empfangene Telegramme verarbeiten
-  processIncomingTelegrams();
+  {
+    PROFILE_SCOPE(PROF_RX_PARSE);
+    STALL_PHASE(STALL_PHASE_RX_PARSE);
+    processIncomingTelegrams();
+  }
   
-  // Statistiken alle 30 Sekunden ausgeben
-  static unsigned long lastStatsTime = 0;
-  if (millis() - lastStatsTime > 30000) {
-    printCommunicationStats();
-    lastStatsTime = millis();
+  // *** NEU: Empfangene Aktionen mit Zeitbudget ausführen ***
+  {
+    PROFILE_SCOPE(PROF_RX_EXEC);
+    STALL_PHASE(STALL_PHASE_RX_EXEC);
+    processRxWorkQueue();
   }
 }
 
+/**
+ * Reiht ein zerlegtes Telegramm in den Arbeitspuffer ein
+ * LED-Zustände derselben LED werden zusammengefasst (nur der neueste zählt)
+ */
+void enqueueRxWork(const String& function, const String& instanceId,
+                   const String& action, const String& params) {
+  // Neuerer LED-Zustand ersetzt einen noch nicht ausgeführten älteren
+  if (function == "LED" && (action == "ON" || action == "OFF")) {
+    for (int i = 0; i < rxWorkCount; i++) {
+      RxWorkItem& item = rxWorkQueue[(rxWorkTail + i) % RX_WORK_QUEUE_SIZE];
+      if (item.function == "LED" && item.instanceId == instanceId &&
+          (item.action == "ON" || item.action == "OFF")) {
+        item.action = action;
+        item.params = params;
+        rxWorkCoalesced++;
+        return;
+      }
+    }
+  }
+  
+  // Puffer voll - ältesten Eintrag sofort ausführen, damit nichts verloren geht
+  if (rxWorkCount >= RX_WORK_QUEUE_SIZE) {
+    rxWorkOverflow++;
+    executeNextRxWork();
+  }
+  
+  RxWorkItem& item = rxWorkQueue[rxWorkHead];
+  item.function = function;
+  item.instanceId = instanceId;
+  item.action = action;
+  item.params = params;
+  item.receivedTime = millis();
+  
+  rxWorkHead = (rxWorkHead + 1) % RX_WORK_QUEUE_SIZE;
+  rxWorkCount++;
+  rxWorkQueued++;
+  if (rxWorkCount > rxWorkMaxDepth) {
+    rxWorkMaxDepth = rxWorkCount;
+  }
+}
+
+/**
+ * Führt den ältesten Eintrag des Arbeitspuffers aus
+ */
+void executeNextRxWork() {
+  if (rxWorkCount == 0) {
+    return;
+  }
+  
+  // Eintrag kopieren, bevor er freigegeben wird (Ausführung kann neue Telegramme erzeugen)
+  RxWorkItem item = rxWorkQueue[rxWorkTail];
+  rxWorkTail = (rxWorkTail + 1) % RX_WORK_QUEUE_SIZE;
+  rxWorkCount--;
+  
+  unsigned long waitMs = millis() - item.receivedTime;
+  if (waitMs > rxWorkMaxWaitMs) {
+    rxWorkMaxWaitMs = waitMs;
+  }
+  
+  unsigned long startUs = micros();
+  executeTelegram(item.function, item.instanceId, item.action, item.params);
+  // *** NEU: Nach dem Ausführen wecken - die Szene zeigt dann schon den neuen Zustand ***
+  if (!rxBenchmarkMode) {
+    screensaverNotifyTelegram(item.function);
+  }
+  unsigned long execUs = micros() - startUs;
+  
+  if (execUs > rxWorkMaxExecUs) {
+    rxWorkMaxExecUs = execUs;
+  }
+  rxWorkExecuted++;
+}
+
+/**
+ * Arbeitet den Puffer bis zum Zeitbudget ab (mindestens ein Eintrag)
+ */
+void processRxWorkQueue() {
+  unsigned long startUs = micros();
+  
+  while (rxWorkCount > 0) {
+    executeNextRxWork();
+    
+    if (micros() - startUs >= RX_WORK_BUDGET_US) {
+      break;
+    }
+  }
+}
+
+/**
+ * Statistik des Arbeitspuffers als JSON (für /api/status)
+ */
+void getRxWorkStats(JsonObject obj) {
+  obj["pending"] = rxWorkCount;
+  obj["queued"] = rxWorkQueued;
+  obj["executed"] = rxWorkExecuted;
+  obj["coalesced"] = rxWorkCoalesced;
+  obj["overflow"] = rxWorkOverflow;
+  obj["maxDepth"] = rxWorkMaxDepth;
+  obj["maxExecUs"] = rxWorkMaxExecUs;
+  obj["maxWaitMs"] = rxWorkMaxWaitMs;
+}
+
 /**
  * *** KORRIGIERTE processTelegram() Funktion mit Button-Touch-Priorität ***
+ * Prüft und zerlegt das Telegramm - die Ausführung erfolgt verzögert
+ * über den Arbeitspuffer (executeTelegram)
  */
 void processTelegram(String telegramStr) {
+  TRACE_INSTANT(TRACE_RX_FRAME, telegramStr.length());
+  
   // Überprüfen, ob das Telegramm das richtige Format hat
   if (telegramStr.length() < 10) {
     #if DB_RX_INFO == 1
@@ -658,8 +1309,10 @@ void processTelegram(String telegramStr) {
     return;
   }
 
-  // LED-Signal für den Empfang aktivieren
-  ledReceiveSignal();
+  // LED-Signal für den Empfang aktivieren (nicht für eingespielte Benchmark-Telegramme)
+  if (!rxBenchmarkMode) {
+    ledReceiveSignal();
+  }
 
   // Entferne START_BYTE und END_BYTE für die weitere Verarbeitung
   String payload = telegramStr.substring(1, telegramStr.length() - 1);
@@ -747,6 +1400,21 @@ void processTelegram(String telegramStr) {
     Serial.println(params);
   #endif
 
+  // *** NEU: Ausführung in den Arbeitspuffer verschieben ***
+  enqueueRxWork(function, instanceId, action, params);
+}
+
+/**
+ * Führt ein zerlegtes Telegramm aus (Display, Backlight, System, ...)
+ */
+void executeTelegram(const String& function, const String& instanceId,
+                     const String& action, const String& params) {
+  TRACE_SCOPE(TRACE_RX_EXEC);
+  
+  #if DB_RX_INFO == 1
+    String currentDeviceID = serviceManager.getDeviceID();
+  #endif
+
   // Funktionen verarbeiten
   if (function == "LBN") {
     // Backlight-Steuerung (nur im Normal-Modus)
@@ -761,8 +1429,8 @@ void processTelegram(String telegramStr) {
         #endif
       }
     } else if (action == "GET") {
-      // Status zurücksenden
-      sendBacklightStatus();
+      // Status zurücksenden - Antwort immer senden, auch wenn unverändert
+      sendBacklightStatus(true);
     }
   }
   else if (function == "SYS") {
@@ -774,6 +1442,11 @@ void processTelegram(String telegramStr) {
         Serial.flush();
       #endif
       
+      // *** NEU: Geplanter Neustart erscheint im Stall-Log als "restart" ***
+      STALL_PHASE(STALL_PHASE_RESTART);
+      
+      // *** NEU: Aktuellen Zustand für den Warmstart sichern ***
+      saveRtcSnapshot();
       delay(2000);
       ESP.restart();
     } else if (action == "SERVICE" || action == "WIFI" || action == "WEBSERVER" || 
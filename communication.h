@@ -28,28 +28,43 @@ void sendTelegram(String function, String instanceID, String action, String para
 /**
  * Hauptupdate-Funktion für die Kommunikation
  * Muss regelmäßig in der loop() aufgerufen werden
- * - Verarbeitet Sendepuffer
  * - Empfängt eingehende Telegramme
- * - Überwacht Bus-Status
+ * - Führt empfangene Aktionen aus (Arbeitspuffer)
+ * Sendepuffer und Statistik laufen über das Timer-Rad (setupCommunication)
  */
 void updateCommunication();
 
 /**
  * Prüft, ob der RS485-Bus frei ist (Carrier Sense)
- * 
+ *
+ * @param requiredIdleMs  Benötigte Ruhezeit seit der letzten Bus-Aktivität
+ *                        (Standard: BUS_IDLE_TIME_MS)
  * @return true wenn der Bus frei ist, false wenn belegt
  */
-bool isBusIdle();
+bool isBusIdle(unsigned long requiredIdleMs = BUS_IDLE_TIME_MS);
+
+/**
+ * Berechnet den prioritätsabhängigen Rahmenabstand (AIFS-ähnlich)
+ * Hohe Prioritäten (kleine Zahl) benötigen eine kürzere Ruhezeit und
+ * gewinnen dadurch den Buszugriff gegenüber Status-/Hintergrund-Telegrammen
+ * anderer Panels. Ein zufälliger Slot trennt Sender gleicher Priorität.
+ *
+ * @param priority     Priorität (0=höchste, 9=niedrigste)
+ * @return Benötigte Ruhezeit in Millisekunden
+ */
+unsigned long calculateInterFrameSpacing(int priority);
 
 /**
  * Sendet ein Telegramm direkt mit CSMA/CD-Algorithmus
  * Nur für interne Verwendung - normalerweise sendTelegram() verwenden
- * 
+ *
  * @param telegram     Das komplette Telegramm als String
  * @param maxRetries   Maximale Anzahl der Wiederholungsversuche
+ * @param idleTimeMs   Benötigte Ruhezeit vor dem Senden (siehe calculateInterFrameSpacing)
  * @return true bei erfolgreichem Senden, false bei Fehlschlag
  */
-bool transmitWithCSMA(const String& telegram, int maxRetries = 3);
+bool transmitWithCSMA(const String& telegram, int maxRetries = 3,
+                      unsigned long idleTimeMs = BUS_IDLE_TIME_MS);
 
 /**
  * Verarbeitet empfangene Telegramme
@@ -59,7 +74,7 @@ void processIncomingTelegrams();
 
 /**
  * Verarbeitet den Sendepuffer
- * Wird automatisch von updateCommunication() aufgerufen
+ * Wird alle SEND_QUEUE_INTERVAL ms vom Timer-Rad aufgerufen
  */
 void processSendQueue();
 
@@ -77,6 +92,25 @@ void printCommunicationStats();
  */
 void processTelegram(String telegramStr);
 
+/**
+ * Führt ein bereits zerlegtes Telegramm aus
+ * Wird vom Arbeitspuffer aufgerufen (processRxWorkQueue)
+ *
+ * @param function     Funktionskategorie (z.B. "LED", "LBN", "SYS")
+ * @param instanceId   Instanz-ID
+ * @param action       Aktion (z.B. "ON", "SET_MBR")
+ * @param params       Parameter (kann leer sein)
+ */
+void executeTelegram(const String& function, const String& instanceId,
+                     const String& action, const String& params);
+
+/**
+ * Führt empfangene Telegramme aus dem Arbeitspuffer aus, bis
+ * RX_WORK_BUDGET_US verbraucht ist (mindestens eines pro Aufruf)
+ * Wird automatisch von updateCommunication() aufgerufen
+ */
+void processRxWorkQueue();
+
 /**
  * Gibt ein Telegramm in hexadezimaler Form aus (für Debugging)
  * 
@@ -121,15 +155,36 @@ unsigned long calculateBackoffTime(int retryCount);
  */
 bool detectCollision(const String& sentTelegram);
 
+/**
+ * Sendet einen Statuswert als DEVICEID.FUNKTION.INSTANZ.STATUS.WERT,
+ * aber nur wenn er sich seit der letzten Meldung geändert hat
+ * (Cache pro Funktion/Instanz). Unveränderte Werte werden spätestens
+ * nach STATUS_REFRESH_INTERVAL trotzdem gesendet.
+ *
+ * @param function     Funktionskategorie (z.B. "LBN")
+ * @param instanceID   Instanz-ID (z.B. "16")
+ * @param value        Aktueller Wert
+ * @param deadband     Änderungen bis einschließlich deadband gelten als unverändert
+ * @param force        Immer senden (z.B. Antwort auf GET)
+ * @param priority     Priorität (Standard: PRIORITY_LOW)
+ * @return true wenn das Telegramm eingereiht wurde
+ */
+bool sendStatusValue(const String& function, const String& instanceID, int value,
+                     int deadband = 0, bool force = false, int priority = PRIORITY_LOW);
+
 /**
  * Fügt ein Telegramm zum Sendepuffer hinzu
  * 
  * @param telegram     Das komplette Telegramm
  * @param priority     Priorität (0-9)
  * @param urgent       Dringlichkeits-Flag
- * @return true bei Erfolg, false wenn Puffer voll
+ * @param latencySlot  Messplatz der Touch→Bus-Latenz (btnLatencyBegin), -1 = keiner
+ * @return true bei Erfolg, false wenn Puffer voll oder Ratenbegrenzung greift
+ *
+ * Aus anderen Tasks (Web-Server) wird das Telegramm nur abgelegt und im nächsten
+ * updateCommunication() eingereiht - Sendepuffer und Token-Buckets gehören dem Loop-Task.
  */
-bool addToSendQueue(const String& telegram, int priority = 5, bool urgent = false);
+bool addToSendQueue(const String& telegram, int priority = 5, bool urgent = false, int latencySlot = -1);
 
 /**
  * Holt das nächste Telegramm aus dem Sendepuffer
@@ -152,18 +207,78 @@ void clearSendQueue();
  */
 int getSendQueueCount();
 
+/**
+ * Liefert den noch nicht angewendeten LED-Zustand eines Buttons
+ * (wird während einer lokalen Berührung zurückgehalten)
+ * 
+ * @return true wenn ein Zustand wartet
+ */
+bool getPendingLedState(int buttonIndex, uint16_t* color, bool* active);
+
+/**
+ * Prüft, ob Empfang, Sendepuffer und Arbeitspuffer leer sind
+ * (Voraussetzung für den Leerlauf, siehe idle_manager.h)
+ */
+bool isCommunicationIdle();
+
+/**
+ * Prüft, ob noch Telegramme ankommen oder auf Ausführung warten (für den Frame-Takt)
+ */
+bool isRxPending();
+
+/**
+ * Benchmark-Modus für eingespielte Telegramme (Szenen-Burst-Benchmark)
+ * Kein Empfangs-LED-Signal, kein Wecken des Bildschirmschoners; isRxPending()
+ * liefert nur den mit setRxBenchmarkPending() simulierten Empfang.
+ */
+void setRxBenchmarkMode(bool active);
+
+// Simulierter Empfang: weitere Telegramme des Bursts sind "unterwegs"
+void setRxBenchmarkPending(bool pending);
+
+// Button wird gerade lokal gedrückt (LED-Telegramme werden dann zurückgehalten)
+bool isButtonLocallyPressed(int buttonIndex);
+
 /**
  * Setzt Kommunikations-Statistiken zurück
  */
 void resetCommunicationStats();
 
+/**
+ * Schreibt die Wartezeit-Verteilung (Sendepuffer → Bus) pro Priorität
+ * in ein JSON-Array (für /api/status)
+ *
+ * @param array        Ziel-Array, erhält ein Objekt pro benutzter Priorität
+ */
+void getPriorityLatencyStats(JsonArray array);
+
+/**
+ * Schreibt die Statistik der Ratenbegrenzung (Token-Bucket pro Klasse)
+ * in ein JSON-Objekt (für /api/status)
+ *
+ * @param obj          Ziel-Objekt, erhält Gesamtzahl und ein Objekt pro Klasse
+ */
+void getRateLimitStats(JsonObject obj);
+
+/**
+ * Schreibt gesendete/unterdrückte Statusmeldungen und die Cache-Einträge
+ * in ein JSON-Objekt (für /api/status)
+ */
+void getStatusCacheStats(JsonObject obj);
+
+/**
+ * Schreibt Füllstand und Zähler des Empfangs-Arbeitspuffers
+ * in ein JSON-Objekt (für /api/status)
+ */
+void getRxWorkStats(JsonObject obj);
+
 // Externe Variablen für Statistiken
 extern unsigned long totalSent;
 extern unsigned long totalCollisions;
 extern unsigned long totalRetries;
+extern unsigned long totalRateLimited;  // Wegen Ratenbegrenzung verworfen
 
 // Konstanten für CSMA/CD-Timing
-extern const unsigned long BUS_IDLE_TIME;
 extern const unsigned long COLLISION_DETECT_TIME;
 
 #endif // COMMUNICATION_H
\ No newline at end of file
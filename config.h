@@ -105,8 +105,37 @@ extern HardwareSerial RS485Serial;
 #define COLLISION_DETECT_TIME_MS 5   // Zeit nach Sendebeginn für Kollisionsprüfung (ms)
 #define MAX_TRANSMISSION_ATTEMPTS 3  // Maximale Sendeversuche pro Telegramm
 #define SEND_QUEUE_SIZE 10           // Größe des Sendepuffers
+#define TASK_TELEGRAM_QUEUE_SIZE 4   // Telegramme aus anderen Tasks (Web), im Loop eingereiht
 #define MAX_RETRIES_PER_TELEGRAM 5   // Maximale Wiederholungen pro Telegramm
 
+// Prioritätsabhängiger Rahmenabstand (ähnlich 802.11 AIFS)
+// Benötigte Ruhezeit vor dem Senden = BUS_IDLE_TIME_MS + Priorität * PRIORITY_IFS_STEP_MS
+// + zufälliger Slot (0 .. PRIORITY_IFS_SLOTS-1) * PRIORITY_IFS_SLOT_MS.
+// Die Slots einer Stufe müssen kürzer als PRIORITY_IFS_STEP_MS sein, damit sich
+// die Prioritätsstufen auf dem Bus nicht überlappen.
+#define PRIORITY_IFS_STEP_MS 3       // Zusätzliche Ruhezeit pro Prioritätsstufe (ms)
+#define PRIORITY_IFS_SLOTS 3         // Anzahl Zufallsslots innerhalb einer Stufe
+#define PRIORITY_IFS_SLOT_MS 1       // Dauer eines Zufallsslots (ms)
+
+// Wartezeit-Histogramm (Sendepuffer → Bus) pro Priorität
+#define LATENCY_HIST_BUCKETS 8       // Grenzen: 5/10/20/50/100/200/500/>500 ms
+
+// Token-Bucket Ratenbegrenzung für ausgehende Telegramme (pro Klasse)
+// Klasse ergibt sich aus der Priorität: <= PRIORITY_HIGH = Taster,
+// <= PRIORITY_NORMAL = Normal, darüber = Status/Hintergrund.
+// PRIORITY_CRITICAL und dringende Telegramme werden nie begrenzt.
+#define RATE_LIMIT_ENABLED 1         // 1=Ratenbegrenzung aktiv, 0=aus
+#define RATE_BTN_BURST 12            // Taster: garantierter Burst (Telegramme)
+#define RATE_BTN_REFILL_MS 100       // Taster: 1 Token pro 100ms
+#define RATE_NORMAL_BURST 8          // Normal: Burst
+#define RATE_NORMAL_REFILL_MS 250    // Normal: 1 Token pro 250ms
+#define RATE_STATUS_BURST 4          // Status: Burst
+#define RATE_STATUS_REFILL_MS 2000   // Status: 1 Token pro 2s
+
+// Empfangs-Arbeitspuffer (Zerlegung sofort, Ausführung mit Zeitbudget)
+#define RX_WORK_QUEUE_SIZE 16        // Zerlegte, noch nicht ausgeführte Telegramme
+#define RX_WORK_BUDGET_US 3000       // Ausführungsbudget pro loop()-Durchlauf (µs)
+
 // Prioritätsstufen für verschiedene Nachrichtentypen
 #define PRIORITY_CRITICAL 0      // Kritische Nachrichten (Notfälle)
 #define PRIORITY_HIGH 1          // Hohe Priorität (Taster)
@@ -172,6 +201,10 @@ extern XPT2046_Touchscreen touchscreen;
 #define TOUCH_MIN_Y 400
 #define TOUCH_MAX_Y 3900
 
+// *** NEU: Nicht-blockierende Touch-Entprellung ***
+#define TOUCH_SETTLE_MS 50            // Entprellzeit nach erstem IRQ (ersetzt delay(50) in loop)
+#define TOUCH_SAMPLE_INTERVAL_MS 20   // Abtastintervall solange der Finger aufliegt
+
 extern bool invertTouchX;
 extern bool invertTouchY;
 
@@ -180,8 +213,129 @@ extern bool invertTouchY;
 #define END_BYTE 0xFE          // Endbyte für Telegramme
 #define DEVICE_ID "5999"       // Eindeutige Geräte-ID (kann über Service-Manager geändert werden)
 
+// Timer-Rad (kooperativer Scheduler für periodische/einmalige Aufgaben)
+#define TIMER_WHEEL_MAX_TASKS 24         // Größe des festen Aufgaben-Pools
+#define HEADER_UPDATE_INTERVAL 1000      // Header-Uhr (ms)
+#define STATS_OUTPUT_INTERVAL 30000      // Serielle Kommunikations-Statistik (ms)
+#define SEND_QUEUE_INTERVAL 2            // Sendepuffer abarbeiten (ms)
+#define SERVICE_PROGRESS_INTERVAL 100    // Fortschrittsbalken Service-Aktivierung (ms)
+
+// *** NEU: Serial-Befehle (serial_commands.h, unabhängig vom Profiler) ***
+#define SERIAL_COMMAND_INTERVAL 100      // Abfrage der Eingabe (ms)
+#define SERIAL_MAX_COMMANDS 8            // Registrierte Befehle ("prof", "prof reset", "scene", ...)
+#define SERIAL_COMMAND_MAX_LENGTH 32     // Längere Zeilen werden abgeschnitten
+
+// *** NEU: Loop-Profiler (Laufzeit-Histogramme pro Teilsystem) ***
+#ifndef ENABLE_LOOP_PROFILER
+#define ENABLE_LOOP_PROFILER 1           // 1=Messpunkte einkompiliert, 0=aus (auch per Build-Flag)
+#endif
+#define PROFILER_HIST_BUCKETS 16         // log2-Buckets (1 µs .. 32 ms)
+
+// *** NEU: Touch→Bus-Latenz der Taster-Telegramme ***
+#define BTN_LATENCY_SAMPLES 32           // Fenster für die Perzentile (letzte N Telegramme)
+#define BTN_LATENCY_IN_FLIGHT 4          // Gleichzeitig gemessene Telegramme im Sendepuffer
+#define BTN_LATENCY_MAX_TOUCH_AGE_MS 1000  // Touch-Zeitstempel verfallen nach dieser Zeit
+#define BTN_LATENCY_OVERLAY 1            // 1=Perzentile im Service-Menü anzeigen
+#define BTN_LATENCY_OVERLAY_INTERVAL 1000  // Aktualisierung der Anzeige (ms)
+
+// *** NEU: Ereignis-Trace (Ringpuffer, Export als Chrome trace_event JSON) ***
+#ifndef ENABLE_EVENT_TRACE
+#define ENABLE_EVENT_TRACE 1             // 1=Aufzeichnung aktiv, 0=aus (auch per Build-Flag)
+#endif
+#define TRACE_BUFFER_SIZE 1024           // Einträge à 8 Byte, Zweierpotenz
+#define TRACE_SAVE_CHECK_INTERVAL 500    // Prüfung auf angeforderte Speicherung (ms)
+#define TRACE_MAX_EXPORTS 2              // Gleichzeitige Exporte (je 8 KB Kopie), weitere Downloads → 409
+
+// *** NEU: Stall-Überwachung (Phasen-Budgets, Log im RTC-Speicher) ***
+#ifndef ENABLE_STALL_MONITOR
+#define ENABLE_STALL_MONITOR 1           // 1=Überwachung aktiv, 0=aus (auch per Build-Flag)
+#endif
+#define STALL_CHECK_INTERVAL_MS 20       // Prüfintervall des esp_timer
+#define STALL_LOG_SIZE 8                 // Einträge im Stall-Log
+#define STALL_BUDGET_LOOP_MS 50          // loop() außerhalb der Teilabschnitte
+#define STALL_BUDGET_TIMER_MS 50         // Aufgaben im Timer-Rad
+#define STALL_BUDGET_RX_MS 50            // Empfang / Ausführung empfangener Telegramme
+#define STALL_BUDGET_TX_MS 150           // Senden mit CSMA/CD (inkl. Carrier Sense)
+#define STALL_BUDGET_TOUCH_MS 100        // Touch-Verarbeitung
+#define STALL_BUDGET_DRAW_MS 200         // Menü komplett zeichnen
+#define STALL_BUDGET_RESTART_MS 500      // Geplanter Neustart (SYS.RESET)
+#define STALL_BUDGET_CALIBRATION_MS 5000 // Display-Kalibrierung
+
+// *** NEU: Leerlauf zwischen geplanten Ereignissen (tickless idle) ***
+#ifndef IDLE_ENABLED
+#define IDLE_ENABLED 1                   // 1=loop() wartet auf Ereignisse, 0=Dauerschleife
+#endif
+#define IDLE_MIN_SLEEP_MS 2              // Kürzere Wartezeiten lohnen nicht
+#define IDLE_MAX_SLEEP_MS 1000           // Höchstens so lange am Stück warten
+#define IDLE_RX_FIFO_THRESHOLD 1         // RS485: ab diesem FIFO-Füllstand wecken (Bytes)
+#define IDLE_LIGHT_SLEEP 0               // 1=Light Sleep bei dunklem Display ohne WiFi (erstes RX-Byte geht verloren!)
+#define IDLE_LIGHT_SLEEP_MIN_MS 20       // Light Sleep erst ab dieser Wartezeit
+#define IDLE_CURRENT_RUN_MA 68.0f        // Schätzwerte ESP32 (240 MHz, ohne WiFi/Backlight)
+#define IDLE_CURRENT_WAIT_MA 30.0f       // CPU wartet (FreeRTOS-Idle)
+#define IDLE_CURRENT_LIGHT_SLEEP_MA 1.0f // Light Sleep
+
+// *** NEU: CPU-Takt abhängig von der Aktivität ***
+#ifndef CPU_FREQ_SCALING
+#define CPU_FREQ_SCALING 1               // 1=zwischen LOW und HIGH umschalten, 0=fest HIGH
+#endif
+#define CPU_FREQ_HIGH_MHZ 240            // Bei Touch, RS485-Burst, Web-Anfragen
+#define CPU_FREQ_LOW_MHZ 80              // Leerlauf (>= 80: APB bleibt 80 MHz, WiFi läuft weiter)
+#define CPU_FREQ_LOW_MAX_BACKLIGHT 20    // Herunterschalten nur bis zu dieser Helligkeit (%)
+#define CPU_FREQ_IDLE_HOLD_MS 10000      // Hysterese: so lange ohne Aktivität vor dem Herunterschalten
+#define CPU_FREQ_RX_BURST_TELEGRAMS 5    // RS485-Burst: ab so vielen Telegrammen ...
+#define CPU_FREQ_RX_BURST_WINDOW_MS 1000 // ... pro Zeitfenster hochschalten
+
+// *** NEU: Boot-Bericht (Dauer pro Boot-Stufe) ***
+#define BOOT_MAX_STAGES 10               // Maximal erfasste Boot-Stufen
+#ifndef DISPLAY_CALIBRATION_AT_BOOT
+#define DISPLAY_CALIBRATION_AT_BOOT 0    // 1=Display-Kalibrierung beim Start (Serial-Menü, blockiert den Loop)
+#endif
+#define CALIBRATION_CONFIRM_TIMEOUT_MS 5000 // Warten auf Enter nach der Kalibrierung
+
+// *** NEU: Warmstart-Schnappschuss im RTC-Speicher ***
+#ifndef ENABLE_RTC_SNAPSHOT
+#define ENABLE_RTC_SNAPSHOT 1            // 1=Zustand nach Reset wiederherstellen, 0=aus
+#endif
+#define RTC_SNAPSHOT_INTERVAL 500        // Vergleichsintervall (ms), geschrieben wird nur bei Änderung
+
+// *** NEU: Dirty-Rect-Compositor (Hauptmenü) ***
+#define UI_MAX_DIRTY_RECTS 16            // Markierte Bereiche pro Frame (bei Überlauf zusammengefasst)
+#ifndef UI_BAND_RENDER
+#define UI_BAND_RENDER 1                 // 1=in Bändern mit DMA zeichnen, 0=direkt auf das Display
+#endif
+#define UI_BAND_LINES 16                 // Zeilen pro Band (2 Puffer à 320 x 16 x 2 Byte = 20 KB)
+#define UI_FRAME_INTERVAL_MS 33          // Frame-Takt (~30 Hz), 0 = sofort nach jeder Änderung zeichnen
+#define UI_FRAME_MAX_DELAY_MS 100        // Frame höchstens so lange wegen laufenden Empfangs verschieben
+#define UI_BENCH_ROUNDS 10               // Szenen pro Durchlauf im Szenen-Burst-Benchmark
+
+// *** NEU: Label-Cache (vorgerenderte Button-Beschriftungen) ***
+#define LABEL_CACHE_SIZE 12              // Einträge (6 Buttons + Wechsel der Konfiguration)
+
+// *** NEU: Icons auf den Buttons (RLE aus dem Flash) ***
+#ifndef BUTTON_ICONS
+#define BUTTON_ICONS 1                   // 1=Icon über der Beschriftung, 0=nur Text
+#endif
+#define BUTTON_ICON_GAP 4                // Abstand Icon → Beschriftung (Pixel)
+
+// *** NEU: Bildschirmschoner (Voreinstellung, änderbar über /api/screensaver) ***
+#define SCREENSAVER_TIMEOUT 0            // Sekunden ohne Bedienung bis zum Dimmen, 0 = aus (DisplayConfig.screenTimeout)
+#define SCREENSAVER_ENABLED false        // nach dem Dimmen ganz ausschalten (DisplayConfig.screensaverEnabled)
+#define SCREENSAVER_DIM_PERCENT 20       // Helligkeit der Dimmstufe (%)
+#define SCREENSAVER_OFF_DELAY 60         // Sekunden von der Dimmstufe bis zum Ausschalten
+#define SCREENSAVER_WAKE_TELEGRAMS "LED" // Telegramm-Funktionen, die wecken (LED,LBN,SYS,TIME,DATE,BTN)
+#define SCREENSAVER_FADE_MS 800          // Dauer eines LEDC-Hardware-Fades
+
 // Timing für Status-Updates
 #define BACKLIGHT_STATUS_INTERVAL 23000  // Intervall für Backlight-Status
+#define BACKLIGHT_STATUS_DEADBAND 2        // Änderungen ≤ 2% werden nicht gemeldet
+
+// Statuswert-Cache (zuletzt gesendeter Wert pro Funktion/Instanz)
+#define STATUS_CACHE_SIZE 8               // Anzahl Einträge (Funktion, Instanz)
+#define STATUS_REFRESH_INTERVAL 300000    // Heartbeat: unveränderte Werte spätestens alle 5 min senden
+
+// Periodische Meldungen (report_scheduler) - Phase aus Device ID + Jitter
+#define MAX_PERIODIC_REPORTS 4           // Maximale Anzahl registrierter Meldungen
+#define REPORT_JITTER_PERCENT 10         // Zufälliger Versatz pro Periode (±% der Periode)
 
 // *** WICHTIG: NUM_BUTTONS FRÜH DEFINIEREN ***
 #define NUM_BUTTONS 6           // Anzahl der Bildschirmtaster
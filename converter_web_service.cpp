@@ -5,6 +5,8 @@
 #include "menu.h"
 #include "web_server_manager.h"
 #include <EEPROM.h>
+#include "trace.h"
+#include "label_cache.h"
 #include <SPIFFS.h>
 
 // Globale Instanz
@@ -179,6 +181,9 @@ bool ConverterWebService::applyButtonsToDisplay() {
                  i + 1, buttons[i].label.c_str());
   }
   
+  // *** NEU: Neue Beschriftungen - vorgerenderte Masken verwerfen ***
+  labelCacheClear();
+  
   // Display neu zeichnen
   drawButtons();
   
@@ -323,6 +328,8 @@ bool ConverterWebService::saveAll() {
 }
 
 bool ConverterWebService::saveButtons() {
+  TRACE_SCOPE(TRACE_BUTTONS_SAVE);
+  
   // Sync von Display
   syncButtonsFromDisplay();
   
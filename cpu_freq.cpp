@@ -0,0 +1,224 @@
+#include "cpu_freq.h"
+#include "communication.h"
+#include "touch.h"
+#include "profiler.h"
+#include "idle_manager.h"
+#include "backlight.h"
+
+// Takt-Stufen
+#define CPU_LEVEL_LOW 0
+#define CPU_LEVEL_HIGH 1
+#define CPU_LEVEL_COUNT 2
+
+const uint32_t cpuLevelMhz[CPU_LEVEL_COUNT] = { CPU_FREQ_LOW_MHZ, CPU_FREQ_HIGH_MHZ };
+
+// Messwerte pro Takt-Stufe
+struct CpuLevelStats {
+  uint64_t timeMs;              // Verweildauer
+  uint32_t entered;             // Umschaltungen in diese Stufe
+  uint32_t rxTelegrams;         // Vollständig empfangene Telegramme
+  uint32_t rxAborted;           // Abgebrochener Empfang (Timeout / Überlauf)
+  uint32_t rxWakeCount;         // Weck-Latenz durch RS485-Empfang
+  uint64_t rxWakeTotalUs;
+  uint32_t rxWakeMaxUs;
+  volatile uint32_t uartFrameErrors;   // Vom UART-Task gezählt
+  volatile uint32_t uartParityErrors;
+  volatile uint32_t uartOverflows;
+  volatile uint32_t uartBreaks;
+};
+
+CpuLevelStats cpuLevelStats[CPU_LEVEL_COUNT];
+
+volatile int cpuLevel = CPU_LEVEL_HIGH;
+unsigned long cpuLevelSinceMs = 0;
+unsigned long cpuLastActivityMs = 0;
+const char* cpuLastSwitchReason = "boot";
+
+// Umschaltung
+uint32_t cpuSwitchLastUs = 0;
+uint32_t cpuSwitchMaxUs = 0;
+uint32_t cpuSwitchFailed = 0;
+uint32_t cpuApbChanges = 0;
+
+// RS485-Burst-Erkennung (festes Zeitfenster)
+unsigned long cpuRxWindowStartMs = 0;
+uint16_t cpuRxWindowCount = 0;
+
+// Letzte Web-Anfrage (vom Web-Task geschrieben)
+volatile unsigned long cpuWebActivityMs = 0;
+volatile bool cpuWebActivityPending = false;
+
+// UART-Fehler der Stufe zuordnen, in der sie auftreten
+void onRs485ReceiveError(hardwareSerial_error_t error) {
+  CpuLevelStats& stats = cpuLevelStats[cpuLevel];
+  switch (error) {
+    case UART_FRAME_ERROR:       stats.uartFrameErrors++; break;
+    case UART_PARITY_ERROR:      stats.uartParityErrors++; break;
+    case UART_FIFO_OVF_ERROR:
+    case UART_BUFFER_FULL_ERROR: stats.uartOverflows++; break;
+    case UART_BREAK_ERROR:       stats.uartBreaks++; break;
+    default: break;
+  }
+}
+
+void setupCpuFreq() {
+  memset(cpuLevelStats, 0, sizeof(cpuLevelStats));
+  cpuLevelSinceMs = millis();
+  cpuLastActivityMs = millis();
+  cpuRxWindowStartMs = millis();
+
+  RS485Serial.onReceiveError(onRs485ReceiveError);
+
+  #if CPU_FREQ_SCALING == 1
+    setCpuFrequencyMhz(CPU_FREQ_HIGH_MHZ);
+    profilerCpuFreqChanged();
+    cpuLevel = CPU_LEVEL_HIGH;
+    cpuLevelStats[CPU_LEVEL_HIGH].entered = 1;
+
+    Serial.printf("CPU-Takt: %d/%d MHz, APB %lu MHz\n", CPU_FREQ_LOW_MHZ, CPU_FREQ_HIGH_MHZ,
+                  (unsigned long)(getApbFrequency() / 1000000UL));
+  #endif
+}
+
+void applyCpuLevel(int level, const char* reason) {
+  uint32_t apbBefore = getApbFrequency();
+  uint32_t startUs = micros();
+
+  if (!setCpuFrequencyMhz(cpuLevelMhz[level])) {
+    cpuSwitchFailed++;
+    return;
+  }
+
+  // Bei 80/160/240 MHz bleibt der APB-Takt bei 80 MHz - UART-Teiler und die
+  // SPI-Teiler von Display und Touch (pro Transaktion berechnet) gelten weiter.
+  // Ändert sich der APB-Takt doch (z.B. CPU_FREQ_LOW_MHZ < 80), Baudrate neu setzen.
+  if (getApbFrequency() != apbBefore) {
+    RS485Serial.updateBaudRate(57600);  // wie in setupCommunication()
+    cpuApbChanges++;
+  }
+
+  cpuSwitchLastUs = micros() - startUs;
+  if (cpuSwitchLastUs > cpuSwitchMaxUs) {
+    cpuSwitchMaxUs = cpuSwitchLastUs;
+  }
+
+  // Profiler rechnet Zyklen mit dem neuen Takt um
+  profilerCpuFreqChanged();
+
+  unsigned long now = millis();
+  cpuLevelStats[cpuLevel].timeMs += now - cpuLevelSinceMs;
+  cpuLevelSinceMs = now;
+  cpuLevel = level;
+  cpuLevelStats[level].entered++;
+  cpuLastSwitchReason = reason;
+
+  #if DB_INFO == 1
+    Serial.printf("CPU-Takt: %lu MHz (%s, %lu µs)\n",
+                  (unsigned long)cpuLevelMhz[level], reason, (unsigned long)cpuSwitchLastUs);
+  #endif
+}
+
+void updateCpuFreq() {
+  #if CPU_FREQ_SCALING == 1
+    unsigned long now = millis();
+
+    // Aktivität ermitteln
+    const char* reason = nullptr;
+    if (!isTouchIdle()) {
+      reason = "touch";
+    } else if (cpuWebActivityPending) {
+      cpuWebActivityPending = false;
+      reason = "web";
+    } else if (cpuRxWindowCount >= CPU_FREQ_RX_BURST_TELEGRAMS) {
+      reason = "rxBurst";
+    }
+
+    if (now - cpuRxWindowStartMs >= CPU_FREQ_RX_BURST_WINDOW_MS) {
+      cpuRxWindowStartMs = now;
+      cpuRxWindowCount = 0;
+    }
+
+    if (reason != nullptr) {
+      cpuLastActivityMs = now;
+      if (cpuLevel != CPU_LEVEL_HIGH) {
+        applyCpuLevel(CPU_LEVEL_HIGH, reason);
+      }
+      return;
+    }
+
+    // Hysterese: erst nach CPU_FREQ_IDLE_HOLD_MS ohne Aktivität und bei dunklem Display
+    if (cpuLevel == CPU_LEVEL_HIGH &&
+        getEffectiveBacklight() <= CPU_FREQ_LOW_MAX_BACKLIGHT &&  // inkl. Bildschirmschoner
+        now - cpuLastActivityMs >= CPU_FREQ_IDLE_HOLD_MS) {
+      applyCpuLevel(CPU_LEVEL_LOW, "idle");
+    }
+  #endif
+}
+
+void cpuFreqNoteRxTelegram() {
+  cpuLevelStats[cpuLevel].rxTelegrams++;
+  cpuRxWindowCount++;
+}
+
+void cpuFreqNoteRxAborted() {
+  cpuLevelStats[cpuLevel].rxAborted++;
+}
+
+void cpuFreqNoteWebActivity() {
+  cpuWebActivityMs = millis();
+  cpuWebActivityPending = true;
+  idleWakeFromTask();  // Loop-Task schaltet sofort hoch
+}
+
+void cpuFreqRecordRxWakeLatency(uint32_t latencyUs) {
+  CpuLevelStats& stats = cpuLevelStats[cpuLevel];
+  stats.rxWakeCount++;
+  stats.rxWakeTotalUs += latencyUs;
+  if (latencyUs > stats.rxWakeMaxUs) {
+    stats.rxWakeMaxUs = latencyUs;
+  }
+}
+
+void getCpuFreqStats(JsonObject obj) {
+  unsigned long now = millis();
+
+  obj["enabled"] = CPU_FREQ_SCALING == 1;
+  obj["currentMhz"] = getCpuFrequencyMhz();
+  obj["apbMhz"] = getApbFrequency() / 1000000UL;
+  obj["uartBaud"] = RS485Serial.baudRate();
+  obj["lastReason"] = cpuLastSwitchReason;
+  obj["lastSwitchUs"] = cpuSwitchLastUs;
+  obj["maxSwitchUs"] = cpuSwitchMaxUs;
+  obj["failedSwitches"] = cpuSwitchFailed;
+  obj["apbChanges"] = cpuApbChanges;
+  obj["lastWebActivityMs"] = cpuWebActivityMs > 0 ? now - cpuWebActivityMs : 0;
+
+  uint64_t totalMs = 0;
+  uint64_t levelMs[CPU_LEVEL_COUNT];
+  for (int i = 0; i < CPU_LEVEL_COUNT; i++) {
+    levelMs[i] = cpuLevelStats[i].timeMs;
+    if (i == cpuLevel) {
+      levelMs[i] += now - cpuLevelSinceMs;
+    }
+    totalMs += levelMs[i];
+  }
+
+  JsonArray levels = obj.createNestedArray("levels");
+  for (int i = 0; i < CPU_LEVEL_COUNT; i++) {
+    CpuLevelStats& stats = cpuLevelStats[i];
+    JsonObject l = levels.createNestedObject();
+    l["mhz"] = cpuLevelMhz[i];
+    l["timeMs"] = levelMs[i];
+    l["percent"] = totalMs > 0 ? (levelMs[i] * 100.0f / totalMs) : 0;
+    l["entered"] = stats.entered;
+    l["rxTelegrams"] = stats.rxTelegrams;
+    l["rxAborted"] = stats.rxAborted;
+    l["rxWakeCount"] = stats.rxWakeCount;
+    l["rxWakeAvgUs"] = stats.rxWakeCount > 0 ? (uint32_t)(stats.rxWakeTotalUs / stats.rxWakeCount) : 0;
+    l["rxWakeMaxUs"] = stats.rxWakeMaxUs;
+    l["uartFrameErrors"] = stats.uartFrameErrors;
+    l["uartParityErrors"] = stats.uartParityErrors;
+    l["uartOverflows"] = stats.uartOverflows;
+    l["uartBreaks"] = stats.uartBreaks;
+  }
+}
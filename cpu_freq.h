@@ -0,0 +1,44 @@
+/**
+ * cpu_freq.h - CPU-Takt abhängig von der Aktivität (80 / 240 MHz)
+ *
+ * Heruntergeschaltet (CPU_FREQ_LOW_MHZ) wird nur, wenn
+ * - die Hintergrundbeleuchtung höchstens CPU_FREQ_LOW_MAX_BACKLIGHT % beträgt und
+ * - seit CPU_FREQ_IDLE_HOLD_MS keine Aktivität war (Hysterese).
+ *
+ * Aktivität (sofort CPU_FREQ_HIGH_MHZ):
+ * - Berührung (Touch-Zustandsmaschine nicht im Leerlauf)
+ * - RS485-Burst (mindestens CPU_FREQ_RX_BURST_TELEGRAMS pro CPU_FREQ_RX_BURST_WINDOW_MS)
+ * - Anfrage an den Web-Server
+ *
+ * Umgeschaltet wird nur im Loop-Task zwischen zwei Durchläufen. Zeit pro Takt,
+ * RX-Weck-Latenz, Empfangsfehler und UART-Fehler werden pro Takt gezählt
+ * (unter "cpuFreq" in /api/status).
+ */
+#ifndef CPU_FREQ_H
+#define CPU_FREQ_H
+
+#include "config.h"
+
+// Startet mit CPU_FREQ_HIGH_MHZ und registriert die UART-Fehlerzählung
+// (nach setupCommunication aufrufen)
+void setupCpuFreq();
+
+// Prüft die Aktivität und schaltet bei Bedarf um (in loop(), außerhalb der Messabschnitte)
+void updateCpuFreq();
+
+// Vollständig empfangenes Telegramm (für Burst-Erkennung und Statistik)
+void cpuFreqNoteRxTelegram();
+
+// Abgebrochener Empfang (Timeout / Überlauf)
+void cpuFreqNoteRxAborted();
+
+// Anfrage an den Web-Server (aus dem Web-Task aufrufbar)
+void cpuFreqNoteWebActivity();
+
+// Weck-Latenz durch RS485-Empfang (vom Leerlauf gemessen)
+void cpuFreqRecordRxWakeLatency(uint32_t latencyUs);
+
+// Zeit pro Takt, Umschaltungen und RX-Messwerte als JSON (für /api/status)
+void getCpuFreqStats(JsonObject obj);
+
+#endif // CPU_FREQ_H
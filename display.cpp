@@ -1,7 +1,9 @@
 // display.cpp
 #include "config.h"
+#include "spi_bus.h"
 
 void setupDisplay() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   tft.init();
   
   // *** KORRIGIERT: Direkt SCREEN_ORIENTATION verwenden ***
@@ -9,6 +9,7 @@
 #include "menu.h"
 #include "header_display.h"
 #include "touch.h"
+#include "spi_bus.h"
 
 // Globale Kalibrierungs-Ergebnisse
 CalibrationResult calibrationResult;
@@ -28,12 +29,14 @@ void startDisplayCalibration() {
   ledcWrite(TFT_BL_PIN, 255);  // Volle Helligkeit
   
   // TFT initialisieren
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.init();
   tft.setRotation(0);  // Start mit Rotation 0
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK);
   tft.drawString("Display-Kalibrierung", 10, 10, 2);
   tft.drawString("Startet in 2 Sekunden...", 10, 40, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   delay(2000);  // Display-Test
   
@@ -83,11 +86,11 @@ void quickRotationTest() {
     Serial.print(" - ");
     showRotationInfo(rotation);
     
-    // Rotation setzen
+    // Rotation setzen (MADCTL) und Test-Pattern anzeigen
+    spiBusAcquire(SPI_BUS_DISPLAY);
     tft.setRotation(rotation);
-    
-    // Test-Pattern anzeigen
     drawTestPattern(rotation);
+    spiBusRelease(SPI_BUS_DISPLAY);
     
     // Einfacher Touch-Test (ohne getTouchPoint Details)
     Serial.println("Touch-Test läuft...");
@@ -95,15 +98,17 @@ void quickRotationTest() {
     bool touchDetected = false;
     
     while (millis() - testStart < 15000) { // 15 Sekunden
-      if (touchscreen.tirqTouched() && touchscreen.touched()) {
+      if (touchscreen.tirqTouched() && touchReadTouched()) {
         touchDetected = true;
         
         // Einfaches visuelles Feedback ohne Koordinaten-Details
+        spiBusAcquire(SPI_BUS_DISPLAY);
         tft.fillCircle(tft.width()/2, tft.height()/2, 10, TFT_RED);
+        spiBusRelease(SPI_BUS_DISPLAY);
         
         Serial.println("Touch erkannt!");
         delay(500);
-        while (touchscreen.touched()) delay(10);
+        while (touchReadTouched()) delay(10);
         break;
       }
     }
@@ -137,6 +142,7 @@ void showRotationInfo(int rotation) {
 }
 
 void drawTestPattern(int rotation) {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   
   // Einfaches Test-Muster
@@ -147,9 +153,11 @@ void drawTestPattern(int rotation) {
   tft.drawString(sizeInfo, 10, 30, 1);
   
   // Versuche Layout-Elemente zu zeichnen (mit Fehlerbehandlung)
-  drawHeader();
+  paintHeader();
   initButtons();
-  drawButtons();
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    paintButton(i);
+  }
   
   // Einfache Test-Rechtecke
   int w = tft.width();
@@ -208,8 +216,10 @@ void serialControlledTest() {
 void testSingleRotation(int rotation) {
   Serial.print("Teste Rotation ");
   Serial.println(rotation);
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.setRotation(rotation);
   drawTestPattern(rotation);
+  spiBusRelease(SPI_BUS_DISPLAY);
   delay(3000);
 }
 
@@ -224,6 +234,7 @@ void testLayoutForRotation(int rotation) {
 
 void drawTestCrosses() {
   // Vereinfacht - nur Rechtecke
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   int w = tft.width();
   int h = tft.height();
   tft.fillRect(30, 80, 20, 20, TFT_RED);
@@ -235,18 +246,19 @@ void drawTestCrosses() {
 
 void drawCross(int x, int y, uint16_t color) {
   // Vereinfachtes Kreuz
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   tft.drawLine(x-10, y, x+10, y, color);
   tft.drawLine(x, y-10, x, y+10, color);
 }
 
 void waitForTouch(String message) {
   if (message != "") Serial.println(message);
-  while (!touchscreen.tirqTouched() || !touchscreen.touched()) delay(50);
-  while (touchscreen.touched()) delay(10);
+  while (!touchscreen.tirqTouched() || !touchReadTouched()) delay(50);
+  while (touchReadTouched()) delay(10);
 }
 
 bool waitForSerialInput() {
   unsigned long startTime = millis();
-  while (!Serial.available() && (millis() - startTime < 5000)) delay(100);
+  while (!Serial.available() && (millis() - startTime < CALIBRATION_CONFIRM_TIMEOUT_MS)) delay(100);
   return Serial.available();
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "header_display.h"
 #include "service_manager.h"
+#include "trace.h"
+#include "ui_compositor.h"
+#include "icons.h"
 
 // Simulierte Zeit (da keine RTC vorhanden)
 TimeInfo currentTime = {14, 30, 0, 26, 5, 2025};  // 14:30:00, 26.05.2025
@@ -122,15 +125,75 @@ String formatDate() {
   return dateStr;
 }
 
+// *** NEU: Header über den Compositor zeichnen (gezeichnet wird in uiRender()) ***
 void drawHeader() {
+  uiMarkHeaderDirty(true);
+}
+
+// Bereich des Headers inkl. Trennlinie
+void getHeaderRect(int* x, int* y, int* w, int* h) {
+  int headerY = getHeaderY();
+  *x = 0;
+  *w = tft.width();
+  if (headerY == 0) {
+    // Header oben → Linie unten
+    *y = 0;
+    *h = HEADER_HEIGHT + 1;
+  } else {
+    *y = headerY;
+    *h = HEADER_HEIGHT;
+  }
+}
+
+// Bereich eines Header-Teils (für das Neuzeichnen nur geänderter Teile)
+void getHeaderPartRect(HeaderPart part, int* x, int* y, int* w, int* h) {
+  int headerY = getHeaderY();
+  int serviceIconX = tft.width() - SERVICE_ICON_SIZE - 2;
+  *y = headerY + 1;
+  *h = 18;
+  switch (part) {
+    case HEADER_PART_TIME:
+      *x = 2;
+      *w = 40;
+      break;
+    case HEADER_PART_DATE:
+      *x = 45;
+      *w = 70;
+      break;
+    case HEADER_PART_DEVICE_ID:
+      // Zwischen Datum und Service-Icon (Breite der ID ist variabel)
+      *x = 115;
+      *w = serviceIconX - 115;
+      break;
+    case HEADER_PART_ICON:
+    default:
+      *x = serviceIconX;
+      *w = SERVICE_ICON_SIZE;
+      break;
+  }
+}
+
+// Zelle eines Zeichens von Uhrzeit oder Datum (Font 1 hat feste Zeichenbreite)
+void getHeaderGlyphRect(HeaderPart part, int charIndex, int* x, int* y, int* w, int* h) {
+  int textX = (part == HEADER_PART_DATE) ? 45 : 2;
+  *w = tft.textWidth("0", 1);
+  *h = tft.fontHeight(1);
+  *x = textX + charIndex * *w;
+  *y = getHeaderY() + 6;
+}
+
+// Zeichnet den Header auf gfx (Display oder Band-Sprite); originX/Y: Bildschirmposition von (0,0) in gfx
+void paintHeader(TFT_eSPI& gfx, int originX, int originY) {
+  TRACE_SCOPE(TRACE_HEADER_DRAW);
+  
   // *** KORRIGIERTE Header-Position ***
   int currentScreenWidth = tft.width();
-  int currentScreenHeight = tft.height(); 
   int headerY = getHeaderY();
-  int rotation = tft.getRotation();
   
   #if DB_INFO == 1
-    Serial.print("DEBUG: drawHeader() - Rotation: ");
+    int currentScreenHeight = tft.height();
+    int rotation = tft.getRotation();
+    Serial.print("DEBUG: paintHeader() - Rotation: ");
     Serial.print(rotation);
     Serial.print(", Screen: ");
     Serial.print(currentScreenWidth);
@@ -140,65 +203,53 @@ void drawHeader() {
     Serial.println(headerY);
   #endif
   
+  // *** NEU: Auf gfx-Koordinaten umrechnen ***
+  int x0 = -originX;
+  int y0 = headerY - originY;
+  
   // Header-Hintergrund (dunkelgrau)
-  tft.fillRect(0, headerY, currentScreenWidth, HEADER_HEIGHT, TFT_DARKGREY);
+  gfx.fillRect(x0, y0, currentScreenWidth, HEADER_HEIGHT, TFT_DARKGREY);
   
   // Header-Linie (unter oder über dem Header je nach Position)
   if (headerY == 0) {
     // Header oben → Linie unten
-    tft.drawLine(0, headerY + HEADER_HEIGHT, currentScreenWidth, headerY + HEADER_HEIGHT, TFT_BLACK);
+    gfx.drawLine(x0, y0 + HEADER_HEIGHT, x0 + currentScreenWidth, y0 + HEADER_HEIGHT, TFT_BLACK);
   } else {
     // Header unten → Linie oben  
-    tft.drawLine(0, headerY, currentScreenWidth, headerY, TFT_BLACK);
+    gfx.drawLine(x0, y0, x0 + currentScreenWidth, y0, TFT_BLACK);
   }
   
   // Text-Einstellungen
-  tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-  tft.setTextSize(1);
+  gfx.setTextColor(TFT_WHITE, TFT_DARKGREY);
+  gfx.setTextSize(1);
   
   // *** KORRIGIERTE Text-Positionen ***
-  int textY = headerY + 6;  // 6 Pixel vom Header-Rand nach innen
+  int textY = y0 + 6;  // 6 Pixel vom Header-Rand nach innen
   
   // Zeit links (Position 2, textY)
   String timeStr = formatTime();
-  tft.drawString(timeStr, 2, textY, 1);
+  gfx.drawString(timeStr, x0 + 2, textY, 1);
   
   // Datum links-mitte (Position 45, textY)
   String dateStr = formatDate();
-  tft.drawString(dateStr, 45, textY, 1);
+  gfx.drawString(dateStr, x0 + 45, textY, 1);
   
   // Device ID rechts-mitte - DYNAMISCH berechnet
   String deviceID = "ID:" + serviceManager.getDeviceID();
   int deviceIdWidth = deviceID.length() * 6;  // Ungefähre Breite
   int deviceIdX = currentScreenWidth - SERVICE_ICON_SIZE - deviceIdWidth - 8;
-  tft.drawString(deviceID, deviceIdX, textY, 1);
+  gfx.drawString(deviceID, x0 + deviceIdX, textY, 1);
   
   // Service-Icon rechts - DYNAMISCH berechnet
-  drawServiceIcon(serviceManager.isServiceMode());
+  int serviceIconX = currentScreenWidth - SERVICE_ICON_SIZE - 2;
+  paintServiceIcon(gfx, x0 + serviceIconX, y0 + 1, serviceManager.isServiceMode());
 }
 
 void updateHeaderTime() {
-  // *** KORRIGIERTE Zeit-Update mit dynamischer Y-Position ***
-  int currentScreenWidth = tft.width();
-  int headerY = getHeaderY();
-  int textY = headerY + 6;
-  
-  // Nur Zeit und Datum aktualisieren (ohne kompletten Header neu zu zeichnen)
   updateSimulatedTime();
   
-  // Zeit-Bereich überschreiben
-  tft.fillRect(2, headerY + 1, 40, 18, TFT_DARKGREY);
-  tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-  String timeStr = formatTime();
-  tft.drawString(timeStr, 2, textY, 1);
-  
-  // Datum-Bereich überschreiben  
-  tft.fillRect(45, headerY + 1, 70, 18, TFT_DARKGREY);
-  String dateStr = formatDate();
-  tft.drawString(dateStr, 45, textY, 1);
-  
-  // *** Service-Icon bei Orientierungsumschaltung neu positionieren ***
-  drawServiceIcon(serviceManager.isServiceMode());
+  // *** GEÄNDERT: Nur geänderte Teile (Zeit, Datum, Icon) werden neu gezeichnet ***
+  uiMarkHeaderDirty(false);
 }
 
 void drawServiceIcon(bool active) {
@@ -208,36 +259,7 @@ void drawServiceIcon(bool active) {
   int serviceIconX = currentScreenWidth - SERVICE_ICON_SIZE - 2;
   int serviceIconY = headerY + 1;  // 1 Pixel vom Header-Rand
   
-  // Service-Icon: Zahnrad-Symbol in 18x18 Pixel
-  uint16_t iconColor = active ? TFT_YELLOW : TFT_LIGHTGREY;
-  uint16_t bgColor = TFT_DARKGREY;
-  
-  int centerX = serviceIconX + SERVICE_ICON_SIZE/2;
-  int centerY = serviceIconY + SERVICE_ICON_SIZE/2;
-  
-  // Hintergrund löschen
-  tft.fillRect(serviceIconX, serviceIconY, SERVICE_ICON_SIZE, SERVICE_ICON_SIZE, bgColor);
-  
-  // Einfaches Zahnrad-Symbol (8x8 Pixel Kern + Zähne)
-  // Äußerer Kreis (Zahnrad-Rand)
-  tft.drawCircle(centerX, centerY, 8, iconColor);
-  tft.drawCircle(centerX, centerY, 7, iconColor);
-  
-  // Innerer Kreis (Zahnrad-Mitte)
-  tft.fillCircle(centerX, centerY, 3, iconColor);
-  tft.fillCircle(centerX, centerY, 2, bgColor);
-  
-  // Zahnrad-Zähne (8 kleine Rechtecke)
-  for (int i = 0; i < 8; i++) {
-    float angle = i * 45.0 * PI / 180.0;
-    int x = centerX + cos(angle) * 9;
-    int y = centerY + sin(angle) * 9;
-    tft.fillRect(x-1, y-1, 2, 2, iconColor);
-  }
-  
-  // Service-Symbol "S" in der Mitte
-  tft.setTextColor(bgColor, iconColor);
-  tft.drawString("S", centerX-3, centerY-4, 1);
+  paintServiceIcon(tft, serviceIconX, serviceIconY, active);
   
   #if DB_INFO == 1
     Serial.print("DEBUG: Service-Icon gezeichnet bei X=");
@@ -254,6 +276,17 @@ void drawServiceIcon(bool active) {
   #endif
 }
 
+// Zeichnet das Zahnrad an (serviceIconX, serviceIconY) in gfx-Koordinaten
+void paintServiceIcon(TFT_eSPI& gfx, int serviceIconX, int serviceIconY, bool active) {
+  // Service-Icon: Zahnrad-Symbol in 18x18 Pixel
+  uint16_t iconColor = active ? TFT_YELLOW : TFT_LIGHTGREY;
+  uint16_t bgColor = TFT_DARKGREY;
+  
+  // *** GEÄNDERT: Vorberechnetes Zahnrad aus dem Flash (deckend inkl. Hintergrund) ***
+  // statt cos/sin, zwei Kreisen und acht Rechtecken bei jedem Zeichnen
+  iconBlit(gfx, ICON_GEAR, serviceIconX, serviceIconY, iconColor, bgColor);
+}
+
 bool checkServiceIconTouch(int x, int y) {
   // *** KORRIGIERTE Touch-Bereich mit dynamischer Y-Position ***
   int currentScreenWidth = tft.width();
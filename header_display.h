@@ -20,11 +20,24 @@
 #define SERVICE_TOUCH_AREA_WIDTH 60   
 #define SERVICE_TOUCH_AREA_HEIGHT 30  
 
+// Teile des Headers (einzeln neu zu zeichnen)
+enum HeaderPart {
+  HEADER_PART_TIME,
+  HEADER_PART_DATE,
+  HEADER_PART_DEVICE_ID,
+  HEADER_PART_ICON
+};
+
 // Header-Funktionen
 void setupHeaderDisplay();
-void drawHeader();
+void drawHeader();                   // Markiert den Header (gezeichnet wird in uiRender())
+void paintHeader(TFT_eSPI& gfx = tft, int originX = 0, int originY = 0);  // Zeichnet den Header (nur für den Compositor)
 void updateHeaderTime();
+void getHeaderRect(int* x, int* y, int* w, int* h);
+void getHeaderPartRect(HeaderPart part, int* x, int* y, int* w, int* h);
+void getHeaderGlyphRect(HeaderPart part, int charIndex, int* x, int* y, int* w, int* h);  // Zeit/Datum
 void drawServiceIcon(bool active = false);
+void paintServiceIcon(TFT_eSPI& gfx, int serviceIconX, int serviceIconY, bool active);
 bool checkServiceIconTouch(int x, int y);
 
 // *** NEU: Positionierungs-Hilfsfunktionen ***
@@ -44,6 +57,7 @@ struct TimeInfo {
 };
 
 extern TimeInfo currentTime;
+extern unsigned long lastTimeUpdate;
 void updateSimulatedTime();
 String formatTime();
 String formatDate();
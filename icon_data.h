@@ -0,0 +1,255 @@
+/**
+ * icon_data.h - Icons als RLE-Daten im Flash
+ *
+ * Format: ein Byte pro Lauf, Bit 7-6 = Palettenindex, Bit 5-0 = Länge - 1
+ * (1-64 Pixel, Läufe gehen über das Zeilenende hinaus). Palette beim Zeichnen:
+ * 0 = transparent, 1 = Symbolfarbe, 2 = Hintergrundfarbe, 3 = Akzentfarbe.
+ * Die Vorlage steht als Kommentar über den Daten (# = 1, Leerzeichen = 2, . = 0).
+ *
+ * Nur von icons.cpp einbinden.
+ */
+#ifndef ICON_DATA_H
+#define ICON_DATA_H
+
+#include <Arduino.h>
+
+// Service-Zahnrad (1=Symbol, 2=Hintergrund) (18x18, 51 Byte statt 648 Byte RGB565)
+//   |        ##        |
+//   |        ##        |
+//   |   #    ##    #   |
+//   |  ##############  |
+//   |   ############   |
+//   |   ############   |
+//   |   ############   |
+//   |   ####    ####   |
+//   |#######    #######|
+//   |#######    #######|
+//   |   ####    ####   |
+//   |   ############   |
+//   |   ############   |
+//   |   ############   |
+//   |  ##############  |
+//   |   #    ##    #   |
+//   |        ##        |
+//   |        ##        |
+const uint8_t ICON_GEAR_RLE[] PROGMEM = {
+  0x87, 0x41, 0x8F, 0x41, 0x8A, 0x40, 0x83, 0x41, 0x83, 0x40, 0x84, 0x4D,
+  0x84, 0x4B, 0x85, 0x4B, 0x85, 0x4B, 0x85, 0x43, 0x83, 0x43, 0x82, 0x46,
+  0x83, 0x4D, 0x83, 0x46, 0x82, 0x43, 0x83, 0x43, 0x85, 0x4B, 0x85, 0x4B,
+  0x85, 0x4B, 0x84, 0x4D, 0x84, 0x40, 0x83, 0x41, 0x83, 0x40, 0x8A, 0x41,
+  0x8F, 0x41, 0x87
+};
+
+// Glühbirne (24x24, 77 Byte statt 1152 Byte RGB565)
+//   |........................|
+//   |...........##...........|
+//   |........########........|
+//   |.......####..####.......|
+//   |......###......###......|
+//   |.....###........###.....|
+//   |.....##..........##.....|
+//   |.....##..........##.....|
+//   |....##............##....|
+//   |....##............##....|
+//   |.....##..........##.....|
+//   |.....##..........##.....|
+//   |.....###........###.....|
+//   |......###......###......|
+//   |........#......#........|
+//   |........#......#........|
+//   |........#......#........|
+//   |........########........|
+//   |........#......#........|
+//   |........########........|
+//   |........#......#........|
+//   |........########........|
+//   |..........####..........|
+//   |........................|
+const uint8_t ICON_LIGHT_RLE[] PROGMEM = {
+  0x22, 0x41, 0x12, 0x47, 0x0E, 0x43, 0x01, 0x43, 0x0C, 0x42, 0x05, 0x42,
+  0x0A, 0x42, 0x07, 0x42, 0x09, 0x41, 0x09, 0x41, 0x09, 0x41, 0x09, 0x41,
+  0x08, 0x41, 0x0B, 0x41, 0x07, 0x41, 0x0B, 0x41, 0x08, 0x41, 0x09, 0x41,
+  0x09, 0x41, 0x09, 0x41, 0x09, 0x42, 0x07, 0x42, 0x0A, 0x42, 0x05, 0x42,
+  0x0D, 0x40, 0x05, 0x40, 0x0F, 0x40, 0x05, 0x40, 0x0F, 0x40, 0x05, 0x40,
+  0x0F, 0x47, 0x0F, 0x40, 0x05, 0x40, 0x0F, 0x47, 0x0F, 0x40, 0x05, 0x40,
+  0x0F, 0x47, 0x11, 0x43, 0x21
+};
+
+// Haus mit Rollladen (24x24, 89 Byte statt 1152 Byte RGB565)
+//   |........................|
+//   |..........####..........|
+//   |.........##..##.........|
+//   |........##....##........|
+//   |.......##......##.......|
+//   |.....###........###.....|
+//   |....##............##....|
+//   |...##..............##...|
+//   |..##................##..|
+//   |#####..............#####|
+//   |...##..............##...|
+//   |...##..............##...|
+//   |...##.############.##...|
+//   |...##..............##...|
+//   |...##..............##...|
+//   |...##.############.##...|
+//   |...##..............##...|
+//   |...##..............##...|
+//   |...##.############.##...|
+//   |...##..............##...|
+//   |...##..............##...|
+//   |...##################...|
+//   |...##################...|
+//   |........................|
+const uint8_t ICON_SHUTTER_RLE[] PROGMEM = {
+  0x21, 0x43, 0x12, 0x41, 0x01, 0x41, 0x10, 0x41, 0x03, 0x41, 0x0E, 0x41,
+  0x05, 0x41, 0x0B, 0x42, 0x07, 0x42, 0x08, 0x41, 0x0B, 0x41, 0x06, 0x41,
+  0x0D, 0x41, 0x04, 0x41, 0x0F, 0x41, 0x01, 0x44, 0x0D, 0x44, 0x02, 0x41,
+  0x0D, 0x41, 0x05, 0x41, 0x0D, 0x41, 0x05, 0x41, 0x00, 0x4B, 0x00, 0x41,
+  0x05, 0x41, 0x0D, 0x41, 0x05, 0x41, 0x0D, 0x41, 0x05, 0x41, 0x00, 0x4B,
+  0x00, 0x41, 0x05, 0x41, 0x0D, 0x41, 0x05, 0x41, 0x0D, 0x41, 0x05, 0x41,
+  0x00, 0x4B, 0x00, 0x41, 0x05, 0x41, 0x0D, 0x41, 0x05, 0x41, 0x0D, 0x41,
+  0x05, 0x51, 0x05, 0x51, 0x1A
+};
+
+// Taster (24x24, 101 Byte statt 1152 Byte RGB565)
+//   |........................|
+//   |...........##...........|
+//   |.......##########.......|
+//   |......#####..#####......|
+//   |.....###........###.....|
+//   |....##............##....|
+//   |...##..............##...|
+//   |..###......##......###..|
+//   |..##.....######.....##..|
+//   |..##....########....##..|
+//   |..##....########....##..|
+//   |.##....##########....##.|
+//   |.##....##########....##.|
+//   |..##....########....##..|
+//   |..##....########....##..|
+//   |..##.....######.....##..|
+//   |..###......##......###..|
+//   |...##..............##...|
+//   |....##............##....|
+//   |.....###........###.....|
+//   |......#####..#####......|
+//   |.......##########.......|
+//   |...........##...........|
+//   |........................|
+const uint8_t ICON_SWITCH_RLE[] PROGMEM = {
+  0x22, 0x41, 0x11, 0x49, 0x0C, 0x44, 0x01, 0x44, 0x0A, 0x42, 0x07, 0x42,
+  0x08, 0x41, 0x0B, 0x41, 0x06, 0x41, 0x0D, 0x41, 0x04, 0x42, 0x05, 0x41,
+  0x05, 0x42, 0x03, 0x41, 0x04, 0x45, 0x04, 0x41, 0x03, 0x41, 0x03, 0x47,
+  0x03, 0x41, 0x03, 0x41, 0x03, 0x47, 0x03, 0x41, 0x02, 0x41, 0x03, 0x49,
+  0x03, 0x41, 0x01, 0x41, 0x03, 0x49, 0x03, 0x41, 0x02, 0x41, 0x03, 0x47,
+  0x03, 0x41, 0x03, 0x41, 0x03, 0x47, 0x03, 0x41, 0x03, 0x41, 0x04, 0x45,
+  0x04, 0x41, 0x03, 0x42, 0x05, 0x41, 0x05, 0x42, 0x04, 0x41, 0x0D, 0x41,
+  0x06, 0x41, 0x0B, 0x41, 0x08, 0x42, 0x07, 0x42, 0x0A, 0x44, 0x01, 0x44,
+  0x0C, 0x49, 0x11, 0x41, 0x22
+};
+
+// Sonne (24x24, 77 Byte statt 1152 Byte RGB565)
+//   |........................|
+//   |...........##...........|
+//   |...........##...........|
+//   |...........##...........|
+//   |....##.....##.....##....|
+//   |....###..........###....|
+//   |.....###........###.....|
+//   |......#...####...#......|
+//   |.........######.........|
+//   |........########........|
+//   |.......##########.......|
+//   |.####..##########..####.|
+//   |.####..##########..####.|
+//   |.......##########.......|
+//   |........########........|
+//   |.........######.........|
+//   |......#...####...#......|
+//   |.....###........###.....|
+//   |....###..........###....|
+//   |....##.....##.....##....|
+//   |...........##...........|
+//   |...........##...........|
+//   |...........##...........|
+//   |........................|
+const uint8_t ICON_DIMMER_RLE[] PROGMEM = {
+  0x22, 0x41, 0x15, 0x41, 0x15, 0x41, 0x0E, 0x41, 0x04, 0x41, 0x04, 0x41,
+  0x07, 0x42, 0x09, 0x42, 0x08, 0x42, 0x07, 0x42, 0x0A, 0x40, 0x02, 0x43,
+  0x02, 0x40, 0x0E, 0x45, 0x10, 0x47, 0x0E, 0x49, 0x07, 0x43, 0x01, 0x49,
+  0x01, 0x43, 0x01, 0x43, 0x01, 0x49, 0x01, 0x43, 0x07, 0x49, 0x0E, 0x47,
+  0x10, 0x45, 0x0E, 0x40, 0x02, 0x43, 0x02, 0x40, 0x0A, 0x42, 0x07, 0x42,
+  0x08, 0x42, 0x09, 0x42, 0x07, 0x41, 0x04, 0x41, 0x04, 0x41, 0x0E, 0x41,
+  0x15, 0x41, 0x15, 0x41, 0x22
+};
+
+// Thermometer (24x24, 93 Byte statt 1152 Byte RGB565)
+//   |........................|
+//   |.........######.........|
+//   |.........#....#.........|
+//   |.........#....#.........|
+//   |.........#....#.##......|
+//   |.........#....#.........|
+//   |.........#....#.........|
+//   |.........#.##.#.##......|
+//   |.........#.##.#.........|
+//   |.........#.##.#.........|
+//   |.........#.##.#.##......|
+//   |.........#.##.#.........|
+//   |.........#.##.#.........|
+//   |.........#.##.#.........|
+//   |.........#.##.#.........|
+//   |.........######.........|
+//   |........########........|
+//   |........########........|
+//   |........########........|
+//   |........########........|
+//   |........########........|
+//   |.........######.........|
+//   |...........##...........|
+//   |........................|
+const uint8_t ICON_TEMPERATURE_RLE[] PROGMEM = {
+  0x20, 0x45, 0x11, 0x40, 0x03, 0x40, 0x11, 0x40, 0x03, 0x40, 0x11, 0x40,
+  0x03, 0x40, 0x00, 0x41, 0x0E, 0x40, 0x03, 0x40, 0x11, 0x40, 0x03, 0x40,
+  0x11, 0x40, 0x00, 0x41, 0x00, 0x40, 0x00, 0x41, 0x0E, 0x40, 0x00, 0x41,
+  0x00, 0x40, 0x11, 0x40, 0x00, 0x41, 0x00, 0x40, 0x11, 0x40, 0x00, 0x41,
+  0x00, 0x40, 0x00, 0x41, 0x0E, 0x40, 0x00, 0x41, 0x00, 0x40, 0x11, 0x40,
+  0x00, 0x41, 0x00, 0x40, 0x11, 0x40, 0x00, 0x41, 0x00, 0x40, 0x11, 0x40,
+  0x00, 0x41, 0x00, 0x40, 0x11, 0x45, 0x10, 0x47, 0x0F, 0x47, 0x0F, 0x47,
+  0x0F, 0x47, 0x0F, 0x47, 0x10, 0x45, 0x13, 0x41, 0x22
+};
+
+// Lüfter (24x24, 55 Byte statt 1152 Byte RGB565)
+//   |........................|
+//   |............###.........|
+//   |............#####.......|
+//   |............#######.....|
+//   |............######......|
+//   |............#####.......|
+//   |............#####.......|
+//   |............####........|
+//   |............###.........|
+//   |........................|
+//   |.##.......####..........|
+//   |.########.####..........|
+//   |.########.####..........|
+//   |.########.####..........|
+//   |.#######......##........|
+//   |..####.......#####......|
+//   |..##..........######....|
+//   |..............#######...|
+//   |..............#######...|
+//   |...............#####....|
+//   |...............####.....|
+//   |...............##.......|
+//   |........................|
+//   |........................|
+const uint8_t ICON_VENTILATION_RLE[] PROGMEM = {
+  0x23, 0x42, 0x14, 0x44, 0x12, 0x46, 0x10, 0x45, 0x11, 0x44, 0x12, 0x44,
+  0x12, 0x43, 0x13, 0x42, 0x21, 0x41, 0x06, 0x43, 0x0A, 0x47, 0x00, 0x43,
+  0x0A, 0x47, 0x00, 0x43, 0x0A, 0x47, 0x00, 0x43, 0x0A, 0x46, 0x05, 0x41,
+  0x09, 0x43, 0x06, 0x44, 0x07, 0x41, 0x09, 0x45, 0x11, 0x46, 0x10, 0x46,
+  0x11, 0x44, 0x12, 0x43, 0x13, 0x41, 0x36
+};
+
+#endif // ICON_DATA_H
@@ -0,0 +1,110 @@
+#include "icons.h"
+#include "icon_data.h"
+
+struct IconAsset {
+  const char* name;
+  uint8_t w;
+  uint8_t h;
+  uint16_t size;
+  const uint8_t* data;
+};
+
+const IconAsset iconAssets[ICON_COUNT] = {
+  { "GEAR",        18, 18, sizeof(ICON_GEAR_RLE),        ICON_GEAR_RLE },
+  { "LIGHT",       24, 24, sizeof(ICON_LIGHT_RLE),       ICON_LIGHT_RLE },
+  { "SHUTTER",     24, 24, sizeof(ICON_SHUTTER_RLE),     ICON_SHUTTER_RLE },
+  { "SWITCH",      24, 24, sizeof(ICON_SWITCH_RLE),      ICON_SWITCH_RLE },
+  { "DIMMER",      24, 24, sizeof(ICON_DIMMER_RLE),      ICON_DIMMER_RLE },
+  { "TEMPERATURE", 24, 24, sizeof(ICON_TEMPERATURE_RLE), ICON_TEMPERATURE_RLE },
+  { "VENTILATION", 24, 24, sizeof(ICON_VENTILATION_RLE), ICON_VENTILATION_RLE },
+};
+
+// Statistik
+uint32_t iconBlits = 0;
+uint64_t iconBlitTotalUs = 0;
+uint32_t iconBlitMaxUs = 0;
+
+IconId iconFromLabel(const String& label) {
+  String lowerLabel = label;
+  lowerLabel.toLowerCase();
+
+  if (lowerLabel.indexOf("licht") >= 0 || lowerLabel.indexOf("lampe") >= 0) {
+    return ICON_LIGHT;
+  } else if (lowerLabel.indexOf("rollade") >= 0 || lowerLabel.indexOf("rolladen") >= 0) {
+    return ICON_SHUTTER;
+  } else if (lowerLabel.indexOf("heizung") >= 0 || lowerLabel.indexOf("temperatur") >= 0) {
+    return ICON_TEMPERATURE;
+  } else if (lowerLabel.indexOf("lüftung") >= 0 || lowerLabel.indexOf("ventil") >= 0) {
+    return ICON_VENTILATION;
+  } else if (lowerLabel.indexOf("dimmer") >= 0) {
+    return ICON_DIMMER;
+  }
+  return ICON_SWITCH;
+}
+
+const char* iconTypeName(IconId icon) {
+  if (icon < 0 || icon >= ICON_COUNT) {
+    return "NONE";
+  }
+  return iconAssets[icon].name;
+}
+
+int iconWidth(IconId icon) {
+  return (icon >= 0 && icon < ICON_COUNT) ? iconAssets[icon].w : 0;
+}
+
+int iconHeight(IconId icon) {
+  return (icon >= 0 && icon < ICON_COUNT) ? iconAssets[icon].h : 0;
+}
+
+void iconBlit(TFT_eSPI& gfx, IconId icon, int x, int y, uint16_t color,
+              uint16_t bgColor, uint16_t accentColor) {
+  if (icon < 0 || icon >= ICON_COUNT) {
+    return;
+  }
+  uint32_t startUs = micros();
+  const IconAsset& asset = iconAssets[icon];
+  const uint16_t palette[4] = { 0, color, bgColor, accentColor };
+
+  // Lauf für Lauf dekodieren - jeder Lauf wird zeilenweise als waagrechte Linie gezeichnet
+  int px = 0;
+  int py = 0;
+  for (uint16_t i = 0; i < asset.size && py < asset.h; i++) {
+    uint8_t code = pgm_read_byte(&asset.data[i]);
+    uint8_t index = code >> 6;
+    int run = (code & 0x3F) + 1;
+
+    while (run > 0 && py < asset.h) {
+      int n = min(run, asset.w - px);
+      if (index != 0) {
+        gfx.drawFastHLine(x + px, y + py, n, palette[index]);
+      }
+      px += n;
+      run -= n;
+      if (px >= asset.w) {
+        px = 0;
+        py++;
+      }
+    }
+  }
+
+  uint32_t us = micros() - startUs;
+  iconBlits++;
+  iconBlitTotalUs += us;
+  if (us > iconBlitMaxUs) {
+    iconBlitMaxUs = us;
+  }
+}
+
+void getIconStats(JsonObject obj) {
+  uint32_t flashBytes = 0;
+  for (int i = 0; i < ICON_COUNT; i++) {
+    flashBytes += iconAssets[i].size;
+  }
+  obj["enabled"] = BUTTON_ICONS == 1;
+  obj["icons"] = ICON_COUNT;
+  obj["flashBytes"] = flashBytes;
+  obj["blits"] = iconBlits;
+  obj["blitAvgUs"] = iconBlits > 0 ? (uint32_t)(iconBlitTotalUs / iconBlits) : 0;
+  obj["blitMaxUs"] = iconBlitMaxUs;
+}
@@ -0,0 +1,48 @@
+/**
+ * icons.h - Icons für Buttons und Header (RLE im Flash)
+ *
+ * Die Icons liegen vorberechnet als lauflängenkodierte Palettenbilder im
+ * Flash (icon_data.h). iconBlit() dekodiert Lauf für Lauf direkt als
+ * waagrechte Linien in das Ziel - im Band-Sprite ist das ein Speicherfüllen,
+ * das Band geht danach per DMA an das Display. Keine Trigonometrie, keine
+ * Kreise, kein Zwischenpuffer.
+ */
+#ifndef ICONS_H
+#define ICONS_H
+
+#include "config.h"
+
+enum IconId {
+  ICON_NONE = -1,
+  ICON_GEAR = 0,      // Service-Zahnrad im Header (18x18)
+  ICON_LIGHT,         // Button-Icons (24x24) - Typen wie im Web-Interface
+  ICON_SHUTTER,
+  ICON_SWITCH,
+  ICON_DIMMER,
+  ICON_TEMPERATURE,
+  ICON_VENTILATION,
+  ICON_COUNT
+};
+
+// Icon-Typ aus der Beschriftung (wie getIconTypeFromLabel im Web-Interface)
+IconId iconFromLabel(const String& label);
+
+// Name des Icon-Typs ("LIGHT", "SHUTTER", ...) für Web-API und Konfiguration
+const char* iconTypeName(IconId icon);
+
+// Breite/Höhe eines Icons
+int iconWidth(IconId icon);
+int iconHeight(IconId icon);
+
+/**
+ * Zeichnet ein Icon an (x, y) auf gfx (Display oder Band-Sprite)
+ * color: Symbolfarbe, bgColor: Hintergrund (nur bei Icons mit Index 2),
+ * accentColor: Akzent (Index 3). Index 0 bleibt transparent.
+ */
+void iconBlit(TFT_eSPI& gfx, IconId icon, int x, int y, uint16_t color,
+              uint16_t bgColor = TFT_BLACK, uint16_t accentColor = TFT_WHITE);
+
+// Anzahl und Zeit der Icon-Ausgaben, Flash-Größe als JSON (für /api/status)
+void getIconStats(JsonObject obj);
+
+#endif // ICONS_H
@@ -0,0 +1,222 @@
+#include "idle_manager.h"
+#include "communication.h"
+#include "touch.h"
+#include "timer_wheel.h"
+#include "service_manager.h"
+#include "cpu_freq.h"
+#include "backlight.h"
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+
+// Weck-Quellen
+enum IdleWakeSource : uint8_t {
+  WAKE_NONE = 0,
+  WAKE_TIMER,     // Frist der nächsten Timer-Rad-Aufgabe
+  WAKE_RX,        // RS485-Empfang
+  WAKE_TOUCH,     // Touch-IRQ
+  WAKE_TASK,      // Anderer Task (z.B. Telegramm vom Web-Server)
+  WAKE_SOURCE_COUNT
+};
+
+const char* idleWakeSourceNames[WAKE_SOURCE_COUNT] = {
+  "none", "timer", "rx", "touch", "task"
+};
+
+// Weck-Latenz pro Quelle (Ereignis → loop() läuft wieder)
+struct IdleWakeStats {
+  uint32_t count;
+  uint64_t totalUs;
+  uint32_t maxUs;
+};
+
+IdleWakeStats idleWakeStats[WAKE_SOURCE_COUNT];
+
+TaskHandle_t idleLoopTask = nullptr;
+
+// Vom Weck-Ereignis gesetzt (ISR / UART-Task / Web-Task)
+volatile bool idleSleeping = false;
+volatile IdleWakeSource idleWakeSource = WAKE_NONE;
+volatile uint32_t idleWakeEventUs = 0;
+
+// Zeitanteile seit dem Start
+uint32_t idleStatsStartMs = 0;
+uint64_t idleWaitUs = 0;
+uint64_t idleLightSleepUs = 0;
+uint32_t idleWaits = 0;
+uint32_t idleLightSleeps = 0;
+
+// Erstes Weck-Ereignis während des Wartens festhalten
+static inline void IRAM_ATTR markWakeEvent(IdleWakeSource source) {
+  if (idleSleeping && idleWakeSource == WAKE_NONE) {
+    idleWakeEventUs = micros();
+    idleWakeSource = source;
+  }
+}
+
+// Touch-IRQ: ersetzt die ISR der XPT2046-Bibliothek und setzt deren Flag selbst
+void IRAM_ATTR onTouchIrq() {
+  touchscreen.isrWake = true;
+  markWakeEvent(WAKE_TOUCH);
+
+  BaseType_t higherPriorityWoken = pdFALSE;
+  if (idleLoopTask != nullptr) {
+    vTaskNotifyGiveFromISR(idleLoopTask, &higherPriorityWoken);
+  }
+  portYIELD_FROM_ISR(higherPriorityWoken);
+}
+
+void idleWakeFromTask() {
+  if (idleLoopTask != nullptr) {
+    markWakeEvent(WAKE_TASK);
+    xTaskNotifyGive(idleLoopTask);
+  }
+}
+
+bool idleIsLoopTask() {
+  return idleLoopTask == nullptr || xTaskGetCurrentTaskHandle() == idleLoopTask;
+}
+
+void recordWake(IdleWakeSource source, uint32_t latencyUs) {
+  IdleWakeStats& stats = idleWakeStats[source];
+  stats.count++;
+  stats.totalUs += latencyUs;
+  if (latencyUs > stats.maxUs) {
+    stats.maxUs = latencyUs;
+  }
+
+  // RX-Latenz zusätzlich pro CPU-Takt (Nachweis für 80 MHz)
+  if (source == WAKE_RX) {
+    cpuFreqRecordRxWakeLatency(latencyUs);
+  }
+}
+
+void setupIdleManager() {
+  // setup() läuft im Loop-Task
+  idleLoopTask = xTaskGetCurrentTaskHandle();
+  idleStatsStartMs = millis();
+
+  #if IDLE_ENABLED == 1
+    // RS485: jedes Byte sofort melden statt erst bei vollem FIFO / Pause
+    RS485Serial.setRxFIFOFull(IDLE_RX_FIFO_THRESHOLD);
+    RS485Serial.onReceive([]() {
+      markWakeEvent(WAKE_RX);
+      xTaskNotifyGive(idleLoopTask);
+    });
+
+    // Touch-IRQ (fallende Flanke wie in der Bibliothek)
+    attachInterrupt(digitalPinToInterrupt(XPT2046_IRQ), onTouchIrq, FALLING);
+
+    Serial.println("Leerlauf-Verwaltung aktiv (Weckquellen: RS485, Touch, Timer-Rad)");
+  #endif
+}
+
+#if IDLE_LIGHT_SLEEP == 1
+// Light Sleep bis zur Frist oder bis RX-/Touch-Pin auf LOW geht.
+// Achtung: UART2 kann nicht selbst wecken - das erste Byte (Startbyte)
+// eines Telegramms geht dabei verloren.
+void idleLightSleep(unsigned long waitMs) {
+  esp_sleep_enable_timer_wakeup(waitMs * 1000ULL);
+  gpio_wakeup_enable((gpio_num_t)XPT2046_IRQ, GPIO_INTR_LOW_LEVEL);
+  gpio_wakeup_enable((gpio_num_t)UART_RX_PIN, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+
+  uint32_t startUs = micros();
+  esp_light_sleep_start();
+  idleLightSleepUs += micros() - startUs;
+  idleLightSleeps++;
+
+  // Wake-Konfiguration zurücknehmen, Flanken-Interrupt des Touch-IRQ wiederherstellen
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  gpio_wakeup_disable((gpio_num_t)XPT2046_IRQ);
+  gpio_wakeup_disable((gpio_num_t)UART_RX_PIN);
+  gpio_set_intr_type((gpio_num_t)XPT2046_IRQ, GPIO_INTR_NEGEDGE);
+
+  if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO) {
+    if (digitalRead(XPT2046_IRQ) == LOW) {
+      // Die Flanke lag im Schlaf - Flag für pollTouch() selbst setzen
+      touchscreen.isrWake = true;
+      idleWakeStats[WAKE_TOUCH].count++;
+    } else {
+      idleWakeStats[WAKE_RX].count++;
+    }
+  } else {
+    idleWakeStats[WAKE_TIMER].count++;
+  }
+}
+#endif
+
+void idleUntilNextEvent() {
+  #if IDLE_ENABLED == 1
+    // Benachrichtigungen aus diesem Durchlauf verwerfen - neue Ereignisse
+    // ab hier wecken sofort wieder
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    if (!isCommunicationIdle() || !isTouchIdle()) {
+      return;
+    }
+
+    unsigned long waitMs = timerWheelNextWakeMs();
+    if (waitMs < IDLE_MIN_SLEEP_MS) {
+      return;
+    }
+    if (waitMs > IDLE_MAX_SLEEP_MS) {
+      waitMs = IDLE_MAX_SLEEP_MS;
+    }
+
+    #if IDLE_LIGHT_SLEEP == 1
+      // Nur bei dunklem Display (LEDC steht im Light Sleep) und ohne WiFi
+      if (waitMs >= IDLE_LIGHT_SLEEP_MIN_MS && isDisplayDark() &&
+          !serviceManager.isWiFiActive()) {
+        idleLightSleep(waitMs);
+        return;
+      }
+    #endif
+
+    idleWakeSource = WAKE_NONE;
+    idleSleeping = true;
+    uint32_t startUs = micros();
+    uint32_t notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+    uint32_t nowUs = micros();
+    idleSleeping = false;
+
+    idleWaitUs += nowUs - startUs;
+    idleWaits++;
+
+    if (notified == 0 || idleWakeSource == WAKE_NONE) {
+      // Frist abgelaufen - Verspätung gegenüber dem geplanten Zeitpunkt
+      int32_t lateUs = (int32_t)(nowUs - startUs - waitMs * 1000UL);
+      recordWake(WAKE_TIMER, lateUs > 0 ? (uint32_t)lateUs : 0);
+    } else {
+      recordWake(idleWakeSource, nowUs - idleWakeEventUs);
+    }
+  #endif
+}
+
+void getIdleStats(JsonObject obj) {
+  uint64_t elapsedUs = (uint64_t)(millis() - idleStatsStartMs) * 1000ULL;
+  uint64_t sleepUs = idleWaitUs + idleLightSleepUs;
+  uint64_t runUs = elapsedUs > sleepUs ? elapsedUs - sleepUs : 0;
+
+  obj["enabled"] = IDLE_ENABLED == 1;
+  obj["waits"] = idleWaits;
+  obj["lightSleeps"] = idleLightSleeps;
+
+  float idlePercent = elapsedUs > 0 ? (idleWaitUs * 100.0f / elapsedUs) : 0;
+  float lightSleepPercent = elapsedUs > 0 ? (idleLightSleepUs * 100.0f / elapsedUs) : 0;
+  obj["idlePercent"] = idlePercent;
+  obj["lightSleepPercent"] = lightSleepPercent;
+
+  // Schätzung nur für den ESP32 (ohne Hintergrundbeleuchtung) aus den Datenblattwerten
+  float runPercent = elapsedUs > 0 ? (runUs * 100.0f / elapsedUs) : 100;
+  obj["estimatedCurrentMa"] = (runPercent * IDLE_CURRENT_RUN_MA +
+                               idlePercent * IDLE_CURRENT_WAIT_MA +
+                               lightSleepPercent * IDLE_CURRENT_LIGHT_SLEEP_MA) / 100.0f;
+
+  JsonObject wake = obj.createNestedObject("wakeLatency");
+  for (int i = WAKE_TIMER; i < WAKE_SOURCE_COUNT; i++) {
+    JsonObject s = wake.createNestedObject(idleWakeSourceNames[i]);
+    s["count"] = idleWakeStats[i].count;
+    s["avgUs"] = idleWakeStats[i].count > 0 ? (uint32_t)(idleWakeStats[i].totalUs / idleWakeStats[i].count) : 0;
+    s["maxUs"] = idleWakeStats[i].maxUs;
+  }
+}
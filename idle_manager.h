@@ -0,0 +1,38 @@
+/**
+ * idle_manager.h - Leerlauf zwischen geplanten Ereignissen (tickless idle)
+ *
+ * Statt die loop() mit 100 % CPU drehen zu lassen, wartet der Loop-Task am Ende
+ * eines Durchlaufs, solange nichts zu tun ist:
+ * - Kein Telegramm im Empfang, Sendepuffer oder Arbeitspuffer
+ * - Kein Finger auf dem Display
+ * - Nächste Aufgabe im Timer-Rad frühestens in IDLE_MIN_SLEEP_MS
+ *
+ * Geweckt wird über eine Task-Notification durch
+ * - RS485-Empfang (HardwareSerial::onReceive)
+ * - Touch-IRQ (Pin 36, eigene ISR statt der ISR der XPT2046-Bibliothek)
+ * - Telegramme aus anderen Tasks (Web-Server → Sendepuffer)
+ * - Ablauf der nächsten Timer-Rad-Frist
+ *
+ * Optional (IDLE_LIGHT_SLEEP) Light Sleep bei dunklem Display und ohne WiFi.
+ */
+#ifndef IDLE_MANAGER_H
+#define IDLE_MANAGER_H
+
+#include "config.h"
+
+// Registriert die Weck-Quellen (nach setupCommunication und setupTouch aufrufen)
+void setupIdleManager();
+
+// Am Ende der loop(): wartet bis zum nächsten Ereignis, wenn nichts zu tun ist
+void idleUntilNextEvent();
+
+// Weckt den Loop-Task aus einem anderen Task (z.B. Web-Server)
+void idleWakeFromTask();
+
+// true, wenn der Aufrufer der Loop-Task ist (vor setupIdleManager(): immer true - setup() läuft im Loop-Task)
+bool idleIsLoopTask();
+
+// Leerlauf-Anteil, Weck-Latenzen pro Quelle und geschätzter Strom als JSON (für /api/status)
+void getIdleStats(JsonObject obj);
+
+#endif // IDLE_MANAGER_H
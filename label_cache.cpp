@@ -0,0 +1,223 @@
+#include "label_cache.h"
+
+// Cache-Eintrag (Schlüssel: Beschriftung und Font)
+struct LabelCacheEntry {
+  bool used;
+  String label;
+  uint8_t font;
+  uint32_t lastUse;
+  LabelBitmap bitmap;
+};
+
+LabelCacheEntry labelCache[LABEL_CACHE_SIZE];
+uint32_t labelCacheUseCounter = 0;
+volatile bool labelCacheClearPending = false;  // Leeren kann aus dem Web-Task kommen
+uint32_t labelCacheClears = 0;
+
+// Statistik
+uint32_t labelCacheHits = 0;
+uint32_t labelCacheMisses = 0;
+uint32_t labelCacheEvictions = 0;
+uint32_t labelCacheFailures = 0;
+uint64_t labelCacheRenderTotalUs = 0;
+uint32_t labelCacheRenderMaxUs = 0;
+uint32_t labelCacheBlits = 0;
+uint64_t labelCacheBlitTotalUs = 0;
+uint32_t labelCacheBlitMaxUs = 0;
+
+// RGB565-Block für labelCacheBlit (wächst mit der größten Maske, nur im Loop-Task benutzt)
+uint16_t* labelBlitBuffer = nullptr;
+size_t labelBlitCapacity = 0;
+
+// Font 2 enthält nur ASCII - Umlaute umschreiben statt sie wegfallen zu lassen
+String labelCacheTransliterate(const String& label) {
+  String text = label;
+  text.replace("ä", "ae");
+  text.replace("ö", "oe");
+  text.replace("ü", "ue");
+  text.replace("Ä", "Ae");
+  text.replace("Ö", "Oe");
+  text.replace("Ü", "Ue");
+  text.replace("ß", "ss");
+  return text;
+}
+
+void labelCacheFree(LabelCacheEntry& entry) {
+  if (entry.bitmap.bits != nullptr) {
+    free(entry.bitmap.bits);
+  }
+  entry.used = false;
+  entry.label = "";
+  entry.bitmap = { 0, 0, nullptr };
+}
+
+// Rendert die Beschriftung in eine 1-Bit-Maske (Sprite mit 1 Bit Farbtiefe)
+bool labelCacheRender(LabelCacheEntry& entry, const String& label, uint8_t font) {
+  uint32_t startUs = micros();
+  String text = labelCacheTransliterate(label);
+
+  // Echte Font-Metriken statt label.length() * 6 (Textgröße 1 wie beim Rendern ins Sprite,
+  // tft kann von anderen Zeichenfunktionen noch eine andere Größe eingestellt haben)
+  tft.setTextSize(1);
+  int w = tft.textWidth(text, font);
+  int h = tft.fontHeight(font);
+  if (w <= 0 || h <= 0) {
+    return false;
+  }
+
+  TFT_eSprite sprite = TFT_eSprite(&tft);
+  sprite.setColorDepth(1);
+  uint8_t* spriteBits = (uint8_t*)sprite.createSprite(w, h);
+  if (spriteBits == nullptr) {
+    return false;
+  }
+  sprite.fillSprite(0);
+  sprite.setTextColor(1);
+  sprite.drawString(text, 0, 0, font);
+
+  size_t size = ((w + 7) / 8) * h;
+  uint8_t* bits = (uint8_t*)malloc(size);
+  if (bits == nullptr) {
+    sprite.deleteSprite();
+    return false;
+  }
+  memcpy(bits, spriteBits, size);
+  sprite.deleteSprite();
+
+  entry.used = true;
+  entry.label = label;
+  entry.font = font;
+  entry.bitmap = { (uint16_t)w, (uint16_t)h, bits };
+
+  uint32_t us = micros() - startUs;
+  labelCacheRenderTotalUs += us;
+  if (us > labelCacheRenderMaxUs) {
+    labelCacheRenderMaxUs = us;
+  }
+  return true;
+}
+
+// Verwirft alle Einträge (nur im Loop-Task - dort werden die Masken benutzt)
+void labelCacheFreeAll() {
+  labelCacheClearPending = false;
+  for (int i = 0; i < LABEL_CACHE_SIZE; i++) {
+    if (labelCache[i].used) {
+      labelCacheFree(labelCache[i]);
+    }
+  }
+  labelCacheClears++;
+
+  #if DB_INFO == 1
+    Serial.println("DEBUG: Label-Cache geleert");
+  #endif
+}
+
+const LabelBitmap* labelCacheGet(const String& label, uint8_t font) {
+  if (labelCacheClearPending) {
+    labelCacheFreeAll();
+  }
+  if (label.length() == 0) {
+    return nullptr;
+  }
+
+  // Treffer suchen, sonst freien oder am längsten unbenutzten Eintrag wählen
+  LabelCacheEntry* victim = &labelCache[0];
+  for (int i = 0; i < LABEL_CACHE_SIZE; i++) {
+    LabelCacheEntry& entry = labelCache[i];
+    if (entry.used && entry.font == font && entry.label == label) {
+      entry.lastUse = ++labelCacheUseCounter;
+      labelCacheHits++;
+      return &entry.bitmap;
+    }
+    if (victim->used && (!entry.used || entry.lastUse < victim->lastUse)) {
+      victim = &entry;
+    }
+  }
+
+  labelCacheMisses++;
+  if (victim->used) {
+    labelCacheEvictions++;
+    labelCacheFree(*victim);
+  }
+  if (!labelCacheRender(*victim, label, font)) {
+    labelCacheFailures++;
+    return nullptr;
+  }
+  victim->lastUse = ++labelCacheUseCounter;
+  return &victim->bitmap;
+}
+
+void labelCacheBlit(TFT_eSPI& gfx, const LabelBitmap* bitmap, int x, int y, uint16_t color, uint16_t bgColor) {
+  uint32_t startUs = micros();
+
+  size_t pixels = (size_t)bitmap->w * bitmap->h;
+  if (pixels > labelBlitCapacity) {
+    uint16_t* buffer = (uint16_t*)realloc(labelBlitBuffer, pixels * sizeof(uint16_t));
+    if (buffer == nullptr) {
+      // Kein Speicher - pixelweise (langsam, aber korrekt)
+      gfx.drawBitmap(x, y, bitmap->bits, bitmap->w, bitmap->h, color);
+      return;
+    }
+    labelBlitBuffer = buffer;
+    labelBlitCapacity = pixels;
+  }
+
+  // Maske zu RGB565 erweitern - Byte-Reihenfolge wie im Sprite-Speicher bzw. auf dem Bus
+  uint16_t fg = (color >> 8) | (color << 8);
+  uint16_t bg = (bgColor >> 8) | (bgColor << 8);
+  int stride = (bitmap->w + 7) / 8;
+  uint16_t* out = labelBlitBuffer;
+  for (int row = 0; row < bitmap->h; row++) {
+    const uint8_t* bits = bitmap->bits + row * stride;
+    for (int col = 0; col < bitmap->w; col++) {
+      *out++ = (bits[col >> 3] & (0x80 >> (col & 7))) ? fg : bg;
+    }
+  }
+
+  // Als ein Block übertragen: auf dem Display ein Adressfenster und ein Pixel-Burst
+  // (statt drawBitmap mit einer Transaktion pro Pixel), im Band-Sprite ein Kopiervorgang.
+  // pushImage ist nicht virtuell - jedes gfx außer tft ist ein Sprite des Compositors.
+  if (&gfx == &tft) {
+    tft.pushImage(x, y, bitmap->w, bitmap->h, labelBlitBuffer);
+  } else {
+    static_cast<TFT_eSprite&>(gfx).pushImage(x, y, bitmap->w, bitmap->h, labelBlitBuffer);
+  }
+
+  uint32_t us = micros() - startUs;
+  labelCacheBlits++;
+  labelCacheBlitTotalUs += us;
+  if (us > labelCacheBlitMaxUs) {
+    labelCacheBlitMaxUs = us;
+  }
+}
+
+void labelCacheClear() {
+  // Beim nächsten Zeichnen verwerfen - eine Maske kann gerade benutzt werden
+  labelCacheClearPending = true;
+}
+
+void getLabelCacheStats(JsonObject obj) {
+  int entries = 0;
+  uint32_t bytes = 0;
+  for (int i = 0; i < LABEL_CACHE_SIZE; i++) {
+    if (labelCache[i].used) {
+      entries++;
+      bytes += ((labelCache[i].bitmap.w + 7) / 8) * labelCache[i].bitmap.h;
+    }
+  }
+
+  obj["entries"] = entries;
+  obj["capacity"] = LABEL_CACHE_SIZE;
+  obj["bytes"] = bytes;
+  obj["hits"] = labelCacheHits;
+  obj["misses"] = labelCacheMisses;
+  obj["evictions"] = labelCacheEvictions;
+  obj["failures"] = labelCacheFailures;
+  obj["clears"] = labelCacheClears;
+  uint32_t renders = labelCacheMisses - labelCacheFailures;
+  obj["renderAvgUs"] = renders > 0 ? (uint32_t)(labelCacheRenderTotalUs / renders) : 0;
+  obj["renderMaxUs"] = labelCacheRenderMaxUs;
+  obj["blits"] = labelCacheBlits;
+  obj["blitAvgUs"] = labelCacheBlits > 0 ? (uint32_t)(labelCacheBlitTotalUs / labelCacheBlits) : 0;
+  obj["blitMaxUs"] = labelCacheBlitMaxUs;
+}
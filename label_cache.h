@@ -0,0 +1,39 @@
+/**
+ * label_cache.h - Vorgerenderte Button-Beschriftungen
+ *
+ * Jede Beschriftung wird einmal mit den echten Font-Metriken (textWidth,
+ * fontHeight) in eine 1-Bit-Maske gerendert und zwischengespeichert.
+ * Beim Neuzeichnen wird die Maske zu einem RGB565-Block (Textfarbe auf Button-Farbe)
+ * erweitert und in einem Stück übertragen -
+ * die Maske ist farbunabhängig, ein Farbwechsel (LED-Telegramm) trifft den Cache.
+ *
+ * Umlaute (UTF-8) haben in Font 2 keine Glyphen und werden als ae/oe/ue/ss
+ * dargestellt. Der Cache wird geleert, wenn neue Beschriftungen übernommen
+ * werden (ConverterWebService::applyButtonsToDisplay).
+ */
+#ifndef LABEL_CACHE_H
+#define LABEL_CACHE_H
+
+#include "config.h"
+
+// Gerenderte Beschriftung (1 Bit pro Pixel, Zeilen auf Byte aufgerundet, MSB links)
+struct LabelBitmap {
+  uint16_t w;
+  uint16_t h;
+  uint8_t* bits;
+};
+
+// Maske aus dem Cache, bei Fehlschlag neu gerendert (nullptr bei leerem Text / kein Speicher)
+const LabelBitmap* labelCacheGet(const String& label, uint8_t font);
+
+// Zeichnet die Maske in color auf bgColor an (x, y) auf gfx (Display oder Sprite des Compositors)
+// Deckend: der ganze Block wird in einem Stück übertragen
+void labelCacheBlit(TFT_eSPI& gfx, const LabelBitmap* bitmap, int x, int y, uint16_t color, uint16_t bgColor);
+
+// Alle Einträge verwerfen (z.B. nach neuer Button-Konfiguration)
+void labelCacheClear();
+
+// Treffer, Fehlschläge, Speicher und Zeichenzeit als JSON (für /api/status)
+void getLabelCacheStats(JsonObject obj);
+
+#endif // LABEL_CACHE_H
@@ -1,10 +1,15 @@
 #include "led.h"
+#include "timer_wheel.h"
+#include "profiler.h"
 #include "User_Setup.h"
 
 // Globale Variablen für den LED-Status
 unsigned long ledEndTime = 0;
 int currentLedState = 0;  // 0=aus, 1=rot (senden), 2=blau (empfangen)
 
+// *** NEU: Einmal-Aufgabe im Timer-Rad zum Ausschalten der LED ***
+int ledOffTimerId = -1;
+
 // Initialisiert die RGB-LED
 void setupLed() {
   pinMode(LED_RED_PIN, OUTPUT);
@@ -16,6 +21,12 @@ void setupLed() {
   digitalWrite(LED_GREEN_PIN, HIGH);
   digitalWrite(LED_BLUE_PIN, HIGH);
   
+  // LED-Timeout über das Timer-Rad statt Abfrage in loop()
+  ledOffTimerId = timerWheelRegister("ledOff", [](void*) {
+    PROFILE_SCOPE(PROF_LED);
+    ledOff();
+  });
+  
   Serial.println("RGB-LED initialisiert");
 }
 
@@ -39,6 +50,7 @@ void ledSendSignal() {
   // Timer setzen
   ledEndTime = millis() + LED_SEND_DURATION;
   currentLedState = 1;
+  timerWheelStart(ledOffTimerId, LED_SEND_DURATION);
   #if DB_TX_INFO == 1
   Serial.println("LED: Rot (Senden)");
   #endif
@@ -56,6 +68,7 @@ void ledReceiveSignal() {
   // Timer setzen
   ledEndTime = millis() + LED_RECEIVE_DURATION;
   currentLedState = 2;
+  timerWheelStart(ledOffTimerId, LED_RECEIVE_DURATION);
   #if DB_RX_INFO == 1
   Serial.println("LED: Blau (Empfangen)");
   #endif
@@ -17,7 +17,7 @@ void ledSendSignal();
 void ledReceiveSignal();
 
 // Aktualisiert den LED-Status basierend auf Timern
-// Diese Funktion sollte regelmäßig in der loop() aufgerufen werden
+// Das Ausschalten erfolgt über das Timer-Rad, ein Aufruf in loop() ist nicht mehr nötig
 void updateLedStatus();
 
 #endif // LED_H
\ No newline at end of file
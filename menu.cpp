@@ -1,6 +1,11 @@
 #include "menu.h"
 #include "backlight.h"
 #include "header_display.h"
+#include "trace.h"
+#include "stall_monitor.h"
+#include "ui_compositor.h"
+#include "label_cache.h"
+#include "icons.h"
 
 // Button-Variablen
 Button buttons[NUM_BUTTONS];
@@ -10,44 +15,69 @@ int buttonWidth, buttonHeight;
 #define BUTTON_COLOR_INACTIVE TFT_DARKGREY    // Grau bei nicht Betätigung
 #define BUTTON_COLOR_ACTIVE TFT_GREEN         // Grün wenn aktiv/betätigt
 
-// Zeichnet alle Buttons
+// *** NEU: Zeichnen über den Dirty-Rect-Compositor (uiRender() im Loop) ***
+// Markiert alle Buttons als neu zu zeichnen
 void drawButtons() {
-  for (int i = 0; i < NUM_BUTTONS; i++) {
-    // Wähle die richtige Farbe basierend auf dem Button-Status
-    uint16_t buttonColor = buttons[i].isActive ? BUTTON_COLOR_ACTIVE : BUTTON_COLOR_INACTIVE;
-    
-    tft.fillRect(buttons[i].x, buttons[i].y, buttons[i].w, buttons[i].h, buttonColor);
-    tft.drawRect(buttons[i].x, buttons[i].y, buttons[i].w, buttons[i].h, TFT_BLACK);
-    
-    // Zentrieren des Textes
-    int textWidth = buttons[i].label.length() * 6; // Ungefähre Breite
-    int textX = buttons[i].x + (buttons[i].w - textWidth) / 2;
-    int textY = buttons[i].y + (buttons[i].h - 8) / 2;
-    
-    tft.setTextColor(buttons[i].textColor);
-    tft.drawString(buttons[i].label, textX, textY, 2);
-  }
+  uiMarkAllButtonsDirty(true);
 }
 
-// Zeichnet einen einzelnen Button neu (für Statusaktualisierungen)
+// Markiert einen Button - gezeichnet wird nur, wenn sich der Zustand geändert hat
 void redrawButton(int buttonIndex) {
   if (buttonIndex < 0 || buttonIndex >= NUM_BUTTONS) return;
+  uiMarkButtonDirty(buttonIndex);
+}
+
+// Füllfarbe je nach Button-Status
+uint16_t getButtonFillColor(int buttonIndex) {
+  return buttons[buttonIndex].isActive ? BUTTON_COLOR_ACTIVE : BUTTON_COLOR_INACTIVE;
+}
+
+// Zeichnet einen Button auf gfx (vom Compositor aufgerufen - Display oder Band-Sprite)
+void paintButton(int buttonIndex, TFT_eSPI& gfx, int originX, int originY) {
+  if (buttonIndex < 0 || buttonIndex >= NUM_BUTTONS) return;
+  TRACE_SCOPE(TRACE_BUTTON_DRAW);
   
   // Wähle die richtige Farbe basierend auf dem Button-Status
-  uint16_t buttonColor = buttons[buttonIndex].isActive ? BUTTON_COLOR_ACTIVE : BUTTON_COLOR_INACTIVE;
+  uint16_t buttonColor = getButtonFillColor(buttonIndex);
+  int x = buttons[buttonIndex].x - originX;
+  int y = buttons[buttonIndex].y - originY;
     
-  tft.fillRect(buttons[buttonIndex].x, buttons[buttonIndex].y, 
-               buttons[buttonIndex].w, buttons[buttonIndex].h, buttonColor);
-  tft.drawRect(buttons[buttonIndex].x, buttons[buttonIndex].y, 
-               buttons[buttonIndex].w, buttons[buttonIndex].h, TFT_BLACK);
+  gfx.fillRect(x, y, buttons[buttonIndex].w, buttons[buttonIndex].h, buttonColor);
+  
+  // *** GEÄNDERT: Beschriftung aus dem Label-Cache (echte Font-Metriken, einmal gerendert) ***
+  const LabelBitmap* labelBitmap = labelCacheGet(buttons[buttonIndex].label, 2);
+  int labelHeight = labelBitmap != nullptr ? labelBitmap->h : 0;
+  
+  // *** NEU: Icon über der Beschriftung (Typ aus der Beschriftung, wie im Web-Interface) ***
+  IconId icon = ICON_NONE;
+  #if BUTTON_ICONS == 1
+    icon = iconFromLabel(buttons[buttonIndex].label);
+    if (iconHeight(icon) + BUTTON_ICON_GAP + labelHeight > buttons[buttonIndex].h - 4) {
+      icon = ICON_NONE;  // Button zu niedrig - nur Text
+    }
+  #endif
+  
+  // Icon und Text zusammen senkrecht zentrieren
+  int contentHeight = labelHeight;
+  if (icon != ICON_NONE) {
+    contentHeight += iconHeight(icon) + BUTTON_ICON_GAP;
+  }
+  int contentY = y + (buttons[buttonIndex].h - contentHeight) / 2;
   
-  // Zentrieren des Textes
-  int textWidth = buttons[buttonIndex].label.length() * 6; // Ungefähre Breite
-  int textX = buttons[buttonIndex].x + (buttons[buttonIndex].w - textWidth) / 2;
-  int textY = buttons[buttonIndex].y + (buttons[buttonIndex].h - 8) / 2;
+  if (icon != ICON_NONE) {
+    int iconX = x + (buttons[buttonIndex].w - iconWidth(icon)) / 2;
+    iconBlit(gfx, icon, iconX, contentY, buttons[buttonIndex].textColor);
+    contentY += iconHeight(icon) + BUTTON_ICON_GAP;
+  }
+  
+  if (labelBitmap != nullptr) {
+    // Zentrieren des Textes
+    int textX = x + (buttons[buttonIndex].w - labelBitmap->w) / 2;
+    labelCacheBlit(gfx, labelBitmap, textX, contentY, buttons[buttonIndex].textColor, buttonColor);
+  }
   
-  tft.setTextColor(buttons[buttonIndex].textColor);
-  tft.drawString(buttons[buttonIndex].label, textX, textY, 2);
+  // Rahmen zuletzt - eine zu breite Beschriftung (deckender Block) überdeckt ihn nicht
+  gfx.drawRect(x, y, buttons[buttonIndex].w, buttons[buttonIndex].h, TFT_BLACK);
 }
 
 // Setzt den Aktivierungsstatus eines Buttons und zeichnet ihn neu
@@ -101,10 +131,10 @@ int checkButtonPress(int x, int y) {
 void initButtons() {
   // *** DYNAMISCHE Button-Berechnung basierend auf aktueller TFT-Größe ***
   int currentWidth = tft.width();
-  int currentHeight = tft.height();
   int rotation = tft.getRotation();
   
   #if DB_INFO == 1
+    int currentHeight = tft.height();
     Serial.print("DEBUG: initButtons() - TFT-Rotation: ");
     Serial.print(rotation);
     Serial.print(", Größe: ");
@@ -114,11 +144,11 @@ void initButtons() {
   #endif
   
   // *** KORRIGIERTE Header-Offset Berechnung ***
-  int headerOffset = getHeaderOffset();  // Neue Funktion aus header_display.h
   int availableHeight = getAvailableButtonHeight();  // Neue Funktion
   int buttonAreaY = getButtonAreaY();  // Neue Funktion
   
   #if DB_INFO == 1
+    int headerOffset = getHeaderOffset();  // Neue Funktion aus header_display.h
     Serial.print("DEBUG: Header-Offset: ");
     Serial.print(headerOffset);
     Serial.print(", Button-Bereich Y: ");
@@ -208,11 +238,8 @@ void initButtons() {
 
 
 // Zeigt das Hauptmenü an
-void showMenu() {
-  tft.fillScreen(TFT_WHITE);
-  
-  // *** Header zeichnen ***
-  drawHeader();
+void loadMenuButtons() {
+  STALL_PHASE(STALL_PHASE_DRAW);
   
 // *** GEÄNDERT: Buttons aus Converter Service laden ***
   // Statt initButtons() direkt aufzurufen, erst prüfen ob gespeicherte Config existiert
@@ -223,16 +250,28 @@ void showMenu() {
     // Gespeicherte Konfiguration anwenden
     webConverter.applyButtonsToDisplay();
   }
+}
+
+void drawMenuScene() {
+  TRACE_SCOPE(TRACE_MENU_DRAW);
+  STALL_PHASE(STALL_PHASE_DRAW);
   
-  // Zeichne Buttons
-  drawButtons();
+  // *** GEÄNDERT: Ganze Szene (Hintergrund, Header, Buttons) über den Compositor zeichnen ***
+  uiSetSceneVisible(true);
+  uiInvalidateAll();
+  uiRender(true);
   
   #if DB_INFO == 1
-    Serial.print("DEBUG: showMenu() abgeschlossen - TFT-Rotation: ");
+    Serial.print("DEBUG: Menü gezeichnet - TFT-Rotation: ");
     Serial.print(tft.getRotation());
     Serial.print(", Größe: ");
     Serial.print(tft.width());
     Serial.print("x");
     Serial.println(tft.height());
   #endif
+}
+
+void showMenu() {
+  loadMenuButtons();
+  drawMenuScene();
 }
\ No newline at end of file
@@ -3,12 +3,19 @@
 
 #include "config.h"
 
-// Zeichnet alle Buttons
+// Markiert alle Buttons zum Neuzeichnen (gezeichnet wird in uiRender())
 void drawButtons();
 
-// Zeichnet einen einzelnen Button neu (für Statusaktualisierungen)
+// Markiert einen Button zum Neuzeichnen (für Statusaktualisierungen, nur bei Änderung)
 void redrawButton(int buttonIndex);
 
+// *** NEU: Zeichnet einen Button auf gfx (Display oder Band-Sprite, nur für den Compositor) ***
+// originX/Y: Bildschirmposition von (0,0) in gfx
+void paintButton(int buttonIndex, TFT_eSPI& gfx = tft, int originX = 0, int originY = 0);
+
+// Füllfarbe eines Buttons je nach Status (aktiv/inaktiv)
+uint16_t getButtonFillColor(int buttonIndex);
+
 // Setzt den Aktivierungsstatus eines Buttons und zeichnet ihn neu
 void setButtonActive(int buttonIndex, bool active);
 
@@ -21,7 +28,13 @@ int checkButtonPress(int x, int y);
 // Initialisiert die Buttons mit ihren Positionen und Farben
 void initButtons();
 
-// Zeigt das Hauptmenü an
+// *** NEU: Lädt die Button-Konfiguration (gespeichert oder Standard), ohne zu zeichnen ***
+void loadMenuButtons();
+
+// *** NEU: Zeichnet die ganze Szene des Hauptmenüs (Hintergrund, Header, Buttons) ***
+void drawMenuScene();
+
+// Zeigt das Hauptmenü an (loadMenuButtons() + drawMenuScene())
 void showMenu();
 
 #endif // MENU_H
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "profiler.h"
+#include "serial_commands.h"
+#include "idle_manager.h"
+
+#if ENABLE_LOOP_PROFILER == 1
+
+// Messwerte eines Abschnitts
+struct ProfilerStats {
+  uint32_t count;
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint64_t totalUs;
+  uint32_t histogram[PROFILER_HIST_BUCKETS];
+};
+
+const char* profilerSectionNames[PROF_SECTION_COUNT] = {
+  "loop", "timerWheel", "rxParse", "rxExec", "sendQueue",
+  "header", "service", "buttonTiming", "led", "touch", "render"
+};
+
+ProfilerStats profilerStats[PROF_SECTION_COUNT];
+unsigned long profilerStartTime = 0;
+uint32_t profilerCpuMhz = 240;
+volatile bool profilerResetPending = false;  // Reset aus dem Web-Task, ausgeführt im Loop
+
+void resetProfiler() {
+  memset(profilerStats, 0, sizeof(profilerStats));
+  for (int i = 0; i < PROF_SECTION_COUNT; i++) {
+    profilerStats[i].minUs = 0xFFFFFFFFUL;
+  }
+  profilerCpuMhz = getCpuFrequencyMhz();
+  profilerStartTime = millis();
+}
+
+void requestProfilerReset() {
+  profilerResetPending = true;
+  if (!idleIsLoopTask()) {
+    idleWakeFromTask();
+  }
+}
+
+void processProfilerReset() {
+  if (!profilerResetPending) {
+    return;
+  }
+  profilerResetPending = false;
+  resetProfiler();
+}
+
+void profilerCpuFreqChanged() {
+  profilerCpuMhz = getCpuFrequencyMhz();
+}
+
+void profilerRecord(ProfilerSection section, uint32_t cycles) {
+  uint32_t us = cycles / profilerCpuMhz;
+  ProfilerStats& stats = profilerStats[section];
+
+  stats.count++;
+  stats.totalUs += us;
+  if (us < stats.minUs) {
+    stats.minUs = us;
+  }
+  if (us > stats.maxUs) {
+    stats.maxUs = us;
+  }
+
+  // log2-Bucket: 0-1 µs → 0, 2-3 µs → 1, 4-7 µs → 2, ...
+  int bucket = (us > 0) ? (31 - __builtin_clz(us)) : 0;
+  if (bucket >= PROFILER_HIST_BUCKETS) {
+    bucket = PROFILER_HIST_BUCKETS - 1;
+  }
+  stats.histogram[bucket]++;
+}
+
+float getProfilerLoopHz() {
+  unsigned long elapsed = millis() - profilerStartTime;
+  if (elapsed == 0) {
+    return 0;
+  }
+  return profilerStats[PROF_LOOP].count * 1000.0f / elapsed;
+}
+
+void printProfilerStats() {
+  Serial.println("=== Loop-Profiler ===");
+  Serial.print("Loop-Frequenz: ");
+  Serial.print(getProfilerLoopHz(), 1);
+  Serial.println(" Hz");
+  Serial.println("Abschnitt      Anzahl   Min µs   Avg µs   Max µs");
+
+  for (int i = 0; i < PROF_SECTION_COUNT; i++) {
+    ProfilerStats& stats = profilerStats[i];
+    if (stats.count == 0) {
+      continue;
+    }
+    Serial.printf("%-13s %7lu %8lu %8lu %8lu\n",
+                  profilerSectionNames[i],
+                  (unsigned long)stats.count,
+                  (unsigned long)stats.minUs,
+                  (unsigned long)(stats.totalUs / stats.count),
+                  (unsigned long)stats.maxUs);
+
+    // Histogramm nur mit belegten Buckets ausgeben
+    Serial.print("  Histogramm:");
+    for (int b = 0; b < PROFILER_HIST_BUCKETS; b++) {
+      if (stats.histogram[b] > 0) {
+        Serial.printf(" <%lu:%lu", 1UL << (b + 1), (unsigned long)stats.histogram[b]);
+      }
+    }
+    Serial.println();
+  }
+}
+
+void getProfilerStats(JsonObject obj) {
+  obj["enabled"] = true;
+  obj["loopHz"] = getProfilerLoopHz();
+  obj["sinceMs"] = millis() - profilerStartTime;
+
+  JsonArray sections = obj.createNestedArray("sections");
+  for (int i = 0; i < PROF_SECTION_COUNT; i++) {
+    ProfilerStats& stats = profilerStats[i];
+    JsonObject s = sections.createNestedObject();
+    s["name"] = profilerSectionNames[i];
+    s["count"] = stats.count;
+    s["minUs"] = stats.count > 0 ? stats.minUs : 0;
+    s["avgUs"] = stats.count > 0 ? (uint32_t)(stats.totalUs / stats.count) : 0;
+    s["maxUs"] = stats.maxUs;
+
+    // Bucket-Obergrenzen ergeben sich aus dem Index (2^(i+1) µs)
+    JsonArray hist = s.createNestedArray("hist");
+    for (int b = 0; b < PROFILER_HIST_BUCKETS; b++) {
+      hist.add(stats.histogram[b]);
+    }
+  }
+}
+
+void setupProfiler() {
+  resetProfiler();
+  registerSerialCommand("prof", printProfilerStats, "Profiler-Tabelle ausgeben");
+  registerSerialCommand("prof reset", []() {
+    requestProfilerReset();  // Befehle laufen im Timer-Rad (Messabschnitt offen)
+    Serial.println("Profiler zurückgesetzt");
+  }, "Profiler zurücksetzen");
+  Serial.println("Loop-Profiler aktiv (Serial: 'prof', 'prof reset')");
+}
+
+#else
+
+// Profiler nicht einkompiliert - leere Implementierungen für Web-API und Setup
+void setupProfiler() {}
+void profilerRecord(ProfilerSection section, uint32_t cycles) {}
+void resetProfiler() {}
+void requestProfilerReset() {}
+void processProfilerReset() {}
+void profilerCpuFreqChanged() {}
+void printProfilerStats() {}
+void getProfilerStats(JsonObject obj) {
+  obj["enabled"] = false;
+}
+
+#endif
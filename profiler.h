@@ -0,0 +1,77 @@
+/**
+ * profiler.h - Loop-Profiler mit Laufzeit-Histogrammen pro Teilsystem
+ *
+ * Misst mit dem CPU-Zykluszähler die Laufzeit einzelner Abschnitte der loop():
+ * - Min / Mittel / Max pro Abschnitt
+ * - log2-Histogramm der Laufzeit (Bucket i = 2^i .. 2^(i+1)-1 µs)
+ * - Loop-Frequenz gesamt
+ *
+ * Messpunkte werden nur mit ENABLE_LOOP_PROFILER == 1 einkompiliert (config.h).
+ * Ausgabe über Serial ("prof", "prof reset") und /api/status, Reset über
+ * POST /api/profiler/reset.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+
+// Gemessene Abschnitte
+enum ProfilerSection {
+  PROF_LOOP = 0,        // Kompletter loop()-Durchlauf
+  PROF_TIMER_WHEEL,     // timerWheelDispatch() gesamt
+  PROF_RX_PARSE,        // Empfang und Zerlegung (processIncomingTelegrams)
+  PROF_RX_EXEC,         // Ausführung empfangener Telegramme (processRxWorkQueue)
+  PROF_SEND_QUEUE,      // Sendepuffer (processSendQueue)
+  PROF_HEADER,          // Header-Uhr (updateHeaderTime)
+  PROF_SERVICE,         // Service-Manager (updateServiceManager)
+  PROF_BUTTON_TIMING,   // Button-Bestätigung / Timeout
+  PROF_LED,             // LED-Timeout
+  PROF_TOUCH,           // Touch-Abfrage und -Verarbeitung
+  PROF_RENDER,          // Zeichnen markierter Bereiche (uiRender)
+  PROF_SECTION_COUNT
+};
+
+// Initialisiert den Profiler und registriert die Serial-Abfrage im Timer-Rad
+void setupProfiler();
+
+// Trägt eine gemessene Laufzeit (in CPU-Zyklen) ein
+void profilerRecord(ProfilerSection section, uint32_t cycles);
+
+// Setzt alle Messwerte zurück (nur im Loop-Task, außerhalb der Messabschnitte)
+void resetProfiler();
+
+// *** NEU: Reset aus einem anderen Task (Web) vormerken - ausgeführt im Loop-Task ***
+void requestProfilerReset();
+
+// Vorgemerkten Reset ausführen (am Anfang von loop(), vor dem ersten Messabschnitt)
+void processProfilerReset();
+
+// CPU-Takt wurde geändert - Zyklen ab jetzt mit dem neuen Takt umrechnen
+// (nur zwischen zwei Messabschnitten aufrufen)
+void profilerCpuFreqChanged();
+
+// Gibt die Messwerte als Tabelle auf Serial aus
+void printProfilerStats();
+
+// Schreibt Loop-Frequenz und Abschnitte in ein JSON-Objekt (für /api/status)
+void getProfilerStats(JsonObject obj);
+
+#if ENABLE_LOOP_PROFILER == 1
+// Misst die Laufzeit vom Konstruktor bis zum Verlassen des Blocks
+class ProfilerScope {
+public:
+  explicit ProfilerScope(ProfilerSection section)
+    : section(section), startCycles(ESP.getCycleCount()) {}
+  ~ProfilerScope() { profilerRecord(section, ESP.getCycleCount() - startCycles); }
+
+private:
+  ProfilerSection section;
+  uint32_t startCycles;
+};
+
+#define PROFILE_SCOPE(section) ProfilerScope profilerScope(section)
+#else
+#define PROFILE_SCOPE(section)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,152 @@
+#include "report_scheduler.h"
+#include "service_manager.h"
+#include "timer_wheel.h"
+#include "idle_manager.h"
+
+// Eintrag einer periodischen Meldung
+struct PeriodicReport {
+  const char* name;
+  unsigned long periodMs;
+  ReportSendFunc send;
+
+  unsigned long anchorTime;     // Nominaler Zeitpunkt (ohne Jitter)
+  unsigned long nextDueTime;    // Tatsächlicher Zeitpunkt (mit Jitter)
+  unsigned long runCount;
+  int timerId;                  // Einmal-Aufgabe im Timer-Rad
+};
+
+PeriodicReport periodicReports[MAX_PERIODIC_REPORTS];
+int periodicReportCount = 0;
+
+// FNV-1a über die Device ID - gleiche ID ergibt immer die gleiche Phase
+unsigned long getReportPhaseOffset(unsigned long periodMs) {
+  if (periodMs == 0) {
+    return 0;
+  }
+
+  String deviceID = serviceManager.getDeviceID();
+  uint32_t hash = 2166136261UL;
+  for (unsigned int i = 0; i < deviceID.length(); i++) {
+    hash ^= (uint8_t)deviceID[i];
+    hash *= 16777619UL;
+  }
+  return hash % periodMs;
+}
+
+// Zufälliger Versatz ±REPORT_JITTER_PERCENT der Periode
+// random() nutzt auf dem ESP32 den Hardware-Zufallsgenerator, daher
+// laufen auch gleichzeitig gestartete Panels auseinander
+long calculateReportJitter(unsigned long periodMs) {
+  long maxJitter = (long)(periodMs * REPORT_JITTER_PERCENT / 100);
+  if (maxJitter <= 0) {
+    return 0;
+  }
+  return random(-maxJitter, maxJitter + 1);
+}
+
+// Timer-Rad auf den nächsten Zeitpunkt stellen
+void armReportTimer(PeriodicReport& report) {
+  unsigned long now = millis();
+  long delayMs = (long)(report.nextDueTime - now);
+  timerWheelStart(report.timerId, delayMs > 0 ? (unsigned long)delayMs : 0);
+}
+
+// Nächsten Zeitpunkt einer Meldung festlegen
+void scheduleNextReport(PeriodicReport& report) {
+  unsigned long now = millis();
+  report.anchorTime += report.periodMs;
+
+  // Nach langer Blockade nicht mehrere Perioden nachholen
+  if ((long)(now - report.anchorTime) > 0) {
+    report.anchorTime = now + report.periodMs;
+  }
+
+  report.nextDueTime = report.anchorTime + calculateReportJitter(report.periodMs);
+  armReportTimer(report);
+}
+
+// Callback aus dem Timer-Rad - Meldung senden und nächste einplanen
+void onReportTimer(void* context) {
+  PeriodicReport& report = *(PeriodicReport*)context;
+  report.send();
+  report.runCount++;
+  scheduleNextReport(report);
+}
+
+// Erste Meldung nach dem gerätespezifischen Phasenversatz einplanen
+void scheduleFirstReport(PeriodicReport& report) {
+  unsigned long now = millis();
+  report.anchorTime = now + getReportPhaseOffset(report.periodMs);
+  report.nextDueTime = report.anchorTime + calculateReportJitter(report.periodMs);
+
+  // Jitter darf die erste Meldung nicht in die Vergangenheit legen
+  if ((long)(report.nextDueTime - now) < 0) {
+    report.nextDueTime = now;
+  }
+  armReportTimer(report);
+}
+
+int registerPeriodicReport(const char* name, unsigned long periodMs, ReportSendFunc send) {
+  if (periodicReportCount >= MAX_PERIODIC_REPORTS || periodMs == 0 || send == nullptr) {
+    Serial.print("FEHLER: Periodische Meldung konnte nicht registriert werden: ");
+    Serial.println(name);
+    return -1;
+  }
+
+  PeriodicReport& report = periodicReports[periodicReportCount];
+  report.name = name;
+  report.periodMs = periodMs;
+  report.send = send;
+  report.runCount = 0;
+  report.timerId = timerWheelRegister(name, onReportTimer, &report);
+  if (report.timerId < 0) {
+    return -1;
+  }
+  scheduleFirstReport(report);
+
+  #if DB_INFO == 1
+    Serial.print("DEBUG: Periodische Meldung '");
+    Serial.print(name);
+    Serial.print("' registriert, Periode ");
+    Serial.print(periodMs);
+    Serial.print("ms, Phase ");
+    Serial.print(getReportPhaseOffset(periodMs));
+    Serial.println("ms");
+  #endif
+
+  return periodicReportCount++;
+}
+
+void rescheduleAllReports() {
+  for (int i = 0; i < periodicReportCount; i++) {
+    scheduleFirstReport(periodicReports[i]);
+  }
+}
+
+// Device ID kann aus dem Web-Task geändert werden - das Timer-Rad gehört dem Loop-Task
+volatile bool reportReschedulePending = false;
+
+void requestReportReschedule() {
+  reportReschedulePending = true;
+  if (!idleIsLoopTask()) {
+    idleWakeFromTask();
+  }
+}
+
+void processReportReschedule() {
+  if (!reportReschedulePending) {
+    return;
+  }
+  reportReschedulePending = false;
+  rescheduleAllReports();
+}
+
+void getReportSchedulerStats(JsonArray array) {
+  for (int i = 0; i < periodicReportCount; i++) {
+    JsonObject obj = array.createNestedObject();
+    obj["name"] = periodicReports[i].name;
+    obj["periodMs"] = periodicReports[i].periodMs;
+    obj["phaseMs"] = getReportPhaseOffset(periodicReports[i].periodMs);
+    obj["runs"] = periodicReports[i].runCount;
+  }
+}
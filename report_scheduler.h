@@ -0,0 +1,66 @@
+/**
+ * report_scheduler.h - Entkoppelte periodische Statusmeldungen
+ *
+ * Verhindert, dass alle Panels nach einem gemeinsamen Netzausfall ihre
+ * Statusmeldungen im Gleichtakt senden (Kollisionsstürme):
+ * - Phasenversatz pro Gerät, abgeleitet aus der Device ID
+ * - Zufälliger Jitter in jeder Periode
+ *
+ * Die Zeitpunkte werden als Einmal-Aufgaben im Timer-Rad (timer_wheel.h)
+ * eingeplant, es ist kein eigener Aufruf in loop() nötig.
+ *
+ * Unveränderte Werte unterdrückt der Statuswert-Cache in communication.cpp
+ * (sendStatusValue), der Scheduler legt nur die Zeitpunkte fest.
+ */
+#ifndef REPORT_SCHEDULER_H
+#define REPORT_SCHEDULER_H
+
+#include "config.h"
+
+// Sendet die Meldung
+typedef void (*ReportSendFunc)();
+
+/**
+ * Registriert eine periodische Meldung
+ * Die erste Meldung erfolgt nach dem gerätespezifischen Phasenversatz.
+ *
+ * @param name          Name für Statistik/Debug (z.B. "backlight")
+ * @param periodMs      Nominale Periode in Millisekunden
+ * @param send          Sendet die Meldung
+ * @return Index der Meldung oder -1 wenn kein Platz mehr frei ist
+ */
+int registerPeriodicReport(const char* name, unsigned long periodMs, ReportSendFunc send);
+
+/**
+ * Berechnet den Phasenversatz dieses Geräts innerhalb einer Periode
+ * (FNV-1a Hash der Device ID modulo Periode)
+ *
+ * @param periodMs      Periode in Millisekunden
+ * @return Versatz in Millisekunden (0 .. periodMs-1)
+ */
+unsigned long getReportPhaseOffset(unsigned long periodMs);
+
+/**
+ * Plant alle Meldungen neu (z.B. nach Änderung der Device ID)
+ * Nur im Loop-Task aufrufen (Timer-Rad) - aus anderen Tasks requestReportReschedule()
+ */
+void rescheduleAllReports();
+
+/**
+ * Fordert die Neuplanung aus einem beliebigen Task an (z.B. Web-Handler, setDeviceID)
+ * Ausgeführt in processReportReschedule() im Loop-Task
+ */
+void requestReportReschedule();
+
+/**
+ * Führt eine angeforderte Neuplanung aus (in loop() vor timerWheelDispatch())
+ */
+void processReportReschedule();
+
+/**
+ * Schreibt Periode, Phase und Anzahl Auslösungen pro Eintrag in ein JSON-Array
+ * (für /api/status)
+ */
+void getReportSchedulerStats(JsonArray array);
+
+#endif // REPORT_SCHEDULER_H
@@ -0,0 +1,212 @@
+#include "rtc_snapshot.h"
+#include "communication.h"
+#include "header_display.h"
+#include "backlight.h"
+#include "menu.h"
+#include "timer_wheel.h"
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+
+#define RTC_SNAPSHOT_MAGIC 0x534E4150UL  // "SNAP"
+#define RTC_SNAPSHOT_VERSION 1
+
+// Zustand eines Buttons (6 Byte)
+struct RtcButtonState {
+  uint16_t color;
+  uint16_t textColor;
+  uint8_t isActive;
+  uint8_t reserved;
+};
+
+// Schnappschuss im RTC-Speicher - CRC über alles ab "backlight"
+struct RtcSnapshot {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  uint32_t crc;
+  uint8_t backlight;
+  uint8_t hour;
+  uint8_t minute;
+  uint8_t second;
+  uint8_t day;
+  uint8_t month;
+  uint16_t year;
+  RtcButtonState buttons[NUM_BUTTONS];
+};
+
+#define RTC_SNAPSHOT_PAYLOAD_OFFSET offsetof(RtcSnapshot, backlight)
+#define RTC_SNAPSHOT_PAYLOAD_SIZE (sizeof(RtcSnapshot) - RTC_SNAPSHOT_PAYLOAD_OFFSET)
+
+RTC_NOINIT_ATTR RtcSnapshot rtcSnapshot;
+
+// Zustand beim Boot
+bool rtcSnapshotValid = false;
+bool rtcSnapshotRestored = false;
+const char* rtcSnapshotInvalidReason = "";
+esp_reset_reason_t rtcSnapshotResetReason = ESP_RST_UNKNOWN;
+
+// Schreibzugriffe
+int rtcSnapshotTimerId = -1;
+uint32_t rtcSnapshotWrites = 0;
+uint32_t rtcSnapshotChecks = 0;
+unsigned long rtcSnapshotLastWriteMs = 0;
+
+uint32_t rtcSnapshotCrc(const RtcSnapshot& snapshot) {
+  return esp_rom_crc32_le(0, (const uint8_t*)&snapshot + RTC_SNAPSHOT_PAYLOAD_OFFSET,
+                          RTC_SNAPSHOT_PAYLOAD_SIZE);
+}
+
+// Aktuellen Laufzeit-Zustand erfassen
+void rtcSnapshotCapture(RtcSnapshot& snapshot) {
+  memset(&snapshot, 0, sizeof(snapshot));
+  snapshot.magic = RTC_SNAPSHOT_MAGIC;
+  snapshot.version = RTC_SNAPSHOT_VERSION;
+  snapshot.size = sizeof(RtcSnapshot);
+
+  snapshot.backlight = (uint8_t)currentBacklight;
+
+  updateSimulatedTime();
+  snapshot.hour = currentTime.hour;
+  snapshot.minute = currentTime.minute;
+  snapshot.second = currentTime.second;
+  snapshot.day = currentTime.day;
+  snapshot.month = currentTime.month;
+  snapshot.year = currentTime.year;
+
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    RtcButtonState& state = snapshot.buttons[i];
+    uint16_t pendingColor;
+    bool pendingActive;
+    // Noch nicht angewendeter LED-Zustand ist der gültige Zielzustand
+    if (getPendingLedState(i, &pendingColor, &pendingActive)) {
+      state.color = pendingColor;
+      state.isActive = pendingActive;
+    } else {
+      state.color = buttons[i].color;
+      state.isActive = buttons[i].isActive;
+    }
+    state.textColor = buttons[i].textColor;
+  }
+
+  snapshot.crc = rtcSnapshotCrc(snapshot);
+}
+
+// Schreibt nur, wenn sich der Zustand geändert hat
+// Sekunden zählen nicht als Änderung (sonst fast jede Prüfung ein Schreibzugriff):
+// die Uhr wird mit jedem Minutenwechsel und jeder Zustandsänderung mitgeschrieben
+void rtcSnapshotUpdate() {
+  RtcSnapshot next;
+  rtcSnapshotCapture(next);
+  rtcSnapshotChecks++;
+
+  RtcSnapshot compare = next;
+  compare.second = rtcSnapshot.second;
+  compare.crc = rtcSnapshot.crc;
+  if (memcmp(&compare, &rtcSnapshot, sizeof(RtcSnapshot)) == 0) {
+    return;
+  }
+  memcpy(&rtcSnapshot, &next, sizeof(RtcSnapshot));
+  rtcSnapshotWrites++;
+  rtcSnapshotLastWriteMs = millis();
+}
+
+void setupRtcSnapshot() {
+  rtcSnapshotResetReason = esp_reset_reason();
+
+  // Nach dem Einschalten enthält der RTC-Speicher Zufallswerte
+  if (rtcSnapshotResetReason == ESP_RST_POWERON) {
+    rtcSnapshotInvalidReason = "powerOn";
+  } else if (rtcSnapshot.magic != RTC_SNAPSHOT_MAGIC ||
+             rtcSnapshot.version != RTC_SNAPSHOT_VERSION ||
+             rtcSnapshot.size != sizeof(RtcSnapshot)) {
+    rtcSnapshotInvalidReason = "noSnapshot";
+  } else if (rtcSnapshot.crc != rtcSnapshotCrc(rtcSnapshot)) {
+    rtcSnapshotInvalidReason = "crc";
+  } else {
+    rtcSnapshotValid = true;
+  }
+
+  #if ENABLE_RTC_SNAPSHOT == 1
+    rtcSnapshotTimerId = timerWheelRegister("rtcSnapshot", [](void*) { rtcSnapshotUpdate(); });
+  #else
+    rtcSnapshotValid = false;
+    rtcSnapshotInvalidReason = "disabled";
+  #endif
+
+  if (rtcSnapshotValid) {
+    Serial.printf("RTC-Schnappschuss gültig (Reset-Grund %d) - Zustand wird wiederhergestellt\n",
+                  (int)rtcSnapshotResetReason);
+  } else {
+    Serial.printf("Kein RTC-Schnappschuss (%s)\n", rtcSnapshotInvalidReason);
+  }
+}
+
+int getRestoredBacklight(int fallback) {
+  return rtcSnapshotValid ? rtcSnapshot.backlight : fallback;
+}
+
+void restoreRtcSnapshotClock() {
+  if (!rtcSnapshotValid) {
+    return;
+  }
+  // Die Zeit des Neustarts selbst fehlt (typisch < 1 s, bei SYS.RESET ~2 s);
+  // ohne Zustandsänderung sind die Sekunden bis zu einer Minute alt
+  currentTime.hour = rtcSnapshot.hour;
+  currentTime.minute = rtcSnapshot.minute;
+  currentTime.second = rtcSnapshot.second;
+  currentTime.day = rtcSnapshot.day;
+  currentTime.month = rtcSnapshot.month;
+  currentTime.year = rtcSnapshot.year;
+  lastTimeUpdate = millis();
+}
+
+void restoreRtcSnapshotButtons() {
+  if (rtcSnapshotValid) {
+    int restored = 0;
+    for (int i = 0; i < NUM_BUTTONS; i++) {
+      const RtcButtonState& state = rtcSnapshot.buttons[i];
+      if (buttons[i].color == state.color &&
+          buttons[i].textColor == state.textColor &&
+          buttons[i].isActive == (bool)state.isActive) {
+        continue;
+      }
+      buttons[i].color = state.color;
+      buttons[i].textColor = state.textColor;
+      buttons[i].isActive = state.isActive;
+      restored++;
+    }
+    rtcSnapshotRestored = true;
+
+    #if DB_INFO == 1
+      Serial.printf("DEBUG: RTC-Schnappschuss: %d Button(s) wiederhergestellt\n", restored);
+    #endif
+  }
+
+  // Erst ab hier speichern - vorher würden Standardwerte den Schnappschuss überschreiben
+  if (rtcSnapshotTimerId >= 0) {
+    rtcSnapshotUpdate();
+    timerWheelStart(rtcSnapshotTimerId, RTC_SNAPSHOT_INTERVAL, RTC_SNAPSHOT_INTERVAL);
+  }
+}
+
+void saveRtcSnapshot() {
+  #if ENABLE_RTC_SNAPSHOT == 1
+    if (timerWheelIsActive(rtcSnapshotTimerId)) {
+      rtcSnapshotUpdate();
+    }
+  #endif
+}
+
+void getRtcSnapshotStats(JsonObject obj) {
+  obj["enabled"] = ENABLE_RTC_SNAPSHOT == 1;
+  obj["sizeBytes"] = sizeof(RtcSnapshot);
+  obj["resetReason"] = (int)rtcSnapshotResetReason;
+  obj["validAtBoot"] = rtcSnapshotValid;
+  obj["restored"] = rtcSnapshotRestored;
+  if (!rtcSnapshotValid) {
+    obj["invalidReason"] = rtcSnapshotInvalidReason;
+  }
+  obj["checks"] = rtcSnapshotChecks;
+  obj["writes"] = rtcSnapshotWrites;
+  obj["lastWriteAgoMs"] = rtcSnapshotWrites > 0 ? millis() - rtcSnapshotLastWriteMs : 0;
+}
@@ -0,0 +1,42 @@
+/**
+ * rtc_snapshot.h - Laufzeit-Zustand im RTC-Speicher für Warmstarts
+ *
+ * Hält einen kompakten Schnappschuss (CRC32-gesichert) im RTC-Speicher:
+ * - Pro Button: aktiv/inaktiv, Hintergrund- und Textfarbe
+ *   (noch nicht angewendete LED-Zustände werden direkt übernommen)
+ * - Helligkeit der Hintergrundbeleuchtung
+ * - Uhrzeit und Datum des Headers
+ *
+ * Eine Aufgabe im Timer-Rad vergleicht alle RTC_SNAPSHOT_INTERVAL ms und
+ * schreibt nur bei Änderung (Sekunden der Uhr zählen nicht dazu). Nach SYS.RESET, Watchdog-, Absturz- oder
+ * Brownout-Reset wird der Zustand beim Boot ohne Bus-Verkehr wiederhergestellt;
+ * nach dem Einschalten (Power-On) ist der RTC-Speicher ungültig.
+ */
+#ifndef RTC_SNAPSHOT_H
+#define RTC_SNAPSHOT_H
+
+#include "config.h"
+
+// Prüft den Schnappschuss aus dem letzten Boot (früh in setup() aufrufen)
+void setupRtcSnapshot();
+
+// Helligkeit aus dem Schnappschuss, sonst fallback
+int getRestoredBacklight(int fallback);
+
+// Uhrzeit und Datum aus dem Schnappschuss übernehmen (nach setupHeaderDisplay)
+void restoreRtcSnapshotClock();
+
+/**
+ * Button-Zustände aus dem Schnappschuss übernehmen (nach loadMenuButtons(), vor dem
+ * ersten drawMenuScene() - gezeichnet wird gleich der wiederhergestellte Zustand).
+ * Startet danach die Aufgabe zum Speichern.
+ */
+void restoreRtcSnapshotButtons();
+
+// Schreibt den aktuellen Zustand sofort (z.B. vor einem geplanten Neustart)
+void saveRtcSnapshot();
+
+// Gültigkeit, Wiederherstellung und Schreibzugriffe als JSON (für /api/status)
+void getRtcSnapshotStats(JsonObject obj);
+
+#endif // RTC_SNAPSHOT_H
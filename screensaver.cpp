@@ -0,0 +1,358 @@
+#include "screensaver.h"
+#include "backlight.h"
+#include "config_manager.h"
+#include "service_manager.h"
+#include "timer_wheel.h"
+#include "idle_manager.h"
+#include <EEPROM.h>
+
+// EEPROM-Adresse (zwischen Service-Konfiguration ab 100 und Button-Konfiguration ab 200)
+#define SCREENSAVER_EEPROM_ADDR 160
+#define SCREENSAVER_MAGIC_BYTE 0x5C
+
+struct ScreensaverEEPROMData {
+  uint8_t magic;
+  uint8_t enabled;
+  uint16_t timeoutS;
+  uint8_t dimPercent;
+  uint16_t offDelayS;
+  uint8_t wakeMask;
+  uint8_t checksum;
+};
+
+struct ScreensaverSettings {
+  int timeoutS;
+  bool enabled;
+  int dimPercent;
+  int offDelayS;
+  uint8_t wakeMask;
+};
+
+// Telegramm-Funktionen, die wecken können (Bit = Index)
+const char* screensaverWakeFunctions[] = { "LED", "LBN", "SYS", "TIME", "DATE", "BTN" };
+const int SCREENSAVER_WAKE_FUNCTION_COUNT = sizeof(screensaverWakeFunctions) / sizeof(screensaverWakeFunctions[0]);
+
+const char* screensaverStateNames[] = { "awake", "dimmed", "off" };
+
+ScreensaverState screensaverState = SCREENSAVER_AWAKE;
+int screensaverDimPercent = SCREENSAVER_DIM_PERCENT;
+int screensaverOffDelayS = SCREENSAVER_OFF_DELAY;
+uint8_t screensaverWakeMask = 0;
+int screensaverTimerId = -1;
+unsigned long screensaverLastActivityMs = 0;
+bool screensaverSwallowing = false;
+
+// Änderung aus dem Web-Task (übernommen in processScreensaver)
+ScreensaverSettings screensaverPending;
+volatile bool screensaverPendingValid = false;
+portMUX_TYPE screensaverMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Statistik
+uint32_t screensaverDims = 0;
+uint32_t screensaverOffs = 0;
+uint32_t screensaverTouchWakes = 0;
+uint32_t screensaverTelegramWakes = 0;
+uint32_t screensaverSwallowedSamples = 0;
+unsigned long screensaverStateSinceMs = 0;
+uint64_t screensaverDimmedMs = 0;
+uint64_t screensaverOffMs = 0;
+
+unsigned long screensaverTimeoutMs() {
+  return configManager.display.screenTimeout > 0 ? configManager.display.screenTimeout * 1000UL : 0;
+}
+
+uint8_t screensaverParseWakeMask(String list) {
+  list.replace(" ", "");
+  list.toUpperCase();
+  list = "," + list + ",";
+
+  uint8_t mask = 0;
+  for (int i = 0; i < SCREENSAVER_WAKE_FUNCTION_COUNT; i++) {
+    if (list.indexOf("," + String(screensaverWakeFunctions[i]) + ",") >= 0) {
+      mask |= (1 << i);
+    }
+  }
+  return mask;
+}
+
+String screensaverWakeMaskToString(uint8_t mask) {
+  String list = "";
+  for (int i = 0; i < SCREENSAVER_WAKE_FUNCTION_COUNT; i++) {
+    if (mask & (1 << i)) {
+      if (list.length() > 0) {
+        list += ",";
+      }
+      list += screensaverWakeFunctions[i];
+    }
+  }
+  return list;
+}
+
+uint8_t screensaverChecksum(const ScreensaverEEPROMData& data) {
+  return data.magic + data.enabled + (data.timeoutS & 0xFF) + (data.timeoutS >> 8) +
+         data.dimPercent + (data.offDelayS & 0xFF) + (data.offDelayS >> 8) + data.wakeMask;
+}
+
+void screensaverLoad() {
+  ScreensaverEEPROMData data;
+  EEPROM.get(SCREENSAVER_EEPROM_ADDR, data);
+  if (data.magic != SCREENSAVER_MAGIC_BYTE || data.checksum != screensaverChecksum(data)) {
+    #if DB_INFO == 1
+      Serial.println("DEBUG: Keine Bildschirmschoner-Einstellungen gespeichert, verwende Standard-Werte");
+    #endif
+    return;
+  }
+
+  configManager.display.screenTimeout = data.timeoutS;
+  configManager.display.screensaverEnabled = data.enabled != 0;
+  screensaverDimPercent = data.dimPercent;
+  screensaverOffDelayS = data.offDelayS;
+  screensaverWakeMask = data.wakeMask;
+}
+
+void screensaverSave() {
+  ScreensaverEEPROMData data;
+  data.magic = SCREENSAVER_MAGIC_BYTE;
+  data.enabled = configManager.display.screensaverEnabled ? 1 : 0;
+  data.timeoutS = configManager.display.screenTimeout;
+  data.dimPercent = screensaverDimPercent;
+  data.offDelayS = screensaverOffDelayS;
+  data.wakeMask = screensaverWakeMask;
+  data.checksum = screensaverChecksum(data);
+
+  EEPROM.put(SCREENSAVER_EEPROM_ADDR, data);
+  EEPROM.commit();
+}
+
+// Zeit pro Stufe erfassen
+void screensaverEnterState(ScreensaverState state) {
+  unsigned long now = millis();
+  if (screensaverState == SCREENSAVER_DIMMED) {
+    screensaverDimmedMs += now - screensaverStateSinceMs;
+  } else if (screensaverState == SCREENSAVER_OFF) {
+    screensaverOffMs += now - screensaverStateSinceMs;
+  }
+  screensaverState = state;
+  screensaverStateSinceMs = now;
+
+  #if DB_INFO == 1
+    Serial.print("DEBUG: Bildschirmschoner - ");
+    Serial.println(screensaverStateNames[state]);
+  #endif
+}
+
+void screensaverSchedule(unsigned long delayMs) {
+  if (screensaverTimerId < 0) {
+    return;
+  }
+  if (screensaverTimeoutMs() == 0) {
+    timerWheelStop(screensaverTimerId);
+    return;
+  }
+  timerWheelStart(screensaverTimerId, delayMs);
+}
+
+// Nächste Stufe (Timer-Rad) - Bedienung dazwischen verschiebt nur den Zeitpunkt
+void screensaverStep() {
+  unsigned long timeoutMs = screensaverTimeoutMs();
+  if (timeoutMs == 0) {
+    return;
+  }
+
+  // Service-Menü bleibt hell
+  if (serviceManager.isServiceMode()) {
+    screensaverLastActivityMs = millis();
+    screensaverSchedule(timeoutMs);
+    return;
+  }
+
+  // Laufenden Fade abwarten (ESP32 kann ihn nicht abbrechen)
+  if (isBacklightFading()) {
+    screensaverSchedule(50);
+    return;
+  }
+
+  switch (screensaverState) {
+    case SCREENSAVER_AWAKE: {
+      unsigned long idleMs = millis() - screensaverLastActivityMs;
+      if (idleMs < timeoutMs) {
+        screensaverSchedule(timeoutMs - idleMs);
+        return;
+      }
+      screensaverEnterState(SCREENSAVER_DIMMED);
+      screensaverDims++;
+      if (screensaverDimPercent < currentBacklight) {
+        backlightFadeTo(screensaverDimPercent, SCREENSAVER_FADE_MS);
+      }
+      if (configManager.display.screensaverEnabled) {
+        screensaverSchedule(screensaverOffDelayS * 1000UL);
+      }
+      break;
+    }
+
+    case SCREENSAVER_DIMMED:
+      if (configManager.display.screensaverEnabled) {
+        screensaverEnterState(SCREENSAVER_OFF);
+        screensaverOffs++;
+        backlightFadeTo(0, SCREENSAVER_FADE_MS);
+      }
+      break;
+
+    case SCREENSAVER_OFF:
+      break;
+  }
+}
+
+// Weckt aus Dimmstufe/dunkel - true, wenn tatsächlich geweckt wurde
+bool screensaverWake(bool byTouch) {
+  screensaverLastActivityMs = millis();
+  if (screensaverState == SCREENSAVER_AWAKE) {
+    return false;
+  }
+
+  if (byTouch) {
+    screensaverTouchWakes++;
+  } else {
+    screensaverTelegramWakes++;
+  }
+  screensaverEnterState(SCREENSAVER_AWAKE);
+  backlightRestore();  // aus dunkel: Szene zeichnen, dann Licht an
+  screensaverSchedule(screensaverTimeoutMs());
+  return true;
+}
+
+void setupScreensaver() {
+  // Voreinstellungen aus config.h, gespeicherte Werte überschreiben sie
+  configManager.display.screenTimeout = SCREENSAVER_TIMEOUT;
+  configManager.display.screensaverEnabled = SCREENSAVER_ENABLED;
+  screensaverWakeMask = screensaverParseWakeMask(SCREENSAVER_WAKE_TELEGRAMS);
+  screensaverLoad();
+
+  screensaverTimerId = timerWheelRegister("screensaver", [](void*) { screensaverStep(); });
+  screensaverStateSinceMs = millis();
+  screensaverReset();
+
+  #if DB_INFO == 1
+    Serial.printf("DEBUG: Bildschirmschoner - Timeout %d s, Dimmstufe %d%%, aus nach %d s: %s, Wecken: %s\n",
+                  configManager.display.screenTimeout, screensaverDimPercent, screensaverOffDelayS,
+                  configManager.display.screensaverEnabled ? "ja" : "nein",
+                  screensaverWakeMaskToString(screensaverWakeMask).c_str());
+  #endif
+}
+
+void screensaverReset() {
+  screensaverLastActivityMs = millis();
+  if (screensaverState != SCREENSAVER_AWAKE) {
+    screensaverEnterState(SCREENSAVER_AWAKE);
+  }
+  screensaverSchedule(screensaverTimeoutMs());
+}
+
+bool screensaverHandleTouch(TouchPollResult result) {
+  if (result == TOUCH_POLL_NONE) {
+    return false;
+  }
+
+  // Weckender Touch - alle Abtastungen bis zum Loslassen ignorieren
+  if (screensaverSwallowing) {
+    if (result == TOUCH_POLL_RELEASED) {
+      screensaverSwallowing = false;
+      screensaverLastActivityMs = millis();
+    } else {
+      screensaverSwallowedSamples++;
+    }
+    return true;
+  }
+
+  // Nur verschlucken, wenn das Display wirklich gedimmt war (Dimmstufe unter Sollwert)
+  if (result == TOUCH_POLL_PRESSED) {
+    bool lowered = getEffectiveBacklight() < currentBacklight;
+    if (screensaverWake(true) && lowered) {
+      screensaverSwallowing = true;
+      return true;
+    }
+  }
+  screensaverLastActivityMs = millis();
+  return false;
+}
+
+void screensaverNotifyTelegram(const String& function) {
+  for (int i = 0; i < SCREENSAVER_WAKE_FUNCTION_COUNT; i++) {
+    if (function == screensaverWakeFunctions[i]) {
+      if (screensaverWakeMask & (1 << i)) {
+        screensaverWake(false);
+      }
+      return;
+    }
+  }
+}
+
+void processScreensaver() {
+  if (!screensaverPendingValid) {
+    return;
+  }
+  portENTER_CRITICAL(&screensaverMux);
+  ScreensaverSettings settings = screensaverPending;
+  screensaverPendingValid = false;
+  portEXIT_CRITICAL(&screensaverMux);
+
+  configManager.display.screenTimeout = settings.timeoutS;
+  configManager.display.screensaverEnabled = settings.enabled;
+  screensaverDimPercent = settings.dimPercent;
+  screensaverOffDelayS = settings.offDelayS;
+  screensaverWakeMask = settings.wakeMask;
+  screensaverSave();
+
+  // Mit den neuen Werten von vorn beginnen
+  if (screensaverState != SCREENSAVER_AWAKE) {
+    screensaverWake(false);
+  }
+  screensaverReset();
+}
+
+void screensaverSetConfig(int timeoutS, bool enabled, int dimPercent, int offDelayS,
+                          const String& wakeTelegrams) {
+  ScreensaverSettings settings;
+  settings.timeoutS = constrain(timeoutS, 0, 65535);
+  settings.enabled = enabled;
+  settings.dimPercent = constrain(dimPercent, 0, 100);
+  settings.offDelayS = constrain(offDelayS, 0, 65535);
+  settings.wakeMask = screensaverParseWakeMask(wakeTelegrams);
+
+  portENTER_CRITICAL(&screensaverMux);
+  screensaverPending = settings;
+  screensaverPendingValid = true;
+  portEXIT_CRITICAL(&screensaverMux);
+
+  if (!idleIsLoopTask()) {
+    idleWakeFromTask();
+  }
+}
+
+ScreensaverState getScreensaverState() {
+  return screensaverState;
+}
+
+void getScreensaverConfig(JsonObject obj) {
+  obj["screenTimeout"] = configManager.display.screenTimeout;
+  obj["screensaverEnabled"] = configManager.display.screensaverEnabled;
+  obj["dimPercent"] = screensaverDimPercent;
+  obj["offDelay"] = screensaverOffDelayS;
+  obj["wakeTelegrams"] = screensaverWakeMaskToString(screensaverWakeMask);
+  obj["state"] = screensaverStateNames[screensaverState];
+}
+
+void getScreensaverStats(JsonObject obj) {
+  unsigned long inStateMs = millis() - screensaverStateSinceMs;
+
+  obj["state"] = screensaverStateNames[screensaverState];
+  obj["effectiveBacklight"] = getEffectiveBacklight();
+  obj["dims"] = screensaverDims;
+  obj["offs"] = screensaverOffs;
+  obj["touchWakes"] = screensaverTouchWakes;
+  obj["telegramWakes"] = screensaverTelegramWakes;
+  obj["swallowedSamples"] = screensaverSwallowedSamples;
+  obj["fades"] = getBacklightFadeCount();
+  obj["dimmedMs"] = screensaverDimmedMs + (screensaverState == SCREENSAVER_DIMMED ? inStateMs : 0);
+  obj["offMs"] = screensaverOffMs + (screensaverState == SCREENSAVER_OFF ? inStateMs : 0);
+}
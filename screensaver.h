@@ -0,0 +1,54 @@
+/**
+ * screensaver.h - Bildschirmschoner und automatisches Dimmen
+ *
+ * Gesteuert über DisplayConfig (config_manager.h):
+ * - screenTimeout (Sekunden, 0 = aus): nach dieser Zeit ohne Bedienung wird die
+ *   Beleuchtung per LEDC-Hardware-Fade auf die Dimmstufe abgesenkt
+ * - screensaverEnabled: nach weiteren offDelay Sekunden auf 0 - das Display ist dann
+ *   dunkel und der Compositor überträgt nichts (isDisplayDark, kein SPI-Verkehr)
+ *
+ * Ein Touch weckt nur und wird bis zum Loslassen verschluckt (kein BTN-Telegramm).
+ * Telegramme wecken, wenn ihre Funktion in der Weck-Liste steht (z.B. "LED,SYS").
+ * Im Service-Menü wird nicht gedimmt. Einstellungen über /api/screensaver,
+ * gespeichert im EEPROM.
+ */
+#ifndef SCREENSAVER_H
+#define SCREENSAVER_H
+
+#include "config.h"
+#include "touch.h"
+
+enum ScreensaverState {
+  SCREENSAVER_AWAKE = 0,
+  SCREENSAVER_DIMMED,
+  SCREENSAVER_OFF
+};
+
+// Einstellungen laden und Timer registrieren (nach setupBacklight())
+void setupScreensaver();
+
+// Helligkeit wurde gesetzt (setBacklight) - wach, Zeit läuft von vorn, ohne PWM-Zugriff
+void screensaverReset();
+
+// Touch-Ereignis aus handleTouchInput() - true: verschluckt (hat nur geweckt)
+bool screensaverHandleTouch(TouchPollResult result);
+
+// Ausgeführtes Telegramm (executeTelegram) - weckt, wenn die Funktion in der Weck-Liste steht
+void screensaverNotifyTelegram(const String& function);
+
+// Einstellungen aus dem Web-Task übernehmen und speichern (im Loop vor uiRender())
+void processScreensaver();
+
+// Neue Einstellungen (aus jedem Task, übernommen in processScreensaver)
+void screensaverSetConfig(int timeoutS, bool enabled, int dimPercent, int offDelayS,
+                          const String& wakeTelegrams);
+
+ScreensaverState getScreensaverState();
+
+// Einstellungen und Zustand als JSON (für GET /api/screensaver)
+void getScreensaverConfig(JsonObject obj);
+
+// Stufenwechsel, Weckgründe und Zeit pro Stufe als JSON (für /api/status)
+void getScreensaverStats(JsonObject obj);
+
+#endif // SCREENSAVER_H
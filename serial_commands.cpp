@@ -0,0 +1,72 @@
+#include "serial_commands.h"
+#include "timer_wheel.h"
+
+// Registrierter Befehl
+struct SerialCommand {
+  const char* command;
+  const char* help;
+  SerialCommandHandler handler;
+};
+
+SerialCommand serialCommands[SERIAL_MAX_COMMANDS];
+int serialCommandCount = 0;
+
+// Eingabepuffer (bis zum Zeilenende)
+String serialCommandBuffer = "";
+
+void setupSerialCommands() {
+  serialCommandBuffer.reserve(SERIAL_COMMAND_MAX_LENGTH);
+  timerWheelAddPeriodic("serialCmd", SERIAL_COMMAND_INTERVAL, [](void*) { processSerialCommands(); });
+}
+
+bool registerSerialCommand(const char* command, SerialCommandHandler handler, const char* help) {
+  if (serialCommandCount >= SERIAL_MAX_COMMANDS || handler == nullptr) {
+    Serial.print("FEHLER: Serial-Befehl konnte nicht registriert werden: ");
+    Serial.println(command);
+    return false;
+  }
+
+  SerialCommand& entry = serialCommands[serialCommandCount++];
+  entry.command = command;
+  entry.help = help;
+  entry.handler = handler;
+  return true;
+}
+
+// Liste aller Befehle ausgeben
+void printSerialCommands() {
+  Serial.println("Serial-Befehle:");
+  for (int i = 0; i < serialCommandCount; i++) {
+    Serial.printf("  %-12s %s\n", serialCommands[i].command, serialCommands[i].help);
+  }
+}
+
+void executeSerialCommand(const String& line) {
+  for (int i = 0; i < serialCommandCount; i++) {
+    if (line == serialCommands[i].command) {
+      serialCommands[i].handler();
+      return;
+    }
+  }
+  Serial.print("Unbekannter Befehl: ");
+  Serial.println(line);
+  printSerialCommands();
+}
+
+void processSerialCommands() {
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c != '\n' && c != '\r') {
+      if (serialCommandBuffer.length() < SERIAL_COMMAND_MAX_LENGTH) {
+        serialCommandBuffer += c;
+      }
+      continue;
+    }
+
+    serialCommandBuffer.trim();
+    if (serialCommandBuffer.length() > 0) {  // "\r\n" ergibt eine leere Zeile
+      executeSerialCommand(serialCommandBuffer);
+    }
+    serialCommandBuffer = "";
+  }
+}
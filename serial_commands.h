@@ -0,0 +1,34 @@
+/**
+ * serial_commands.h - Befehle über den USB-Serial-Monitor
+ *
+ * Module registrieren ihre Befehle beim Setup (z.B. "prof", "scene").
+ * Eine Aufgabe im Timer-Rad liest die Eingabe zeilenweise und ruft den passenden
+ * Callback im Loop-Task auf. Unbekannte Befehle geben die Liste aller Befehle aus.
+ *
+ * Unabhängig vom Loop-Profiler (ENABLE_LOOP_PROFILER), läuft immer.
+ */
+#ifndef SERIAL_COMMANDS_H
+#define SERIAL_COMMANDS_H
+
+#include "config.h"
+
+// Führt einen Befehl aus (im Loop-Task)
+typedef void (*SerialCommandHandler)();
+
+// Registriert die Abfrage im Timer-Rad (vor den Modulen, die Befehle registrieren)
+void setupSerialCommands();
+
+/**
+ * Registriert einen Befehl
+ *
+ * @param command       Befehl, ganze Zeile ohne Leerzeichen am Rand (z.B. "prof reset")
+ * @param handler       Aufzurufende Funktion
+ * @param help          Kurzbeschreibung für die Befehlsliste
+ * @return false wenn kein Platz mehr frei ist (SERIAL_MAX_COMMANDS)
+ */
+bool registerSerialCommand(const char* command, SerialCommandHandler handler, const char* help);
+
+// Liest verfügbare Zeichen und führt vollständige Zeilen aus
+void processSerialCommands();
+
+#endif // SERIAL_COMMANDS_H
@@ -14,6 +14,12 @@
 #include "web_server_manager.h"
 #include "config_manager.h"
 #include "header_display.h"
+#include "report_scheduler.h"
+#include "timer_wheel.h"
+#include "profiler.h"
+#include "btn_latency.h"
+#include "trace.h"
+#include "spi_bus.h"
 // Globale ServiceManager Instanz
 ServiceManager serviceManager;
 
@@ -34,6 +40,8 @@ ServiceManager::ServiceManager() {
   touchStartTime = 0;
   longTouchActive = false;
   lastProgressUpdate = 0;
+  lastLatencyOverlayUpdate = 0;
+  lastLatencyOverlayCount = 0;
   progressPercent = 0;
   currentDeviceID = DEVICE_ID;  // Aus config.h
   currentOrientation = SCREEN_ORIENTATION;  // Aus config.h
@@ -105,7 +113,7 @@ void ServiceManager::initServiceButtons() {
 void ServiceManager::initNumpadButtons() {
   // Dynamisches Layout je nach Orientierung
   int buttonW, buttonH, spacing, startX, startY;
-  int cols, rows;
+  int cols;
   
   if (currentOrientation == LANDSCAPE) {
     // Landscape: Kleinere Buttons, kompakteres Layout
@@ -113,7 +121,6 @@ void ServiceManager::initNumpadButtons() {
     buttonH = 18;  // Kleiner für Landscape
     spacing = 5;   // Weniger Abstand
     cols = 4;
-    rows = 4;
     startX = (SCREEN_WIDTH - (cols * buttonW + (cols-1) * spacing)) / 2;
     startY = 100;  // Höher positioniert
   } else {
@@ -122,7 +129,6 @@ void ServiceManager::initNumpadButtons() {
     buttonH = 20;
     spacing = 5;
     cols = 4;
-    rows = 4;
     startX = (SCREEN_WIDTH - (cols * buttonW + (cols-1) * spacing)) / 2;
     startY = 80;
   }
@@ -175,8 +181,8 @@ void ServiceManager::update() {
     // Wird in der Haupt-loop() über handleTouch() aufgerufen
   }
   
-  // Progress-Bar Update (alle 100ms)
-  if (currentState == SERVICE_ACTIVATING && millis() - lastProgressUpdate > 100) {
+  // Progress-Bar Update (alle SERVICE_PROGRESS_INTERVAL, Takt kommt vom Timer-Rad)
+  if (currentState == SERVICE_ACTIVATING) {
     unsigned long elapsed = millis() - touchStartTime;
     progressPercent = (elapsed * 100) / 20000;  // 20 Sekunden = 100%
     
@@ -193,6 +199,15 @@ void ServiceManager::update() {
       }
     #endif
   }
+  
+  // *** NEU: Latenz-Anzeige nur bei neuen Messungen neu zeichnen ***
+  #if BTN_LATENCY_OVERLAY == 1
+    if (currentState == SERVICE_ACTIVE &&
+        millis() - lastLatencyOverlayUpdate >= BTN_LATENCY_OVERLAY_INTERVAL &&
+        getBtnLatencyCount() != lastLatencyOverlayCount) {
+      drawLatencyOverlay();
+    }
+  #endif
 }
 
 void ServiceManager::handleTouch(int x, int y, bool touched) {
@@ -361,6 +376,8 @@ void ServiceManager::cancelServiceMode() {
 }
 
 void ServiceManager::drawServiceMenu() {
+  // Service-Bildschirme zeichnen direkt (ohne Compositor) und belegen den Bus selbst
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   
@@ -427,6 +444,22 @@ void ServiceManager::drawServiceMenu() {
       tft.drawCentreString(serviceButtons[i].label, textX, textY, 2);
     }
   }
+  
+  #if BTN_LATENCY_OVERLAY == 1
+    drawLatencyOverlay();
+  #endif
+}
+
+// Touch→Bus-Latenz (Perzentile) in der untersten Zeile des Service-Menüs
+void ServiceManager::drawLatencyOverlay() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
+  tft.fillRect(0, SCREEN_HEIGHT - 14, SCREEN_WIDTH, 12, TFT_WHITE);
+  tft.setTextColor(TFT_DARKGREY, TFT_WHITE);
+  tft.drawCentreString(getBtnLatencySummary(), SCREEN_WIDTH/2, SCREEN_HEIGHT - 12, 1);
+  tft.setTextColor(TFT_BLACK, TFT_WHITE);
+  
+  lastLatencyOverlayUpdate = millis();
+  lastLatencyOverlayCount = getBtnLatencyCount();
 }
 
 void ServiceManager::redrawServiceMenu() {
@@ -438,6 +471,7 @@ void ServiceManager::redrawServiceMenu() {
 }
 
 void ServiceManager::drawProgressBar(int percent) {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   // Progress-Bar am unteren Bildschirmrand
   int barWidth = SCREEN_WIDTH - 20;
   int barHeight = 20;
@@ -504,6 +538,7 @@ void ServiceManager::onTestFunction() {
   #endif
   
   // Test-Screen anzeigen
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   tft.drawCentreString("TEST FUNKTIONEN", SCREEN_WIDTH/2, 10, 2);
@@ -531,16 +566,17 @@ void ServiceManager::onTestFunction() {
   tft.fillRect(10, SCREEN_HEIGHT-40, SCREEN_WIDTH-20, 30, TFT_BLUE);
   tft.setTextColor(TFT_WHITE);
   tft.drawCentreString("TOUCH ZUM ZURÜCKKEHREN", SCREEN_WIDTH/2, SCREEN_HEIGHT-30, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   // Warten auf Touch und Touch-Koordinaten anzeigen
   // Warten auf Touch
   bool exitTest = false;
   while (!exitTest) {
-    if (touchscreen.tirqTouched() && touchscreen.touched()) {
+    if (touchscreen.tirqTouched() && touchReadTouched()) {
       delay(50);
       
       int x, y;
-      getTouchPoint(&x, &y);
+      touchReadPoint(&x, &y);
       
       // Touch-Kalibrierung
       if (x >= 10 && x <= 160 && y >= 50 && y <= 90) {
@@ -557,7 +593,7 @@ void ServiceManager::onTestFunction() {
         exitTest = true;
       }
       // Warten bis losgelassen
-      while (touchscreen.touched()) {
+      while (touchReadTouched()) {
         delay(10);
       }
     }
@@ -621,11 +657,13 @@ void ServiceManager::onToggleOrientation() {
   orientationChanged = true;
   
   // *** Bestätigungsmeldung anzeigen (ohne Orientierung zu ändern) ***
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillRect(0, SCREEN_HEIGHT - 40, SCREEN_WIDTH, 40, TFT_DARKGREEN);
   tft.setTextColor(TFT_WHITE);
   String orientText = (currentOrientation == LANDSCAPE) ? "LANDSCAPE" : "PORTRAIT";
   tft.drawCentreString("Neue Orientierung: " + orientText, SCREEN_WIDTH/2, SCREEN_HEIGHT - 25, 2);
   tft.drawCentreString("Wird beim SAVE & EXIT angewendet", SCREEN_WIDTH/2, SCREEN_HEIGHT - 10, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   delay(2000);
   
@@ -643,7 +681,9 @@ void ServiceManager::toggleOrientation() {
 
 void ServiceManager::applyOrientation(int rotation) {
   rotation %= 4;
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.setRotation(rotation);
+  spiBusRelease(SPI_BUS_DISPLAY);
   currentOrientation = rotation;
   configManager.device.orientation = rotation;
   configChanged = true;
@@ -660,6 +700,7 @@ void ServiceManager::showOrientationPreview() {
   applyOrientation(currentOrientation);  // ✅ Nur aufrufen, nicht definieren
 
   // Preview-Screen anzeigen
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
 
@@ -675,6 +716,7 @@ void ServiceManager::showOrientationPreview() {
   tft.fillRect(SCREEN_WIDTH - 60, 70, 50, 30, TFT_GREEN);
   tft.fillRect(10, SCREEN_HEIGHT - 50, 50, 30, TFT_BLUE);
   tft.fillRect(SCREEN_WIDTH - 60, SCREEN_HEIGHT - 50, 50, 30, TFT_YELLOW);
+  spiBusRelease(SPI_BUS_DISPLAY);
 
   drawServiceMenu();  // zurück zur Menüanzeige
 }
@@ -706,6 +748,7 @@ void ServiceManager::onWebConfig() {
     }
     
     // Web-Config Anzeige
+    spiBusAcquire(SPI_BUS_DISPLAY);
     tft.fillScreen(TFT_WHITE);
     tft.setTextColor(TFT_BLACK, TFT_WHITE);
     tft.drawCentreString("WEB-KONFIGURATION", SCREEN_WIDTH/2, 10, 2);
@@ -743,13 +786,14 @@ void ServiceManager::onWebConfig() {
         tft.setTextColor(TFT_BLACK, TFT_WHITE);
         tft.drawCentreString("Aktivieren Sie zuerst WiFi", SCREEN_WIDTH/2, 80, 1);
     }
+    spiBusRelease(SPI_BUS_DISPLAY);
     
     // Warten auf Touch
     unsigned long startTime = millis();
     bool touched = false;
     
     while (!touched && (millis() - startTime < 10000)) {  // 10 Sekunden Timeout
-        if (touchscreen.tirqTouched() && touchscreen.touched()) {
+        if (touchscreen.tirqTouched() && touchReadTouched()) {
             touched = true;
             delay(200);  // Entprellung
         }
@@ -779,9 +823,9 @@ void ServiceManager::startWiFiAP() {
   
   if (success) {
     wifiActive = true;
-    IPAddress IP = WiFi.softAPIP();
     
     #if DB_INFO == 1
+      IPAddress IP = WiFi.softAPIP();
       Serial.print("DEBUG: WiFi AP gestartet - SSID: ");
       Serial.println(wifiSSID);
       Serial.print("DEBUG: IP-Adresse: ");
@@ -966,6 +1010,8 @@ void ServiceManager::loadConfig() {
 }
 
 void ServiceManager::saveConfig() {
+  TRACE_SCOPE(TRACE_EEPROM_SAVE);
+  
   ServiceConfig config;
   config.magic = CONFIG_MAGIC_BYTE;
   strncpy(config.deviceID, currentDeviceID.c_str(), 4);
@@ -1007,6 +1053,10 @@ void ServiceManager::setDeviceID(String newID) {
       currentDeviceID = newID;
       configChanged = true;
       
+      // Phasenversatz der periodischen Meldungen hängt von der Device ID ab
+      // (Aufruf auch aus dem Web-Task - neu geplant wird im Loop)
+      requestReportReschedule();
+      
       #if DB_INFO == 1
         Serial.print("DEBUG: Device ID geändert auf: ");
         Serial.println(currentDeviceID);
@@ -1042,6 +1092,8 @@ void ServiceManager::setOrientation(int orientation) {
   #endif
   
   // *** KORREKTUR: Sofortige TFT-Anwendung ***
+  // (auch aus dem Web-Task - setRotation() sendet MADCTL über den gemeinsamen Bus)
+  spiBusAcquire(SPI_BUS_DISPLAY);
   if (orientation == PORTRAIT) {
     tft.setRotation(ROTATION_0);        // Portrait
     currentOrientation = PORTRAIT;
@@ -1049,6 +1101,7 @@ void ServiceManager::setOrientation(int orientation) {
     tft.setRotation(ROTATION_270);      // Landscape USB rechts (Standard)
     currentOrientation = LANDSCAPE;
   }
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   configChanged = true;
   orientationChanged = true;
@@ -1086,6 +1139,7 @@ bool ServiceManager::isWebServerActive() {
 // *** DEVICE ID EDITOR IMPLEMENTATION ***
 
 void ServiceManager::drawDeviceIDEditor() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   
@@ -1100,6 +1154,7 @@ void ServiceManager::drawDeviceIDEditor() {
 }
 
 void ServiceManager::drawDeviceIDDisplay() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   int displayY = 5;  // Direkt im oberen Bereich (Headerbereich)
 
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
@@ -1131,6 +1186,7 @@ void ServiceManager::drawDeviceIDDisplay() {
 }  
 
 void ServiceManager::drawNumpad() {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   for (int i = 0; i < NUM_NUMPAD_BUTTONS; i++) {
     // Button-Hintergrund
     tft.fillRect(numpadButtons[i].x, numpadButtons[i].y, 
@@ -1279,18 +1335,22 @@ void ServiceManager::confirmDeviceIDEdit() {
     #endif
     
     // Erfolgsmeldung anzeigen
+    spiBusAcquire(SPI_BUS_DISPLAY);
     tft.fillRect(0, SCREEN_HEIGHT - 50, SCREEN_WIDTH, 50, TFT_DARKGREEN);
     tft.setTextColor(TFT_WHITE);
     tft.drawCentreString("Device ID erfolgreich geändert!", SCREEN_WIDTH/2, SCREEN_HEIGHT - 35, 2);
     tft.drawCentreString("Neue ID: " + currentDeviceID, SCREEN_WIDTH/2, SCREEN_HEIGHT - 15, 1);
+    spiBusRelease(SPI_BUS_DISPLAY);
     
     delay(2000);
   } else {
     // Fehlermeldung
+    spiBusAcquire(SPI_BUS_DISPLAY);
     tft.fillRect(0, SCREEN_HEIGHT - 50, SCREEN_WIDTH, 50, TFT_RED);
     tft.setTextColor(TFT_WHITE);
     tft.drawCentreString("Ungültige Device ID!", SCREEN_WIDTH/2, SCREEN_HEIGHT - 35, 2);
     tft.drawCentreString("Nur Ziffern 0-9 erlaubt", SCREEN_WIDTH/2, SCREEN_HEIGHT - 15, 1);
+    spiBusRelease(SPI_BUS_DISPLAY);
     
     delay(2000);
     
@@ -1310,9 +1370,11 @@ void ServiceManager::cancelDeviceIDEdit() {
   #endif
   
   // Abbruch-Meldung anzeigen
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillRect(0, SCREEN_HEIGHT - 30, SCREEN_WIDTH, 30, TFT_ORANGE);
   tft.setTextColor(TFT_BLACK);
   tft.drawCentreString("Device ID Bearbeitung abgebrochen", SCREEN_WIDTH/2, SCREEN_HEIGHT - 20, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   delay(1000);
   
@@ -1327,6 +1389,12 @@ void setupServiceManager() {
   EEPROM.begin(512);  // EEPROM initialisieren
   serviceManager.loadConfig();
   
+  // *** NEU: Fortschrittsanzeige der Service-Aktivierung über das Timer-Rad ***
+  timerWheelAddPeriodic("service", SERVICE_PROGRESS_INTERVAL, [](void*) {
+    PROFILE_SCOPE(PROF_SERVICE);
+    updateServiceManager();
+  });
+  
   #if DB_INFO == 1
     Serial.println("DEBUG: ServiceManager initialisiert - Version 1.50");
     Serial.print("DEBUG: Device ID: ");
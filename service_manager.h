@@ -49,6 +49,10 @@ private:
   bool longTouchActive;
   unsigned long lastProgressUpdate;
   
+  // *** NEU: Anzeige der Touch→Bus-Latenz im Service-Menü ***
+  unsigned long lastLatencyOverlayUpdate;
+  unsigned long lastLatencyOverlayCount;
+  
   // Service-Menü Buttons
   static const int NUM_SERVICE_BUTTONS = 8;  // ← 8 Buttons (inkl. Test)
   ServiceButton serviceButtons[NUM_SERVICE_BUTTONS];
@@ -101,6 +105,7 @@ private:
   void drawServiceMenu();
   void drawProgressBar(int percent);
   void redrawServiceMenu();
+  void drawLatencyOverlay();
   
   // Button-Handling (private)
   int checkServiceButtonPress(int x, int y);
@@ -0,0 +1,138 @@
+#include "spi_bus.h"
+#include "touch.h"
+
+const char* spiBusDeviceNames[SPI_BUS_DEVICE_COUNT] = { "display", "touch" };
+
+struct SpiBusDeviceStats {
+  uint32_t transactions;
+  uint64_t busyUs;
+  uint32_t maxHoldUs;
+  uint64_t waitUs;
+  uint64_t bytes;
+  uint32_t depth;           // Verschachtelung (nur die äußerste Belegung zählt)
+  uint32_t acquiredAtUs;
+  uint32_t windowBusyUs;    // Belegung im laufenden 1-s-Fenster
+  uint32_t busyLastSecondUs;
+  uint64_t countedBusyUs;   // Belegung mit gemeldeten Bytes (Basis für den Durchsatz)
+  bool holdCounted;         // In der laufenden Belegung wurden Bytes gemeldet
+};
+
+SpiBusDeviceStats spiBusStats[SPI_BUS_DEVICE_COUNT];
+SemaphoreHandle_t spiBusMutex = nullptr;
+int spiBusLastDevice = -1;
+uint32_t spiBusHandovers = 0;
+uint32_t spiBusTouchYields = 0;
+unsigned long spiBusWindowStartMs = 0;
+unsigned long spiBusStatsStartMs = 0;
+
+void setupSpiBus() {
+  spiBusMutex = xSemaphoreCreateRecursiveMutex();
+  memset(spiBusStats, 0, sizeof(spiBusStats));
+  spiBusStatsStartMs = millis();
+  spiBusWindowStartMs = spiBusStatsStartMs;
+}
+
+void spiBusAcquire(SpiBusDevice device) {
+  SpiBusDeviceStats& stats = spiBusStats[device];
+
+  uint32_t waitStart = micros();
+  if (spiBusMutex != nullptr) {
+    xSemaphoreTakeRecursive(spiBusMutex, portMAX_DELAY);
+  }
+  if (stats.depth++ > 0) {
+    return;
+  }
+
+  uint32_t now = micros();
+  stats.waitUs += now - waitStart;
+  stats.acquiredAtUs = now;
+  stats.transactions++;
+
+  // Anderes Gerät als zuletzt - SPI-Takt und Modus werden umgestellt
+  if (spiBusLastDevice != device) {
+    if (spiBusLastDevice >= 0) {
+      spiBusHandovers++;
+    }
+    spiBusLastDevice = device;
+  }
+}
+
+void spiBusRelease(SpiBusDevice device) {
+  SpiBusDeviceStats& stats = spiBusStats[device];
+  if (stats.depth == 0) {
+    return;
+  }
+
+  if (--stats.depth == 0) {
+    uint32_t holdUs = micros() - stats.acquiredAtUs;
+    stats.busyUs += holdUs;
+    stats.windowBusyUs += holdUs;
+    if (holdUs > stats.maxHoldUs) {
+      stats.maxHoldUs = holdUs;
+    }
+    if (stats.holdCounted) {
+      stats.countedBusyUs += holdUs;
+      stats.holdCounted = false;
+    }
+
+    // Belegung pro Sekunde (gleitendes 1-s-Fenster)
+    unsigned long nowMs = millis();
+    if (nowMs - spiBusWindowStartMs >= 1000) {
+      for (int i = 0; i < SPI_BUS_DEVICE_COUNT; i++) {
+        spiBusStats[i].busyLastSecondUs = spiBusStats[i].windowBusyUs;
+        spiBusStats[i].windowBusyUs = 0;
+      }
+      spiBusWindowStartMs = nowMs;
+    }
+  }
+
+  if (spiBusMutex != nullptr) {
+    xSemaphoreGiveRecursive(spiBusMutex);
+  }
+}
+
+void spiBusCountBytes(SpiBusDevice device, uint32_t bytes) {
+  spiBusStats[device].bytes += bytes;
+  spiBusStats[device].holdCounted = true;
+}
+
+void spiBusYieldToTouch() {
+  if (!touchSampleDue()) {
+    return;
+  }
+
+  // Display-Transaktion beenden (CS high), Touch abtasten, weiterzeichnen
+  tft.endWrite();
+  spiBusRelease(SPI_BUS_DISPLAY);
+
+  touchPrefetchSample();
+  spiBusTouchYields++;
+
+  spiBusAcquire(SPI_BUS_DISPLAY);
+  tft.startWrite();
+}
+
+void getSpiBusStats(JsonObject obj) {
+  unsigned long elapsedMs = millis() - spiBusStatsStartMs;
+
+  obj["handovers"] = spiBusHandovers;
+  obj["touchYields"] = spiBusTouchYields;
+
+  JsonArray devices = obj.createNestedArray("devices");
+  for (int i = 0; i < SPI_BUS_DEVICE_COUNT; i++) {
+    const SpiBusDeviceStats& stats = spiBusStats[i];
+    JsonObject d = devices.createNestedObject();
+    d["name"] = spiBusDeviceNames[i];
+    d["transactions"] = stats.transactions;
+    d["busyMs"] = (uint32_t)(stats.busyUs / 1000);
+    d["maxHoldUs"] = stats.maxHoldUs;
+    d["waitUs"] = stats.waitUs;
+    d["bytes"] = stats.bytes;
+    d["occupancyPct"] = elapsedMs > 0 ? stats.busyUs / (elapsedMs * 10.0f) : 0;
+    d["occupancyLastSecondPct"] = stats.busyLastSecondUs / 10000.0f;
+  }
+
+  // Display-Durchsatz der Compositor-Frames (direkt zeichnende Bildschirme melden keine Bytes)
+  const SpiBusDeviceStats& display = spiBusStats[SPI_BUS_DISPLAY];
+  obj["displayKBps"] = display.countedBusyUs > 0 ? (uint32_t)(display.bytes * 1000ULL / display.countedBusyUs) : 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * spi_bus.h - Gemeinsamer HSPI-Bus für Display und Touch
+ *
+ * TFT (80 MHz) und XPT2046 (2,5 MHz) hängen an denselben HSPI-Pins 12/13/14,
+ * jeweils mit eigenem SPIClass-Objekt. Jeder Zugriff läuft über
+ * spiBusAcquire()/spiBusRelease() (rekursiver Mutex) - Transaktionen verschiedener
+ * Geräte überlappen nie, auch wenn ein anderer Task zeichnet (Web-API setzt die Rotation).
+ *
+ * Belegt werden: Compositor-Frames, Touch-Lesezugriffe (touchRead*, Vorab-Abtastung)
+ * sowie die direkt zeichnenden Bildschirme ohne Compositor - Boot-Anzeige, Service-Menü,
+ * Display-Kalibrierung, Touch-Test und -Assistent. Letztere belegen den Bus nur während
+ * des Zeichnens, nicht während sie auf Touch oder delay() warten.
+ *
+ * Der Compositor gibt den Bus zwischen zwei DMA-Bändern kurz ab, wenn eine
+ * Touch-Abtastung fällig ist (spiBusYieldToTouch); die Abtastung wird dann von
+ * pollTouch() übernommen statt erneut über SPI gelesen.
+ *
+ * Erfasst pro Gerät: Transaktionen, Belegungszeit, Wartezeit, Bytes und die
+ * Wechsel zwischen den Geräten (jeder Wechsel stellt den SPI-Takt um). Bytes meldet
+ * nur der Compositor (spiBusCountBytes) - der Display-Durchsatz bezieht sich deshalb
+ * nur auf Belegungen mit gemeldeten Bytes.
+ */
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include "config.h"
+
+enum SpiBusDevice : uint8_t {
+  SPI_BUS_DISPLAY = 0,
+  SPI_BUS_TOUCH,
+  SPI_BUS_DEVICE_COUNT
+};
+
+// Mutex anlegen (vor setupTouch()/setupDisplay())
+void setupSpiBus();
+
+// Bus für ein Gerät belegen bzw. freigeben (verschachtelt erlaubt)
+void spiBusAcquire(SpiBusDevice device);
+void spiBusRelease(SpiBusDevice device);
+
+// Übertragene Bytes einem Gerät zurechnen (für den Durchsatz)
+void spiBusCountBytes(SpiBusDevice device, uint32_t bytes);
+
+// Display gibt den Bus ab, falls eine Touch-Abtastung fällig ist
+// (nur zwischen zwei DMA-Blöcken aufrufen - keine Übertragung aktiv)
+void spiBusYieldToTouch();
+
+// Belegung, Wartezeit, Display-Durchsatz (Compositor) und Gerätewechsel als JSON (für /api/status)
+void getSpiBusStats(JsonObject obj);
+
+// Bus vom Konstruktor bis zum Verlassen des Blocks belegen
+class SpiBusScope {
+public:
+  SpiBusScope(SpiBusDevice device) : device(device) { spiBusAcquire(device); }
+  ~SpiBusScope() { spiBusRelease(device); }
+
+private:
+  SpiBusDevice device;
+};
+
+#define SPI_BUS_SCOPE(device) SpiBusScope spiBusScope(device)
+
+#endif // SPI_BUS_H
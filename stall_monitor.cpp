@@ -0,0 +1,245 @@
+#include "stall_monitor.h"
+#include <esp_timer.h>
+#include <esp_system.h>
+
+#define STALL_LOG_MAGIC 0x5354414CUL  // "STAL"
+
+const char* stallPhaseNames[STALL_PHASE_COUNT] = {
+  "none", "loop", "timer", "rxParse", "rxExec", "tx",
+  "touch", "draw", "restart", "calibration"
+};
+
+// Zeitbudget pro Phase in ms (0 = nicht überwacht)
+const uint32_t stallPhaseBudgets[STALL_PHASE_COUNT] = {
+  0,
+  STALL_BUDGET_LOOP_MS,
+  STALL_BUDGET_TIMER_MS,
+  STALL_BUDGET_RX_MS,
+  STALL_BUDGET_RX_MS,
+  STALL_BUDGET_TX_MS,
+  STALL_BUDGET_TOUCH_MS,
+  STALL_BUDGET_DRAW_MS,
+  STALL_BUDGET_RESTART_MS,
+  STALL_BUDGET_CALIBRATION_MS
+};
+
+// Ein Eintrag im Stall-Log
+struct StallLogEntry {
+  uint32_t bootCount;     // In welchem Boot aufgetreten
+  uint32_t uptimeMs;      // Zeitpunkt seit Boot
+  uint32_t durationMs;    // Dauer (bei offenen Einträgen: zuletzt gemessen)
+  uint16_t line;          // Aufrufstelle
+  uint8_t phase;
+  uint8_t state;          // 0 = beendet, 1 = läuft noch, 2 = durch Reset beendet
+  char file[20];          // Dateiname der Aufrufstelle (ohne Pfad)
+};
+
+#define STALL_ENTRY_CLOSED 0
+#define STALL_ENTRY_OPEN 1
+#define STALL_ENTRY_RESET 2
+
+// Stall-Log im RTC-Speicher (wird beim Neustart nicht initialisiert)
+struct StallLog {
+  uint32_t magic;
+  uint32_t bootCount;
+  uint32_t head;          // Nächster Schreibplatz
+  uint32_t total;         // Anzahl Einträge insgesamt (auch überschriebene)
+  StallLogEntry entries[STALL_LOG_SIZE];
+};
+
+RTC_NOINIT_ATTR StallLog stallLog;
+
+// Aktuelle Phase (wird von der loop() geschrieben, vom esp_timer gelesen)
+volatile StallPhase stallCurrentPhase = STALL_PHASE_NONE;
+volatile uint32_t stallPhaseStartMs = 0;
+const char* volatile stallPhaseFile = "";
+volatile uint16_t stallPhaseLine = 0;
+volatile uint32_t stallPhaseSeq = 0;     // Eindeutig pro Eintritt
+uint32_t stallSeqCounter = 0;
+
+// Bereits gemeldete Phase (pro Eintritt nur ein Log-Eintrag)
+volatile uint32_t stallReportedSeq = 0;
+volatile int stallReportedIndex = -1;
+
+esp_reset_reason_t stallResetReason = ESP_RST_UNKNOWN;
+esp_timer_handle_t stallTimer = nullptr;
+
+#if ENABLE_STALL_MONITOR == 1
+
+// Phase setzen - Sequenz zuletzt, damit stallCheck keine halbe Phase übernimmt
+void stallSetPhase(StallPhase phase, const char* file, uint16_t line) {
+  stallPhaseSeq = 0;
+  stallPhaseStartMs = millis();
+  stallPhaseFile = file;
+  stallPhaseLine = line;
+  stallCurrentPhase = phase;
+  stallPhaseSeq = ++stallSeqCounter;
+}
+
+StallPhaseScope::StallPhaseScope(StallPhase phase, const char* file, uint16_t line) {
+  prevPhase = stallCurrentPhase;
+  prevFile = stallPhaseFile;
+  prevLine = stallPhaseLine;
+  stallSetPhase(phase, file, line);
+}
+
+StallPhaseScope::~StallPhaseScope() {
+  // Innere Abschnitte sind bereits verlassen - die aktuelle Phase ist unsere.
+  // Gemeldeten Eintrag mit der endgültigen Dauer abschließen.
+  if (stallReportedSeq == stallPhaseSeq && stallReportedIndex >= 0) {
+    StallLogEntry& entry = stallLog.entries[stallReportedIndex];
+    entry.durationMs = millis() - stallPhaseStartMs;
+    entry.state = STALL_ENTRY_CLOSED;
+  }
+
+  stallSetPhase(prevPhase, prevFile, prevLine);
+}
+
+// Dateiname ohne Pfad (Arduino übergibt __FILE__ mit vollem Build-Pfad)
+const char* stallBaseName(const char* path) {
+  const char* base = path;
+  for (const char* p = path; *p; p++) {
+    if (*p == '/' || *p == '\\') {
+      base = p + 1;
+    }
+  }
+  return base;
+}
+
+// Prüfung im esp_timer-Task - läuft auch, wenn die loop() blockiert
+void stallCheck(void* arg) {
+  uint32_t seq = stallPhaseSeq;
+  if (seq == 0) {
+    return;  // Phase wird gerade gewechselt
+  }
+  StallPhase phase = stallCurrentPhase;
+  uint32_t budget = stallPhaseBudgets[phase];
+  if (phase == STALL_PHASE_NONE || budget == 0) {
+    return;
+  }
+
+  uint32_t elapsed = millis() - stallPhaseStartMs;
+  if (elapsed <= budget) {
+    return;
+  }
+
+  // Bereits gemeldet - nur die Dauer fortschreiben
+  if (seq == stallReportedSeq) {
+    stallLog.entries[stallReportedIndex].durationMs = elapsed;
+    return;
+  }
+
+  int index = stallLog.head;
+  StallLogEntry& entry = stallLog.entries[index];
+  entry.bootCount = stallLog.bootCount;
+  entry.uptimeMs = millis() - elapsed;
+  entry.durationMs = elapsed;
+  entry.line = stallPhaseLine;
+  entry.phase = phase;
+  entry.state = STALL_ENTRY_OPEN;
+  strncpy(entry.file, stallBaseName(stallPhaseFile), sizeof(entry.file) - 1);
+  entry.file[sizeof(entry.file) - 1] = '\0';
+
+  stallLog.head = (stallLog.head + 1) % STALL_LOG_SIZE;
+  stallLog.total++;
+  stallReportedIndex = index;
+  stallReportedSeq = seq;
+}
+
+#endif
+
+void clearStallLog() {
+  uint32_t bootCount = stallLog.bootCount;
+  memset(&stallLog, 0, sizeof(stallLog));
+  stallLog.magic = STALL_LOG_MAGIC;
+  stallLog.bootCount = bootCount;
+  stallReportedSeq = 0;
+  stallReportedIndex = -1;
+}
+
+void setupStallMonitor() {
+  stallResetReason = esp_reset_reason();
+
+  // Nach Stromausfall ist der RTC-Speicher ungültig
+  if (stallLog.magic != STALL_LOG_MAGIC || stallLog.head >= STALL_LOG_SIZE) {
+    memset(&stallLog, 0, sizeof(stallLog));
+    stallLog.magic = STALL_LOG_MAGIC;
+  }
+  stallLog.bootCount++;
+
+  // Einträge, die beim Neustart noch liefen, hat der Reset beendet
+  for (int i = 0; i < STALL_LOG_SIZE; i++) {
+    if (stallLog.entries[i].state == STALL_ENTRY_OPEN) {
+      stallLog.entries[i].state = STALL_ENTRY_RESET;
+    }
+  }
+
+  if (stallLog.total > 0) {
+    printStallLog();
+  }
+
+  #if ENABLE_STALL_MONITOR == 1
+    esp_timer_create_args_t args = {};
+    args.callback = stallCheck;
+    args.name = "stallCheck";
+    if (esp_timer_create(&args, &stallTimer) == ESP_OK) {
+      esp_timer_start_periodic(stallTimer, STALL_CHECK_INTERVAL_MS * 1000ULL);
+    } else {
+      Serial.println("FEHLER: Stall-Überwachung konnte nicht gestartet werden");
+    }
+  #endif
+}
+
+const char* stallEntryStateName(uint8_t state) {
+  switch (state) {
+    case STALL_ENTRY_OPEN:  return "läuft";
+    case STALL_ENTRY_RESET: return "Reset";
+    default:                return "beendet";
+  }
+}
+
+void printStallLog() {
+  Serial.println("=== Stall-Log ===");
+  Serial.print("Boot #");
+  Serial.print(stallLog.bootCount);
+  Serial.print(", Reset-Grund: ");
+  Serial.print((int)stallResetReason);
+  Serial.print(", Einträge gesamt: ");
+  Serial.println(stallLog.total);
+
+  int count = stallLog.total < STALL_LOG_SIZE ? stallLog.total : STALL_LOG_SIZE;
+  for (int i = 0; i < count; i++) {
+    // Älteste zuerst
+    int index = ((int)stallLog.head - count + i + STALL_LOG_SIZE) % STALL_LOG_SIZE;
+    StallLogEntry& entry = stallLog.entries[index];
+    Serial.printf("  Boot %lu @%lums: %s %lums (%s:%u) [%s]\n",
+                  (unsigned long)entry.bootCount,
+                  (unsigned long)entry.uptimeMs,
+                  entry.phase < STALL_PHASE_COUNT ? stallPhaseNames[entry.phase] : "?",
+                  (unsigned long)entry.durationMs,
+                  entry.file, entry.line,
+                  stallEntryStateName(entry.state));
+  }
+}
+
+void getStallStats(JsonObject obj) {
+  obj["enabled"] = ENABLE_STALL_MONITOR == 1;
+  obj["bootCount"] = stallLog.bootCount;
+  obj["resetReason"] = (int)stallResetReason;
+  obj["total"] = stallLog.total;
+  obj["currentPhase"] = stallPhaseNames[stallCurrentPhase];
+
+  JsonArray entries = obj.createNestedArray("log");
+  int count = stallLog.total < STALL_LOG_SIZE ? stallLog.total : STALL_LOG_SIZE;
+  for (int i = 0; i < count; i++) {
+    int index = ((int)stallLog.head - count + i + STALL_LOG_SIZE) % STALL_LOG_SIZE;
+    StallLogEntry& entry = stallLog.entries[index];
+    JsonObject e = entries.createNestedObject();
+    e["boot"] = entry.bootCount;
+    e["atMs"] = entry.uptimeMs;
+    e["phase"] = entry.phase < STALL_PHASE_COUNT ? stallPhaseNames[entry.phase] : "?";
+    e["durationMs"] = entry.durationMs;
+    e["site"] = String(entry.file) + ":" + String(entry.line);
+    e["state"] = stallEntryStateName(entry.state);
+  }
+}
@@ -0,0 +1,64 @@
+/**
+ * stall_monitor.h - Überwachung blockierender Abschnitte der loop()
+ *
+ * Jeder überwachte Abschnitt setzt beim Eintritt eine "aktuelle Phase"
+ * (STALL_PHASE, ein paar Speicherzugriffe). Ein esp_timer prüft alle
+ * STALL_CHECK_INTERVAL_MS, ob die Phase ihr Zeitbudget überschreitet, und trägt
+ * Phase, Dauer und Aufrufstelle in ein Stall-Log im RTC-Speicher ein.
+ *
+ * Das Log (RTC_NOINIT) übersteht Software-Neustarts, Watchdog-Resets und
+ * Abstürze, nicht aber einen Stromausfall. Einträge, die bis zum Neustart offen
+ * waren, werden beim Boot als "durch Reset beendet" markiert.
+ */
+#ifndef STALL_MONITOR_H
+#define STALL_MONITOR_H
+
+#include "config.h"
+
+// Überwachte Phasen (Budgets in stall_monitor.cpp aus config.h)
+enum StallPhase : uint8_t {
+  STALL_PHASE_NONE = 0,     // Keine Überwachung (z.B. zwischen zwei loop()-Durchläufen)
+  STALL_PHASE_LOOP,         // loop() außerhalb der Teilabschnitte
+  STALL_PHASE_TIMER,        // Aufgaben im Timer-Rad
+  STALL_PHASE_RX_PARSE,     // Empfang und Zerlegung
+  STALL_PHASE_RX_EXEC,      // Ausführung empfangener Telegramme
+  STALL_PHASE_TX,           // Senden mit CSMA/CD
+  STALL_PHASE_TOUCH,        // Touch-Verarbeitung
+  STALL_PHASE_DRAW,         // Menü zeichnen
+  STALL_PHASE_RESTART,      // Geplanter Neustart (SYS.RESET)
+  STALL_PHASE_CALIBRATION,  // Display-Kalibrierung (wartet auf Serial)
+  STALL_PHASE_COUNT
+};
+
+// Initialisiert das Log im RTC-Speicher und startet die Überwachung (esp_timer)
+void setupStallMonitor();
+
+// Gibt das Stall-Log auf Serial aus
+void printStallLog();
+
+// Löscht das Stall-Log
+void clearStallLog();
+
+// Stall-Log, Neustart-Grund und Boot-Zähler als JSON (für /api/status)
+void getStallStats(JsonObject obj);
+
+#if ENABLE_STALL_MONITOR == 1
+// Phase vom Konstruktor bis zum Verlassen des Blocks, danach äußere Phase fortsetzen
+// (die äußere Phase misst ab dann neu - gemeldet wird immer der innerste Abschnitt)
+class StallPhaseScope {
+public:
+  StallPhaseScope(StallPhase phase, const char* file, uint16_t line);
+  ~StallPhaseScope();
+
+private:
+  StallPhase prevPhase;
+  const char* prevFile;
+  uint16_t prevLine;
+};
+
+#define STALL_PHASE(phase) StallPhaseScope stallPhaseScope(phase, __FILE__, __LINE__)
+#else
+#define STALL_PHASE(phase)
+#endif
+
+#endif // STALL_MONITOR_H
@@ -0,0 +1,126 @@
+#include "Arduino.h"
+#include "SPI.h"
+#include "WiFi.h"
+#include "EEPROM.h"
+#include "SPIFFS.h"
+#include "LittleFS.h"
+#include <stdarg.h>
+#include <random>
+#include <string>
+
+HardwareSerial Serial(0);
+EspClass ESP;
+SPIClass SPI(VSPI);
+WiFiClass WiFi;
+EEPROMClass EEPROM;
+SPIFFSFS SPIFFS;
+LittleFSFS LittleFS;
+bool hostSerialEcho = false;
+
+static unsigned long hostMillisNow = 0;
+static unsigned long hostMicrosExtra = 0;   // Anteil unter einer Millisekunde
+static std::string hostSerialInput;
+static std::mt19937 hostRandom(1);
+
+unsigned long millis() {
+  return hostMillisNow;
+}
+
+unsigned long micros() {
+  return hostMillisNow * 1000UL + hostMicrosExtra;
+}
+
+void delay(unsigned long ms) {
+  hostAdvanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+  hostMicrosExtra += us;
+  hostMillisNow += hostMicrosExtra / 1000;
+  hostMicrosExtra %= 1000;
+}
+
+void yield() {}
+
+void hostSetMillis(unsigned long ms) {
+  hostMillisNow = ms;
+  hostMicrosExtra = 0;
+}
+
+void hostAdvanceMillis(unsigned long ms) {
+  hostMillisNow += ms;
+}
+
+long random(long howBig) {
+  if (howBig <= 0) return 0;
+  return (long)(hostRandom() % (unsigned long)howBig);
+}
+
+long random(long howSmall, long howBig) {
+  if (howSmall >= howBig) return howSmall;
+  return howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+  hostRandom.seed((unsigned int)seed);
+}
+
+// ===== SERIAL =====
+
+void hostSerialFeed(const char* input) {
+  hostSerialInput += input;
+}
+
+int HostStream::available() {
+  return this == &Serial ? (int)hostSerialInput.size() : 0;
+}
+
+int HostStream::read() {
+  if (this != &Serial || hostSerialInput.empty()) return -1;
+  int c = (unsigned char)hostSerialInput[0];
+  hostSerialInput.erase(0, 1);
+  return c;
+}
+
+int HostStream::peek() {
+  if (this != &Serial || hostSerialInput.empty()) return -1;
+  return (unsigned char)hostSerialInput[0];
+}
+
+size_t HostStream::write(uint8_t c) {
+  if (hostSerialEcho) fputc(c, stdout);
+  return 1;
+}
+
+size_t HostStream::write(const uint8_t* buf, size_t n) {
+  if (hostSerialEcho) fwrite(buf, 1, n, stdout);
+  return n;
+}
+
+size_t HostStream::printf(const char* fmt, ...) {
+  char buf[512];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write((const uint8_t*)buf, std::min<size_t>((size_t)n, sizeof(buf) - 1));
+}
+
+String HostStream::readStringUntil(char terminator) {
+  String result;
+  int c;
+  while ((c = read()) >= 0 && c != terminator) {
+    result += (char)c;
+  }
+  return result;
+}
+
+String HostStream::readString() {
+  String result;
+  int c;
+  while ((c = read()) >= 0) {
+    result += (char)c;
+  }
+  return result;
+}
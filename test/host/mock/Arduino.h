@@ -0,0 +1,289 @@
+/**
+ * Arduino.h (Host) - Minimaler Arduino-Ersatz für die Host-Tests
+ *
+ * Nur der Teil der Arduino-API, den die getesteten Module verwenden.
+ * Die Zeit ist simuliert: millis()/micros() laufen nur über hostSetMillis()/hostAdvanceMillis().
+ *
+ * Achtung: unsigned long ist auf dem Host 64 Bit breit (ESP32: 32 Bit).
+ * Überlauf-Tests laufen deshalb an der Grenze des Host-Typs (ULONG_MAX).
+ */
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define DEC 10
+#define HEX 16
+
+#define PI 3.1415926535897932384626433832795
+
+using std::min;
+using std::max;
+
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high) {
+  return value < (T)low ? (T)low : (value > (T)high ? (T)high : value);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ===== SIMULIERTE ZEIT =====
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);        // Rückt die simulierte Zeit vor
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void hostSetMillis(unsigned long ms);
+void hostAdvanceMillis(unsigned long ms);
+
+// ===== GPIO (ohne Wirkung) =====
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int digitalRead(int) { return LOW; }
+inline int analogRead(int) { return 0; }
+
+// PWM (Hintergrundbeleuchtung)
+inline bool ledcAttach(int, uint32_t, uint8_t) { return true; }
+inline bool ledcWrite(int, uint32_t) { return true; }
+
+// Flash-Konstanten liegen auf dem Host im RAM
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// ===== FreeRTOS (ein Task - kritische Abschnitte ohne Wirkung) =====
+
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// ===== STRING =====
+
+class String {
+public:
+  String() {}
+  String(const char* s) : s_(s ? s : "") {}
+  String(const std::string& s) : s_(s) {}
+  String(char c) : s_(1, c) {}
+  String(int v, int base = DEC) : s_(fmtInt((long)v, base)) {}
+  String(unsigned int v, int base = DEC) : s_(fmtUnsigned(v, base)) {}
+  String(long v, int base = DEC) : s_(fmtInt(v, base)) {}
+  String(unsigned long v, int base = DEC) : s_(fmtUnsigned(v, base)) {}
+  String(float v, int decimals = 2) : s_(fmtFloat(v, decimals)) {}
+  String(double v, int decimals = 2) : s_(fmtFloat(v, decimals)) {}
+
+  unsigned int length() const { return s_.size(); }
+  bool isEmpty() const { return s_.empty(); }
+  const char* c_str() const { return s_.c_str(); }
+  void reserve(unsigned int n) { s_.reserve(n); }
+
+  char charAt(unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+  void setCharAt(unsigned int i, char c) { if (i < s_.size()) s_[i] = c; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char& operator[](unsigned int i) { return s_[i]; }
+
+  int indexOf(char c, unsigned int from = 0) const { return pos(s_.find(c, from)); }
+  int indexOf(const String& s, unsigned int from = 0) const { return pos(s_.find(s.s_, from)); }
+  int lastIndexOf(char c) const { return pos(s_.rfind(c)); }
+  int lastIndexOf(const String& s) const { return pos(s_.rfind(s.s_)); }
+
+  String substring(unsigned int from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= s_.size()) return String();
+    return String(s_.substr(from, std::min<size_t>(to, s_.size()) - from));
+  }
+
+  bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  bool endsWith(const String& p) const {
+    return p.s_.size() <= s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+  }
+  bool equals(const String& o) const { return s_ == o.s_; }
+  bool equalsIgnoreCase(const String& o) const {
+    String a(*this), b(o);
+    a.toLowerCase();
+    b.toLowerCase();
+    return a.s_ == b.s_;
+  }
+  int compareTo(const String& o) const { return s_.compare(o.s_); }
+
+  long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(s_.c_str(), nullptr); }
+
+  void trim() {
+    size_t b = s_.find_first_not_of(" \t\r\n");
+    size_t e = s_.find_last_not_of(" \t\r\n");
+    s_ = (b == std::string::npos) ? std::string() : s_.substr(b, e - b + 1);
+  }
+  void toUpperCase() { for (auto& c : s_) c = toupper((unsigned char)c); }
+  void toLowerCase() { for (auto& c : s_) c = tolower((unsigned char)c); }
+  void replace(const String& from, const String& to) {
+    if (from.s_.empty()) return;
+    size_t p = 0;
+    while ((p = s_.find(from.s_, p)) != std::string::npos) {
+      s_.replace(p, from.s_.size(), to.s_);
+      p += to.s_.size();
+    }
+  }
+  void remove(unsigned int index) { if (index < s_.size()) s_.erase(index); }
+  void remove(unsigned int index, unsigned int count) { if (index < s_.size()) s_.erase(index, count); }
+
+  void toCharArray(char* buf, unsigned int size) const {
+    if (size == 0) return;
+    strncpy(buf, s_.c_str(), size - 1);
+    buf[size - 1] = 0;
+  }
+
+  bool concat(const String& o) { s_ += o.s_; return true; }
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* o) { s_ += o; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  String& operator+=(int v) { s_ += fmtInt(v, DEC); return *this; }
+  String& operator+=(unsigned int v) { s_ += fmtUnsigned(v, DEC); return *this; }
+  String& operator+=(long v) { s_ += fmtInt(v, DEC); return *this; }
+  String& operator+=(unsigned long v) { s_ += fmtUnsigned(v, DEC); return *this; }
+
+  friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String& a, const char* b) { return String(a.s_ + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.s_); }
+  friend String operator+(const String& a, char b) { return String(a.s_ + b); }
+  friend String operator+(const String& a, int b) { return a + String(b); }
+  friend String operator+(const String& a, unsigned int b) { return a + String(b); }
+  friend String operator+(const String& a, long b) { return a + String(b); }
+  friend String operator+(const String& a, unsigned long b) { return a + String(b); }
+  friend String operator+(const String& a, float b) { return a + String(b); }
+  friend String operator+(const String& a, double b) { return a + String(b); }
+
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* o) const { return s_ == (o ? o : ""); }
+  bool operator!=(const String& o) const { return s_ != o.s_; }
+  bool operator!=(const char* o) const { return !(*this == o); }
+  bool operator<(const String& o) const { return s_ < o.s_; }
+
+private:
+  std::string s_;
+
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  static std::string fmtInt(long v, int base) {
+    if (base == DEC || v >= 0) {
+      return base == DEC ? std::to_string(v) : fmtUnsigned((unsigned long)v, base);
+    }
+    return fmtUnsigned((unsigned long)v, base);
+  }
+  static std::string fmtUnsigned(unsigned long v, int base) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+    return buf;
+  }
+  static std::string fmtFloat(double v, int decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    return buf;
+  }
+};
+
+// ===== IPADDRESS =====
+
+class IPAddress {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : a(a), b(b), c(c), d(d) {}
+  String toString() const {
+    return String((int)a) + "." + String((int)b) + "." + String((int)c) + "." + String((int)d);
+  }
+  uint8_t a, b, c, d;
+};
+
+// ===== SERIAL =====
+
+// Ausgaben landen auf stdout, wenn hostSerialEcho gesetzt ist; Eingaben kommen aus hostSerialFeed()
+class HostStream {
+public:
+  void begin(unsigned long, ...) {}
+  void end() {}
+  int available();
+  int read();
+  int peek();
+  void flush() {}
+
+  size_t write(uint8_t c);
+  size_t write(const uint8_t* buf, size_t n);
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned int v, int base = DEC) { return print(String(v, base)); }
+  size_t print(long v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned long v, int base = DEC) { return print(String(v, base)); }
+  size_t print(double v, int decimals = 2) { return print(String(v, decimals)); }
+
+  size_t println() { return write("\n"); }
+  template <typename T>
+  size_t println(const T& v) { return print(v) + println(); }
+  template <typename T>
+  size_t println(const T& v, int fmt) { return print(v, fmt) + println(); }
+
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+  String readStringUntil(char terminator);
+  String readString();
+
+  operator bool() const { return true; }
+};
+
+class HardwareSerial : public HostStream {
+public:
+  explicit HardwareSerial(int uartNum = 0) : uart(uartNum) {}
+  void setRxBufferSize(size_t) {}
+  void setTxBufferSize(size_t) {}
+  void setPins(int, int, int = -1, int = -1) {}
+  int uart;
+};
+
+extern HardwareSerial Serial;
+
+extern bool hostSerialEcho;
+void hostSerialFeed(const char* input);
+
+// ===== ESP =====
+
+class EspClass {
+public:
+  uint32_t getFreeHeap() { return 200000; }
+  uint32_t getCycleCount() { return (uint32_t)(micros() * 240); }
+  void restart() {}
+};
+
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,31 @@
+// EEPROM.h (Host) - Speicher im RAM, zu Beginn gelöscht (0xFF)
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+
+class EEPROMClass {
+public:
+  bool begin(size_t size) {
+    memset(data, 0xFF, sizeof(data));
+    return size <= sizeof(data);
+  }
+  template <typename T>
+  T& get(int address, T& value) {
+    memcpy(&value, data + address, sizeof(T));
+    return value;
+  }
+  template <typename T>
+  const T& put(int address, const T& value) {
+    memcpy(data + address, &value, sizeof(T));
+    return value;
+  }
+  bool commit() { return true; }
+
+private:
+  uint8_t data[512];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
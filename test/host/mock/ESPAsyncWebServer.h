@@ -0,0 +1,14 @@
+// ESPAsyncWebServer.h (Host) - nur die Typen aus web_server_manager.h
+#ifndef HOST_ESPASYNCWEBSERVER_H
+#define HOST_ESPASYNCWEBSERVER_H
+
+#include "Arduino.h"
+
+class AsyncWebServerRequest {};
+
+class AsyncWebServer {
+public:
+  explicit AsyncWebServer(uint16_t port) {}
+};
+
+#endif // HOST_ESPASYNCWEBSERVER_H
@@ -0,0 +1,11 @@
+// FS.h (Host) - Dateisystem wird in den Host-Tests nicht benötigt
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include "Arduino.h"
+
+namespace fs {
+class FS {};
+}
+
+#endif // HOST_FS_H
@@ -0,0 +1,2 @@
+// HardwareSerial.h (Host) - HardwareSerial ist im Host-Arduino.h definiert
+#include "Arduino.h"
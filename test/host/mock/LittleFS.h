@@ -0,0 +1,16 @@
+// LittleFS.h (Host) - leeres Dateisystem
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+class LittleFSFS : public fs::FS {
+public:
+  bool begin(bool = false) { return true; }
+  size_t totalBytes() { return 0; }
+  size_t usedBytes() { return 0; }
+};
+
+extern LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,20 @@
+// SPI.h (Host) - SPI wird in den Host-Tests nicht benötigt
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+class SPIClass {
+public:
+  explicit SPIClass(int bus = 0) : bus(bus) {}
+  void begin(int = -1, int = -1, int = -1, int = -1) {}
+  void end() {}
+  int bus;
+};
+
+#define VSPI 3
+#define HSPI 2
+
+extern SPIClass SPI;
+
+#endif // HOST_SPI_H
@@ -0,0 +1,16 @@
+// SPIFFS.h (Host) - leeres Dateisystem
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include "FS.h"
+
+class SPIFFSFS : public fs::FS {
+public:
+  bool begin(bool = false) { return true; }
+  size_t totalBytes() { return 0; }
+  size_t usedBytes() { return 0; }
+};
+
+extern SPIFFSFS SPIFFS;
+
+#endif // HOST_SPIFFS_H
@@ -0,0 +1,510 @@
+#include "TFT_eSPI.h"
+
+HostTftStats hostTftStats;
+
+// Verschachtelungstiefe der Zeichenaufrufe - nur der äußerste wird gezählt
+static int hostTftCallDepth = 0;
+
+struct HostTftCall {
+  HostTftCall() {
+    if (hostTftCallDepth++ == 0) {
+      hostTftStats.primitives++;
+    }
+  }
+  ~HostTftCall() { hostTftCallDepth--; }
+};
+
+void hostTftResetStats() {
+  hostTftStats = { 0, 0, 0 };
+}
+
+// 5x7-Zeichen 0x20..0x7E, spaltenweise, Bit 0 oben
+static const uint8_t hostFont5x7[95][5] = {
+  { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 },
+  { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+  { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 }, { 0x00, 0x1C, 0x22, 0x41, 0x00 },
+  { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x14, 0x08, 0x3E, 0x08, 0x14 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+  { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x60, 0x60, 0x00, 0x00 },
+  { 0x20, 0x10, 0x08, 0x04, 0x02 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+  { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+  { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+  { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x36, 0x36, 0x00, 0x00 },
+  { 0x00, 0x56, 0x36, 0x00, 0x00 }, { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+  { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 }, { 0x32, 0x49, 0x79, 0x41, 0x3E },
+  { 0x7E, 0x11, 0x11, 0x11, 0x7E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+  { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+  { 0x3E, 0x41, 0x49, 0x49, 0x7A }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+  { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+  { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+  { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 },
+  { 0x46, 0x49, 0x49, 0x49, 0x31 }, { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+  { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, { 0x63, 0x14, 0x08, 0x14, 0x63 },
+  { 0x07, 0x08, 0x70, 0x08, 0x07 }, { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 },
+  { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, { 0x04, 0x02, 0x01, 0x02, 0x04 },
+  { 0x40, 0x40, 0x40, 0x40, 0x40 }, { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 },
+  { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 }, { 0x38, 0x44, 0x44, 0x48, 0x7F },
+  { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E },
+  { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x44, 0x3D, 0x00 },
+  { 0x7F, 0x10, 0x28, 0x44, 0x00 }, { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 },
+  { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, { 0x7C, 0x14, 0x14, 0x14, 0x08 },
+  { 0x08, 0x14, 0x14, 0x18, 0x7C }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 },
+  { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C },
+  { 0x3C, 0x40, 0x30, 0x40, 0x3C }, { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C },
+  { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, { 0x00, 0x00, 0x7F, 0x00, 0x00 },
+  { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x08, 0x04, 0x08, 0x10, 0x08 },
+};
+
+// Zellen der beiden Schriften (ohne Textgröße)
+static int hostFontAdvance(uint8_t font) {
+  return font == 2 ? 7 : 6;
+}
+
+static int hostFontCellHeight(uint8_t font) {
+  return font == 2 ? 16 : 8;
+}
+
+// Nächstes Zeichen; UTF-8-Folgen werden als ein (unbekanntes) Zeichen gezählt, Ergebnis 0
+static uint8_t hostNextChar(const char*& p) {
+  uint8_t c = (uint8_t)*p++;
+  if (c < 0x80) {
+    return c;
+  }
+  while (((uint8_t)*p & 0xC0) == 0x80) {
+    p++;
+  }
+  return 0;
+}
+
+static uint16_t hostSwap(uint16_t c) {
+  return (c >> 8) | (c << 8);
+}
+
+// ===== TFT_eSPI =====
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
+  : _width(w), _height(h), panelWidth(w), panelHeight(h) {
+  resetViewport();
+}
+
+TFT_eSPI::~TFT_eSPI() {
+  free(panel);
+}
+
+void TFT_eSPI::init(uint8_t tc) {
+  if (panel == nullptr) {
+    panel = (uint16_t*)calloc((size_t)panelWidth * panelHeight, sizeof(uint16_t));
+  }
+  setRotation(0);
+}
+
+void TFT_eSPI::setRotation(uint8_t r) {
+  rotation = r % 4;
+  bool portrait = rotation == 0 || rotation == 2;
+  _width = portrait ? panelWidth : panelHeight;
+  _height = portrait ? panelHeight : panelWidth;
+  resetViewport();
+}
+
+// Logische Koordinate → Index im Panel-Speicher (Zeilen der Rotation 0)
+size_t TFT_eSPI::panelIndex(int32_t x, int32_t y) const {
+  int32_t px, py;
+  switch (rotation) {
+    case 1:  px = panelWidth - 1 - y;  py = x;                      break;
+    case 2:  px = panelWidth - 1 - x;  py = panelHeight - 1 - y;    break;
+    case 3:  px = y;                   py = panelHeight - 1 - x;    break;
+    default: px = x;                   py = y;                      break;
+  }
+  return (size_t)py * panelWidth + px;
+}
+
+void TFT_eSPI::storeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  if (panel == nullptr) {
+    return;
+  }
+  for (int32_t row = y; row < y + h; row++) {
+    for (int32_t col = x; col < x + w; col++) {
+      panel[panelIndex(col, row)] = color;
+    }
+  }
+  hostTftStats.pixelsWritten += (uint64_t)w * h;
+  hostTftStats.panelPixels += (uint64_t)w * h;
+}
+
+void TFT_eSPI::storeRow(int32_t x, int32_t y, int32_t n, const uint16_t* swapped) {
+  if (panel == nullptr) {
+    return;
+  }
+  for (int32_t i = 0; i < n; i++) {
+    panel[panelIndex(x + i, y)] = hostSwap(swapped[i]);
+  }
+  hostTftStats.pixelsWritten += n;
+  hostTftStats.panelPixels += n;
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) {
+  if (panel == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) {
+    return 0;
+  }
+  return panel[panelIndex(x, y)];
+}
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool datum) {
+  // Auf den Bildschirm beschneiden
+  int32_t x1 = min<int32_t>(x + w, _width);
+  int32_t y1 = min<int32_t>(y + h, _height);
+  vpX = max<int32_t>(x, 0);
+  vpY = max<int32_t>(y, 0);
+  vpW = max<int32_t>(x1 - vpX, 0);
+  vpH = max<int32_t>(y1 - vpY, 0);
+  vpDatum = datum;
+}
+
+void TFT_eSPI::resetViewport() {
+  vpX = 0;
+  vpY = 0;
+  vpW = _width;
+  vpH = _height;
+  vpDatum = false;
+}
+
+void TFT_eSPI::rasterRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  if (vpDatum) {
+    x += vpX;
+    y += vpY;
+  }
+  int32_t x0 = max(x, vpX);
+  int32_t y0 = max(y, vpY);
+  int32_t x1 = min(x + w, vpX + vpW);
+  int32_t y1 = min(y + h, vpY + vpH);
+  if (x1 > x0 && y1 > y0) {
+    storeRect(x0, y0, x1 - x0, y1 - y0, color);
+  }
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  HostTftCall call;
+  rasterRect(x, y, 1, 1, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  HostTftCall call;
+  rasterRect(x, y, w, h, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  HostTftCall call;
+  rasterRect(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  HostTftCall call;
+  rasterRect(x, y, 1, h, color);
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+  HostTftCall call;
+  rasterRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  HostTftCall call;
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+// Bresenham, beide Endpunkte eingeschlossen
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  HostTftCall call;
+  if (y0 == y1) {
+    drawFastHLine(min(x0, x1), y0, abs(x1 - x0) + 1, color);
+    return;
+  }
+  if (x0 == x1) {
+    drawFastVLine(x0, min(y0, y1), abs(y1 - y0) + 1, color);
+    return;
+  }
+  int32_t dx = abs(x1 - x0);
+  int32_t dy = -abs(y1 - y0);
+  int32_t sx = x0 < x1 ? 1 : -1;
+  int32_t sy = y0 < y1 ? 1 : -1;
+  int32_t err = dx + dy;
+  while (true) {
+    drawPixel(x0, y0, color);
+    if (x0 == x1 && y0 == y1) {
+      break;
+    }
+    int32_t e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  HostTftCall call;
+  int32_t f = 1 - r;
+  int32_t ddx = 1;
+  int32_t ddy = -2 * r;
+  int32_t x = 0;
+  int32_t y = r;
+
+  drawPixel(x0, y0 + r, color);
+  drawPixel(x0, y0 - r, color);
+  drawPixel(x0 + r, y0, color);
+  drawPixel(x0 - r, y0, color);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddy += 2;
+      f += ddy;
+    }
+    x++;
+    ddx += 2;
+    f += ddx;
+    drawPixel(x0 + x, y0 + y, color);
+    drawPixel(x0 - x, y0 + y, color);
+    drawPixel(x0 + x, y0 - y, color);
+    drawPixel(x0 - x, y0 - y, color);
+    drawPixel(x0 + y, y0 + x, color);
+    drawPixel(x0 - y, y0 + x, color);
+    drawPixel(x0 + y, y0 - x, color);
+    drawPixel(x0 - y, y0 - x, color);
+  }
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  HostTftCall call;
+  int32_t f = 1 - r;
+  int32_t ddx = 1;
+  int32_t ddy = -2 * r;
+  int32_t x = 0;
+  int32_t y = r;
+
+  drawFastHLine(x0 - r, y0, 2 * r + 1, color);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddy += 2;
+      f += ddy;
+    }
+    x++;
+    ddx += 2;
+    f += ddx;
+    drawFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
+    drawFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
+    drawFastHLine(x0 - y, y0 + x, 2 * y + 1, color);
+    drawFastHLine(x0 - y, y0 - x, 2 * y + 1, color);
+  }
+}
+
+void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+  HostTftCall call;
+  int stride = (w + 7) / 8;
+  for (int row = 0; row < h; row++) {
+    for (int col = 0; col < w; col++) {
+      if (bitmap[row * stride + (col >> 3)] & (0x80 >> (col & 7))) {
+        drawPixel(x + col, y + row, color);
+      }
+    }
+  }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  HostTftCall call;
+  if (vpDatum) {
+    x += vpX;
+    y += vpY;
+  }
+  int32_t x0 = max(x, vpX);
+  int32_t x1 = min(x + w, vpX + vpW);
+  if (x1 <= x0) {
+    return;
+  }
+  for (int32_t row = max(y, vpY); row < min(y + h, vpY + vpH); row++) {
+    storeRow(x0, row, x1 - x0, data + (size_t)(row - y) * w + (x0 - x));
+  }
+}
+
+// ===== Text =====
+
+int16_t TFT_eSPI::textWidth(const char* text, uint8_t font) const {
+  int chars = 0;
+  const char* p = text;
+  while (*p) {
+    hostNextChar(p);
+    chars++;
+  }
+  return chars * hostFontAdvance(font) * textsize;
+}
+
+int16_t TFT_eSPI::fontHeight(uint8_t font) const {
+  return hostFontCellHeight(font) * textsize;
+}
+
+int16_t TFT_eSPI::drawText(const char* text, int32_t x, int32_t y, uint8_t font, uint8_t datum) {
+  HostTftCall call;
+  int16_t width = textWidth(text, font);
+  if (datum == TC_DATUM) {
+    x -= width / 2;
+  } else if (datum == TR_DATUM) {
+    x -= width;
+  }
+
+  int advance = hostFontAdvance(font) * textsize;
+  int cellHeight = hostFontCellHeight(font) * textsize;
+  int rowScale = (font == 2 ? 2 : 1) * textsize;   // Font 2: Zeilen doppelt
+  int rowOffset = (font == 2 ? 1 : 0) * textsize;
+  bool fillBackground = textcolor != textbgcolor;
+
+  const char* p = text;
+  while (*p) {
+    uint8_t c = hostNextChar(p);
+    if (fillBackground) {
+      rasterRect(x, y, advance, cellHeight, textbgcolor);
+    }
+    if (c >= 0x20 && c <= 0x7E) {
+      const uint8_t* glyph = hostFont5x7[c - 0x20];
+      for (int col = 0; col < 5; col++) {
+        for (int row = 0; row < 7; row++) {
+          if (glyph[col] & (1 << row)) {
+            rasterRect(x + col * textsize, y + rowOffset + row * rowScale, textsize, rowScale, textcolor);
+          }
+        }
+      }
+    }
+    x += advance;
+  }
+  return width;
+}
+
+int16_t TFT_eSPI::drawString(const char* text, int32_t x, int32_t y, uint8_t font) {
+  return drawText(text, x, y, font, textdatum);
+}
+
+int16_t TFT_eSPI::drawCentreString(const char* text, int32_t x, int32_t y, uint8_t font) {
+  return drawText(text, x, y, font, TC_DATUM);
+}
+
+int16_t TFT_eSPI::drawRightString(const char* text, int32_t x, int32_t y, uint8_t font) {
+  return drawText(text, x, y, font, TR_DATUM);
+}
+
+// ===== TFT_eSprite =====
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0), parent(tft) {}
+
+TFT_eSprite::~TFT_eSprite() {
+  deleteSprite();
+}
+
+void* TFT_eSprite::setColorDepth(int8_t bits) {
+  depth = (bits == 1) ? 1 : 16;
+  return buffer;
+}
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames) {
+  if (buffer != nullptr) {
+    return buffer;
+  }
+  bitStride = (w + 7) / 8;
+  size_t size = (depth == 1) ? (size_t)bitStride * h : (size_t)w * h * sizeof(uint16_t);
+  buffer = (uint8_t*)calloc(size > 0 ? size : 1, 1);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  _width = w;
+  _height = h;
+  resetViewport();
+  return buffer;
+}
+
+void TFT_eSprite::deleteSprite() {
+  free(buffer);
+  buffer = nullptr;
+  _width = 0;
+  _height = 0;
+  resetViewport();
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSprite::storeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  if (buffer == nullptr) {
+    return;
+  }
+  for (int32_t row = y; row < y + h; row++) {
+    for (int32_t col = x; col < x + w; col++) {
+      if (depth == 1) {
+        uint8_t mask = 0x80 >> (col & 7);
+        uint8_t& byte = buffer[row * bitStride + (col >> 3)];
+        byte = color ? (byte | mask) : (byte & ~mask);
+      } else {
+        ((uint16_t*)buffer)[row * _width + col] = hostSwap(color);
+      }
+    }
+  }
+  hostTftStats.pixelsWritten += (uint64_t)w * h;
+}
+
+void TFT_eSprite::storeRow(int32_t x, int32_t y, int32_t n, const uint16_t* swapped) {
+  if (buffer == nullptr) {
+    return;
+  }
+  if (depth == 1) {
+    for (int32_t i = 0; i < n; i++) {
+      storeRect(x + i, y, 1, 1, swapped[i] != 0);
+    }
+    return;
+  }
+  memcpy((uint16_t*)buffer + y * _width + x, swapped, n * sizeof(uint16_t));
+  hostTftStats.pixelsWritten += n;
+}
+
+uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y) {
+  if (buffer == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) {
+    return 0;
+  }
+  if (depth == 1) {
+    return (buffer[y * bitStride + (x >> 3)] & (0x80 >> (x & 7))) ? 1 : 0;
+  }
+  return hostSwap(((uint16_t*)buffer)[y * _width + x]);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+  if (buffer == nullptr || parent == nullptr || depth != 16) {
+    return;
+  }
+  parent->pushImage(x, y, _width, _height, (const uint16_t*)buffer);
+}
+
+// ===== PPM =====
+
+bool hostTftWritePpm(TFT_eSPI& gfx, const char* path) {
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  int w = gfx.width();
+  int h = gfx.height();
+  fprintf(file, "P6\n%d %d\n255\n", w, h);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      uint16_t c = gfx.readPixel(x, y);
+      uint8_t r = (c >> 11) & 0x1F;
+      uint8_t g = (c >> 5) & 0x3F;
+      uint8_t b = c & 0x1F;
+      uint8_t rgb[3] = { (uint8_t)((r << 3) | (r >> 2)), (uint8_t)((g << 2) | (g >> 4)), (uint8_t)((b << 3) | (b >> 2)) };
+      fwrite(rgb, 1, 3, file);
+    }
+  }
+  return fclose(file) == 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * TFT_eSPI.h (Host) - Rasterisierender Ersatz für den benutzten Teil von TFT_eSPI
+ *
+ * Zeichnet in einen RGB565-Bildspeicher mit der Geometrie des Panels (240 x 320, ST7789).
+ * setRotation() bildet die logischen Koordinaten auf den Speicher ab wie MADCTL auf dem Gerät;
+ * hostTftWritePpm() schreibt den Inhalt so, wie er in der aktuellen Rotation zu sehen ist.
+ *
+ * Sprites halten ihren Speicher wie die Bibliothek: 16 Bit byte-vertauscht (so wie die Pixel
+ * auf den Bus gehen), 1 Bit mit dem höchstwertigen Bit links. pushImage() erwartet deshalb auf
+ * dem Display wie im Sprite byte-vertauschte Daten (setSwapBytes(false), wie im Projekt).
+ *
+ * Schriften: Font 1 ist ein 5x7-Raster in einer 6 x 8 Zelle wie in der Bibliothek. Font 2
+ * (auf dem Gerät proportional, 16 Pixel hoch) wird durch dieselben Zeichen in doppelter Höhe
+ * ersetzt (Zelle 7 x 16) - Breiten weichen vom Gerät ab, die Bilder sind nur untereinander
+ * vergleichbar. Zeichen außerhalb von ASCII (UTF-8) bleiben leere Zellen.
+ *
+ * hostTftStats zählt Zeichenaufrufe (nur die äußersten - drawString zählt einmal, nicht jedes
+ * Pixel), geschriebene Pixel aller Ziele und die Pixel, die das Panel erreichen (SPI-Verkehr).
+ */
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+#include "Arduino.h"
+#include "SPI.h"
+
+#ifndef TFT_WIDTH
+#define TFT_WIDTH 240
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 320
+#endif
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+// Bezugspunkt für drawString (nur die obere Zeile wird benutzt)
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+
+struct HostTftStats {
+  uint32_t primitives;     // Zeichenaufrufe (äußerste)
+  uint64_t pixelsWritten;  // geschriebene Pixel aller Ziele nach dem Beschneiden (inkl. Überdeckung)
+  uint64_t panelPixels;    // davon auf dem Panel
+};
+
+extern HostTftStats hostTftStats;
+void hostTftResetStats();
+
+class TFT_eSPI {
+public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI();
+
+  void init(uint8_t tc = 0);
+  void begin(uint8_t tc = 0) { init(tc); }
+
+  void setRotation(uint8_t r);
+  uint8_t getRotation() const { return rotation; }
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+  // Virtuell wie in der Bibliothek
+  virtual void drawPixel(int32_t x, int32_t y, uint32_t color);
+  virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  virtual void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  virtual void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  virtual void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+  virtual uint16_t readPixel(int32_t x, int32_t y);
+
+  void fillScreen(uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+
+  void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr) {
+    pushImage(x, y, w, h, data);
+  }
+
+  // Text
+  void setTextColor(uint16_t color) { textcolor = textbgcolor = color; }
+  void setTextColor(uint16_t fg, uint16_t bg, bool bgfill = false) { textcolor = fg; textbgcolor = bg; }
+  void setTextSize(uint8_t size) { textsize = size > 0 ? size : 1; }
+  void setTextFont(uint8_t font) { textfont = font; }
+  void setTextDatum(uint8_t datum) { textdatum = datum; }
+  uint8_t getTextDatum() const { return textdatum; }
+
+  int16_t drawString(const char* text, int32_t x, int32_t y, uint8_t font);
+  int16_t drawString(const String& text, int32_t x, int32_t y, uint8_t font) { return drawString(text.c_str(), x, y, font); }
+  int16_t drawString(const char* text, int32_t x, int32_t y) { return drawString(text, x, y, textfont); }
+  int16_t drawString(const String& text, int32_t x, int32_t y) { return drawString(text.c_str(), x, y, textfont); }
+  int16_t drawCentreString(const char* text, int32_t x, int32_t y, uint8_t font);
+  int16_t drawCentreString(const String& text, int32_t x, int32_t y, uint8_t font) { return drawCentreString(text.c_str(), x, y, font); }
+  int16_t drawRightString(const char* text, int32_t x, int32_t y, uint8_t font);
+  int16_t drawRightString(const String& text, int32_t x, int32_t y, uint8_t font) { return drawRightString(text.c_str(), x, y, font); }
+
+  int16_t textWidth(const char* text, uint8_t font) const;
+  int16_t textWidth(const String& text, uint8_t font) const { return textWidth(text.c_str(), font); }
+  int16_t textWidth(const String& text) const { return textWidth(text.c_str(), textfont); }
+  int16_t fontHeight(uint8_t font) const;
+  int16_t fontHeight() const { return fontHeight(textfont); }
+
+  // Beschneiden (vpDatum: Koordinaten relativ zum Viewport)
+  void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
+  void resetViewport();
+
+  // Transaktionen und DMA - auf dem Host sofort ausgeführt
+  void startWrite() {}
+  void endWrite() {}
+  bool initDMA(bool ctrlCs = false) { return true; }
+  void dmaWait() {}
+  void setSwapBytes(bool swap) {}
+
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) const {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+
+protected:
+  // Schreibt ein bereits beschnittenes Rechteck bzw. eine Bildzeile (byte-vertauscht) in den Speicher
+  virtual void storeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  virtual void storeRow(int32_t x, int32_t y, int32_t n, const uint16_t* swapped);
+
+  // Füllt nach Viewport-Verschiebung und Beschneiden (ohne Zählung als Zeichenaufruf)
+  void rasterRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  int16_t drawText(const char* text, int32_t x, int32_t y, uint8_t font, uint8_t datum);
+
+  int16_t _width;
+  int16_t _height;
+  uint8_t rotation = 0;
+
+  int32_t vpX = 0, vpY = 0, vpW = 0, vpH = 0;
+  bool vpDatum = false;
+
+  uint16_t textcolor = TFT_WHITE;
+  uint16_t textbgcolor = TFT_WHITE;
+  uint8_t textsize = 1;
+  uint8_t textfont = 1;
+  uint8_t textdatum = TL_DATUM;
+
+private:
+  int16_t panelWidth;   // Speicher in Rotation 0
+  int16_t panelHeight;
+  uint16_t* panel = nullptr;
+
+  size_t panelIndex(int32_t x, int32_t y) const;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI* tft);
+  ~TFT_eSprite() override;
+
+  void* setColorDepth(int8_t bits);
+  int8_t getColorDepth() const { return depth; }
+  void* createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void deleteSprite();
+  bool created() const { return buffer != nullptr; }
+
+  void fillSprite(uint32_t color);
+  void pushSprite(int32_t x, int32_t y);
+  uint16_t readPixel(int32_t x, int32_t y) override;
+
+protected:
+  void storeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override;
+  void storeRow(int32_t x, int32_t y, int32_t n, const uint16_t* swapped) override;
+
+private:
+  TFT_eSPI* parent;
+  int8_t depth = 16;
+  uint8_t* buffer = nullptr;
+  int32_t bitStride = 0;   // Bytes pro Zeile bei 1 Bit
+};
+
+// Sichtbarer Inhalt (aktuelle Rotation) als PPM (P6, 8 Bit pro Kanal)
+bool hostTftWritePpm(TFT_eSPI& gfx, const char* path);
+
+#endif // HOST_TFT_ESPI_H
@@ -0,0 +1,20 @@
+// WiFi.h (Host) - Access Point ohne Funk
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+
+#define WIFI_OFF 0
+#define WIFI_AP 2
+
+class WiFiClass {
+public:
+  bool mode(int) { return true; }
+  bool softAP(const char*, const char* = nullptr, int = 1, int = 0, int = 4) { return true; }
+  bool softAPdisconnect(bool = false) { return true; }
+  IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,24 @@
+// XPT2046_Touchscreen.h (Host) - Touch ohne Berührung
+#ifndef HOST_XPT2046_TOUCHSCREEN_H
+#define HOST_XPT2046_TOUCHSCREEN_H
+
+#include "Arduino.h"
+#include "SPI.h"
+
+class TS_Point {
+public:
+  TS_Point(int16_t x = 0, int16_t y = 0, int16_t z = 0) : x(x), y(y), z(z) {}
+  int16_t x, y, z;
+};
+
+class XPT2046_Touchscreen {
+public:
+  XPT2046_Touchscreen(uint8_t csPin, uint8_t irqPin = 255) {}
+  bool begin(SPIClass& = SPI) { return true; }
+  void setRotation(uint8_t) {}
+  bool touched() { return false; }
+  bool tirqTouched() { return false; }
+  TS_Point getPoint() { return TS_Point(); }
+};
+
+#endif // HOST_XPT2046_TOUCHSCREEN_H
@@ -0,0 +1,346 @@
+/**
+ * test_timer_wheel.cpp - Host-Test für timer_wheel.cpp
+ *
+ * Jedes Szenario läuft als eigener Prozess (das Rad hat globalen Zustand ohne Reset):
+ *   test_timer_wheel wrap|cascade|cancel|drift|skip
+ *
+ * Die Zeit ist simuliert (hostSetMillis/hostAdvanceMillis). Ausführungszeitpunkte werden
+ * als wheelCurrentTick im Callback erfasst - das ist der Tick, für den die Aufgabe fällig war,
+ * auch wenn timerWheelDispatch() verspätet aufgerufen wurde.
+ */
+#include "timer_wheel.h"
+#include <vector>
+
+extern unsigned long wheelCurrentTick;
+extern unsigned long wheelTicksProcessed;
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+  if (!(cond)) { \
+    failures++; \
+    printf("FEHLER %s:%d: %s - ", __FILE__, __LINE__, #cond); \
+    printf(__VA_ARGS__); \
+    printf("\n"); \
+  } \
+} while (0)
+
+// Aufzeichnung der Ausführungen einer Aufgabe
+struct Probe {
+  int id = -1;
+  std::vector<unsigned long> ticks;
+  unsigned long deadline = 0;       // Erwartete nächste Fälligkeit
+  unsigned long period = 0;
+  bool pending = false;
+};
+
+static void recordRun(void* context) {
+  Probe* probe = (Probe*)context;
+  probe->ticks.push_back(wheelCurrentTick);
+  if (probe->period > 0) {
+    probe->deadline += probe->period;
+  } else {
+    probe->pending = false;
+  }
+}
+
+static void startProbe(Probe& probe, const char* name, unsigned long delayMs, unsigned long periodMs) {
+  if (probe.id < 0) {
+    probe.id = timerWheelRegister(name, recordRun, &probe);
+  }
+  probe.deadline = millis() + delayMs;
+  probe.period = periodMs;
+  probe.pending = true;
+  timerWheelStart(probe.id, delayMs, periodMs);
+}
+
+// Nächster Weckzeitpunkt darf nie nach der frühesten Fälligkeit liegen
+static void checkNextWake(const std::vector<Probe*>& probes) {
+  unsigned long now = millis();
+  unsigned long earliest = TIMER_WHEEL_NO_DEADLINE;
+  for (Probe* p : probes) {
+    if (!p->pending) continue;
+    unsigned long remaining = p->deadline - now;
+    if ((long)remaining < 0) remaining = 0;
+    earliest = std::min(earliest, remaining);
+  }
+  unsigned long wake = timerWheelNextWakeMs();
+  if (earliest == TIMER_WHEEL_NO_DEADLINE) {
+    CHECK(wake == TIMER_WHEEL_NO_DEADLINE, "Rad leer, nextWake=%lu", wake);
+  } else {
+    CHECK(wake <= earliest, "now=%lu nextWake=%lu frühestens=%lu", now, wake, earliest);
+  }
+}
+
+// Tick für Tick vorrücken, dabei nextWake prüfen
+static void stepTo(unsigned long target, const std::vector<Probe*>& probes) {
+  while ((long)(target - millis()) > 0) {
+    hostAdvanceMillis(1);
+    timerWheelDispatch();
+    checkNextWake(probes);
+  }
+}
+
+// ===== SZENARIEN =====
+
+// 32-Bit-Überlauf auf dem ESP32 - hier an der Grenze des Host-Typs (siehe mock/Arduino.h)
+static void testWrap() {
+  const unsigned long start = ULONG_MAX - 100;
+  hostSetMillis(start);
+
+  Probe oneShot, farShot, periodic;
+  startProbe(oneShot, "oneShot", 150, 0);     // Fällig nach dem Überlauf
+  startProbe(farShot, "farShot", 5000, 0);    // Ebene 1 → Umschichtung über den Überlauf
+  startProbe(periodic, "periodic", 10, 10);
+  std::vector<Probe*> probes = {&oneShot, &farShot, &periodic};
+
+  stepTo(start + 6000, probes);
+
+  CHECK(oneShot.ticks.size() == 1, "oneShot lief %zu mal", oneShot.ticks.size());
+  CHECK(!oneShot.ticks.empty() && oneShot.ticks[0] == start + 150,
+        "oneShot bei %lu statt %lu", oneShot.ticks.empty() ? 0 : oneShot.ticks[0], start + 150);
+  CHECK(farShot.ticks.size() == 1 && farShot.ticks[0] == start + 5000, "farShot falsch");
+  CHECK(periodic.ticks.size() == 600, "periodic lief %zu mal statt 600", periodic.ticks.size());
+  for (size_t i = 0; i < periodic.ticks.size(); i++) {
+    CHECK(periodic.ticks[i] == start + 10 * (i + 1), "periodic Lauf %zu bei %lu", i, periodic.ticks[i]);
+  }
+}
+
+// Umschichtung an den Ebenengrenzen (64, 4096) und jenseits der Reichweite (262143)
+static void testCascade() {
+  const unsigned long delays[] = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000, 600000};
+  const int count = sizeof(delays) / sizeof(delays[0]);
+
+  for (int pass = 0; pass < 2; pass++) {
+    // Pass 0: Tick für Tick, Pass 1: Dispatch in unregelmäßigen Sprüngen bis 5 s
+    unsigned long start = (pass == 0) ? 1000037UL : millis() + 37;
+    hostSetMillis(start);
+
+    static Probe probes[2][sizeof(delays) / sizeof(delays[0])];
+    std::vector<Probe*> list;
+    for (int i = 0; i < count; i++) {
+      startProbe(probes[pass][i], "cascade", delays[i], 0);
+      list.push_back(&probes[pass][i]);
+    }
+
+    if (pass == 0) {
+      stepTo(start + 600001, list);
+    } else {
+      while ((long)(start + 600001 - millis()) > 0) {
+        hostAdvanceMillis(1 + random(5000));
+        timerWheelDispatch();
+        checkNextWake(list);
+      }
+    }
+
+    for (int i = 0; i < count; i++) {
+      Probe& p = probes[pass][i];
+      CHECK(p.ticks.size() == 1, "Pass %d: Verzögerung %lu lief %zu mal", pass, delays[i], p.ticks.size());
+      CHECK(!p.ticks.empty() && p.ticks[0] == start + delays[i],
+            "Pass %d: Verzögerung %lu bei +%lu", pass, delays[i], p.ticks.empty() ? 0 : p.ticks[0] - start);
+    }
+  }
+}
+
+// Callbacks stoppen oder starten Aufgaben, die im selben Tick noch ausstehen
+struct CancelPair {
+  int self = -1;
+  int other = -1;
+  int runs = 0;
+  int mode = 0;     // 0 = anderen stoppen, 1 = anderen neu starten (+20 ms), wenn er noch nicht lief
+  CancelPair* peer = nullptr;
+  std::vector<unsigned long> ticks;
+};
+
+static void cancelOther(void* context) {
+  CancelPair* c = (CancelPair*)context;
+  c->runs++;
+  c->ticks.push_back(wheelCurrentTick);
+  if (c->mode == 0) {
+    timerWheelStop(c->other);
+  } else if (c->peer->runs == 0) {
+    timerWheelStart(c->other, 20);
+  }
+}
+
+static int selfStopRuns = 0;
+static int selfStopId = -1;
+
+static void stopSelf(void*) {
+  selfStopRuns++;
+  if (selfStopRuns == 3) {
+    timerWheelStop(selfStopId);
+  }
+}
+
+static int restartRuns = 0;
+static int restartId = -1;
+static std::vector<unsigned long> restartTicks;
+
+static void restartSelf(void*) {
+  restartRuns++;
+  restartTicks.push_back(wheelCurrentTick);
+  if (restartRuns < 3) {
+    timerWheelStart(restartId, 25);
+  }
+}
+
+static void testCancel() {
+  const unsigned long start = 5000;
+  hostSetMillis(start);
+
+  // Zwei Aufgaben im selben Tick, wer zuerst läuft, stoppt die andere
+  CancelPair a, b;
+  a.self = timerWheelRegister("stopA", cancelOther, &a);
+  b.self = timerWheelRegister("stopB", cancelOther, &b);
+  a.other = b.self;
+  b.other = a.self;
+  timerWheelStart(a.self, 10);
+  timerWheelStart(b.self, 10);
+
+  // Zwei Aufgaben im selben Tick, wer zuerst läuft, verschiebt die andere um 20 ms
+  CancelPair c, d;
+  c.mode = d.mode = 1;
+  c.self = timerWheelRegister("moveC", cancelOther, &c);
+  d.self = timerWheelRegister("moveD", cancelOther, &d);
+  c.other = d.self;
+  d.other = c.self;
+  c.peer = &d;
+  d.peer = &c;
+  timerWheelStart(c.self, 30);
+  timerWheelStart(d.self, 30);
+
+  // Periodisch, stoppt sich im dritten Lauf selbst
+  selfStopId = timerWheelRegister("selfStop", stopSelf);
+  timerWheelStart(selfStopId, 5, 5);
+
+  // Einmalig, startet sich im Callback zweimal neu
+  restartId = timerWheelRegister("restart", restartSelf);
+  timerWheelStart(restartId, 7);
+
+  // Einmalig, wird vor der Fälligkeit gestoppt
+  Probe stopped;
+  startProbe(stopped, "stopped", 40, 0);
+
+  for (int i = 0; i < 200; i++) {
+    hostAdvanceMillis(1);
+    if (millis() == start + 39) {
+      timerWheelStop(stopped.id);
+    }
+    timerWheelDispatch();
+  }
+
+  CHECK(a.runs + b.runs == 1, "gestoppte Aufgabe lief trotzdem (a=%d b=%d)", a.runs, b.runs);
+  CHECK(!timerWheelIsActive(a.self) && !timerWheelIsActive(b.self), "Aufgabe nach Stopp noch aktiv");
+
+  CancelPair& first = c.runs > 0 && c.ticks[0] == start + 30 ? c : d;
+  CancelPair& second = (&first == &c) ? d : c;
+  CHECK(first.runs == 1 && first.ticks[0] == start + 30, "verschiebende Aufgabe falsch");
+  CHECK(second.runs == 1 && second.ticks[0] == start + 50,
+        "verschobene Aufgabe lief %d mal, zuerst bei +%lu", second.runs,
+        second.ticks.empty() ? 0 : second.ticks[0] - start);
+
+  CHECK(selfStopRuns == 3, "selbst gestoppte Aufgabe lief %d mal", selfStopRuns);
+  CHECK(!timerWheelIsActive(selfStopId), "selbst gestoppte Aufgabe noch aktiv");
+
+  CHECK(restartRuns == 3, "Neustart im Callback: %d Läufe", restartRuns);
+  CHECK(restartTicks.size() == 3 && restartTicks[0] == start + 7 && restartTicks[1] == start + 32 &&
+        restartTicks[2] == start + 57, "Neustart im Callback zu falschen Zeiten");
+
+  CHECK(stopped.ticks.empty(), "gestoppte einmalige Aufgabe lief");
+  CHECK(timerWheelNextWakeMs() == TIMER_WHEEL_NO_DEADLINE, "Rad nicht leer");
+}
+
+// Periodische Aufgaben bleiben im Raster, auch wenn Dispatch unregelmäßig kommt;
+// nach einer Blockade wird nicht nachgeholt
+static void testDrift() {
+  const unsigned long start = 123456;
+  hostSetMillis(start);
+
+  Probe periodic;
+  startProbe(periodic, "periodic", 7, 7);
+
+  const int steps[] = {1, 3, 5, 2, 6};
+  int s = 0;
+  while ((long)(start + 70000 - millis()) > 0) {
+    hostAdvanceMillis(std::min<unsigned long>(steps[s++ % 5], start + 70000 - millis()));
+    timerWheelDispatch();
+  }
+
+  CHECK(periodic.ticks.size() == 10000, "%zu Läufe statt 10000", periodic.ticks.size());
+  for (size_t i = 0; i < periodic.ticks.size(); i++) {
+    if (periodic.ticks[i] != start + 7 * (i + 1)) {
+      CHECK(false, "Lauf %zu bei +%lu statt +%lu", i, periodic.ticks[i] - start, 7 * (i + 1));
+      break;
+    }
+  }
+
+  // Blockade über 14 Perioden: genau ein Lauf, danach Raster ab "jetzt"
+  size_t before = periodic.ticks.size();
+  hostAdvanceMillis(100);
+  unsigned long resume = millis();
+  timerWheelDispatch();
+  CHECK(periodic.ticks.size() == before + 1, "%zu Läufe nach Blockade statt 1", periodic.ticks.size() - before);
+
+  for (int i = 0; i < 21; i++) {
+    hostAdvanceMillis(1);
+    timerWheelDispatch();
+  }
+  CHECK(periodic.ticks.size() == before + 4, "Raster nach Blockade: %zu Läufe", periodic.ticks.size() - before);
+  CHECK(periodic.ticks.size() >= before + 2 && periodic.ticks[before + 1] == resume + 7,
+        "erster Lauf nach Blockade bei +%lu statt +7", periodic.ticks[before + 1] - resume);
+}
+
+// Leere Ticks werden übersprungen: ein Dispatch nach langer Pause arbeitet nur die
+// Umschichtungen (alle 64 ms) und die belegten Slots ab - Fälligkeiten bleiben exakt
+static void testSkip() {
+  const unsigned long start = 5000;
+  hostSetMillis(start);
+
+  Probe near, far, periodic;
+  startProbe(near, "near", 37, 0);
+  startProbe(far, "far", 9000, 0);
+  startProbe(periodic, "periodic", 500, 500);
+
+  unsigned long before = wheelTicksProcessed;
+  hostAdvanceMillis(10000);
+  timerWheelDispatch();
+  unsigned long processed = wheelTicksProcessed - before;
+
+  CHECK(near.ticks.size() == 1 && near.ticks[0] == start + 37, "near falsch");
+  CHECK(far.ticks.size() == 1 && far.ticks[0] == start + 9000, "far falsch");
+  // Nach der Blockade nur ein Lauf (kein Nachholen), zum ersten fälligen Tick
+  CHECK(periodic.ticks.size() == 1 && periodic.ticks[0] == start + 500, "periodic falsch");
+  CHECK(processed <= 10000 / 64 + 4, "%lu Ticks abgearbeitet für 10000 ms", processed);
+  CHECK(wheelCurrentTick == millis(), "Rad bei %lu statt %lu", wheelCurrentTick, millis());
+
+  // Danach wieder im Raster ab "jetzt"
+  unsigned long resume = millis();
+  for (int i = 0; i < 1000; i++) {
+    hostAdvanceMillis(1);
+    timerWheelDispatch();
+  }
+  CHECK(periodic.ticks.size() == 3 && periodic.ticks[1] == resume + 500 && periodic.ticks[2] == resume + 1000,
+        "periodic nach der Pause: %zu Läufe", periodic.ticks.size());
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("Aufruf: %s wrap|cascade|cancel|drift|skip\n", argv[0]);
+    return 2;
+  }
+
+  String scenario = argv[1];
+  if (scenario == "wrap") testWrap();
+  else if (scenario == "cascade") testCascade();
+  else if (scenario == "cancel") testCancel();
+  else if (scenario == "drift") testDrift();
+  else if (scenario == "skip") testSkip();
+  else {
+    printf("Unbekanntes Szenario: %s\n", argv[1]);
+    return 2;
+  }
+
+  printf("%s: %s (%d Fehler)\n", argv[1], failures ? "FEHLGESCHLAGEN" : "OK", failures);
+  return failures ? 1 : 0;
+}
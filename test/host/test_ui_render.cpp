@@ -0,0 +1,211 @@
+/**
+ * test_ui_render.cpp - Host-Test der Bildschirme in allen vier Rotationen
+ *
+ *   test_ui_render menu|header|service_manager|display_calibration [--update]
+ *   test_ui_render bench
+ *
+ * Jede Bildschirmfamilie wird in den Rotationen 0-3 in den Bildspeicher des TFT-Ersatzes
+ * (mock/TFT_eSPI) gezeichnet, als <familie>_r<rotation>.ppm ins Arbeitsverzeichnis
+ * geschrieben und Pixel für Pixel mit golden/<familie>_r<rotation>.ppm verglichen.
+ * --update schreibt die Referenzbilder neu (nach gewollten Änderungen der Darstellung).
+ *
+ * "bench" vergleicht nicht, sondern gibt pro Familie und Rotation Zeichenaufrufe,
+ * geschriebene Pixel (Sprites und Panel), Pixel auf dem Panel und die Überdeckung aus.
+ *
+ * Zeit und Device ID sind fest, damit Uhr und Kopfzeile in jedem Lauf gleich aussehen.
+ */
+#include "config.h"
+#include "menu.h"
+#include "header_display.h"
+#include "service_manager.h"
+#include "display_calibration.h"
+#include "ui_compositor.h"
+#include <string>
+#include <vector>
+
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "golden"
+#endif
+
+#define RENDER_START_MS 1000UL
+
+static int failures = 0;
+
+typedef void (*RenderFunction)(int rotation);
+
+struct Family {
+  const char* name;
+  RenderFunction render;
+};
+
+// Hauptmenü über den Compositor: Aufbau mit showMenu(), dann Beschriftungen mit
+// Icons und zwei aktive Taster (wie nach dem Laden der Konfiguration und ersten Telegrammen)
+static void renderMenu(int rotation) {
+  tft.setRotation(rotation);
+  showMenu();
+
+  static const char* labels[NUM_BUTTONS] = {
+    "Licht Küche", "Rolladen", "Heizung", "Lüftung", "Dimmer", "Taster 6"
+  };
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    buttons[i].label = labels[i];
+  }
+  uiMarkAllButtonsDirty(true);
+  setButtonActive(0, true);
+  setButtonActive(3, true);
+  uiRender(true);
+}
+
+// Kopfzeile allein auf dem Hintergrund des Menüs
+static void renderHeader(int rotation) {
+  tft.setRotation(rotation);
+  tft.fillScreen(TFT_WHITE);
+  paintHeader(tft);
+}
+
+// Service-Menü (zeichnet direkt, ohne Compositor)
+static void renderServiceManager(int rotation) {
+  tft.setRotation(rotation);
+  serviceManager.enterServiceMode();
+}
+
+// Testmuster der Display-Kalibrierung
+static void renderDisplayCalibration(int rotation) {
+  tft.setRotation(rotation);
+  drawTestPattern(rotation);
+}
+
+static const Family families[] = {
+  { "menu", renderMenu },
+  { "header", renderHeader },
+  { "service_manager", renderServiceManager },
+  { "display_calibration", renderDisplayCalibration },
+};
+
+// Zeichnet eine Familie in einer Rotation mit frischem Zähler und fester Zeit
+static void renderFamily(const Family& family, int rotation) {
+  hostSetMillis(RENDER_START_MS);
+  // Service-Modus der vorherigen Rotation beenden (zeichnet das Menü, nicht gezählt)
+  if (serviceManager.isServiceMode()) {
+    serviceManager.cancelServiceMode();
+  }
+  tft.fillScreen(TFT_BLACK);
+  hostTftResetStats();
+  family.render(rotation);
+}
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + n);
+  }
+  fclose(file);
+  return true;
+}
+
+// Vergleicht zwei PPM-Dateien gleicher Größe (Kopf und Pixel); Ergebnis: abweichende Pixel
+static long comparePpm(const std::vector<uint8_t>& actual, const std::vector<uint8_t>& golden) {
+  if (actual.size() != golden.size()) {
+    return -1;
+  }
+  size_t header = actual.size() - (size_t)tft.width() * tft.height() * 3;
+  if (memcmp(actual.data(), golden.data(), header) != 0) {
+    return -1;
+  }
+  long differing = 0;
+  for (size_t i = header; i < actual.size(); i += 3) {
+    if (memcmp(&actual[i], &golden[i], 3) != 0) {
+      differing++;
+    }
+  }
+  return differing;
+}
+
+static void checkFamily(const Family& family, bool update) {
+  for (int rotation = 0; rotation < 4; rotation++) {
+    renderFamily(family, rotation);
+
+    std::string name = std::string(family.name) + "_r" + std::to_string(rotation) + ".ppm";
+    std::string goldenPath = std::string(GOLDEN_DIR) + "/" + name;
+    std::string outPath = update ? goldenPath : name;
+    if (!hostTftWritePpm(tft, outPath.c_str())) {
+      failures++;
+      printf("FEHLER: %s nicht schreibbar\n", outPath.c_str());
+      continue;
+    }
+    if (update) {
+      printf("%s aktualisiert\n", goldenPath.c_str());
+      continue;
+    }
+
+    std::vector<uint8_t> actual, golden;
+    readFile(outPath, actual);
+    if (!readFile(goldenPath, golden)) {
+      failures++;
+      printf("FEHLER: Referenz %s fehlt (mit --update erzeugen)\n", goldenPath.c_str());
+      continue;
+    }
+    long differing = comparePpm(actual, golden);
+    if (differing < 0) {
+      failures++;
+      printf("FEHLER: %s - Bildgröße weicht von der Referenz ab\n", name.c_str());
+    } else if (differing > 0) {
+      failures++;
+      printf("FEHLER: %s - %ld Pixel weichen von der Referenz ab (Bild: %s)\n",
+             name.c_str(), differing, outPath.c_str());
+    }
+  }
+}
+
+static void bench() {
+  printf("%-20s %3s %10s %12s %12s %10s\n", "Familie", "Rot", "Aufrufe", "Pixel", "Panel-Pixel", "Überdeckung");
+  for (const Family& family : families) {
+    for (int rotation = 0; rotation < 4; rotation++) {
+      renderFamily(family, rotation);
+      double screen = (double)tft.width() * tft.height();
+      printf("%-20s %3d %10lu %12llu %12llu %10.2f\n", family.name, rotation,
+             (unsigned long)hostTftStats.primitives,
+             (unsigned long long)hostTftStats.pixelsWritten,
+             (unsigned long long)hostTftStats.panelPixels,
+             hostTftStats.pixelsWritten / screen);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("Aufruf: %s menu|header|service_manager|display_calibration [--update] | bench\n", argv[0]);
+    return 2;
+  }
+
+  tft.init();
+  setupHeaderDisplay();
+  setupUiCompositor();
+
+  String scenario = argv[1];
+  bool update = argc > 2 && String(argv[2]) == "--update";
+  if (scenario == "bench") {
+    bench();
+    return 0;
+  }
+
+  const Family* family = nullptr;
+  for (const Family& candidate : families) {
+    if (scenario == candidate.name) {
+      family = &candidate;
+    }
+  }
+  if (family == nullptr) {
+    printf("Unbekannte Familie: %s\n", argv[1]);
+    return 2;
+  }
+
+  checkFamily(*family, update);
+  printf("%s: %s (%d Fehler)\n", argv[1], failures ? "FEHLGESCHLAGEN" : "OK", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * ui_stubs.cpp - Ersatz für die Module, die die Bildschirme nur nebenbei benutzen
+ *
+ * Die Zeichenmodule (menu, header_display, label_cache, icons, ui_compositor,
+ * service_manager, display_calibration) werden unverändert übersetzt. Alles, was Bus,
+ * Touch, Empfang, Tracing oder Web betrifft, ist hier ohne Wirkung ersetzt - ein Task,
+ * Display immer hell, kein Touch, keine gespeicherte Button-Konfiguration.
+ */
+#include "config.h"
+#include "spi_bus.h"
+#include "touch.h"
+#include "trace.h"
+#include "stall_monitor.h"
+#include "profiler.h"
+#include "idle_manager.h"
+#include "backlight.h"
+#include "communication.h"
+#include "btn_latency.h"
+#include "report_scheduler.h"
+#include "config_manager.h"
+#include "web_server_manager.h"
+
+TFT_eSPI tft = TFT_eSPI();
+XPT2046_Touchscreen touchscreen(XPT2046_CS, XPT2046_IRQ);
+
+// ===== SPI-BUS =====
+
+void spiBusAcquire(SpiBusDevice device) {}
+void spiBusRelease(SpiBusDevice device) {}
+void spiBusCountBytes(SpiBusDevice device, uint32_t bytes) {}
+void spiBusYieldToTouch() {}
+
+// ===== TOUCH =====
+
+bool touchReadTouched() { return false; }
+void touchReadPoint(int* x, int* y) { *x = 0; *y = 0; }
+void touchCalibrationWizard() {}
+void testTouch() {}
+
+// ===== DIAGNOSE =====
+
+void traceRecord(TraceEventId id, char phase, uint16_t arg) {}
+StallPhaseScope::StallPhaseScope(StallPhase phase, const char* file, uint16_t line) {}
+StallPhaseScope::~StallPhaseScope() {}
+void profilerRecord(ProfilerSection section, uint32_t cycles) {}
+String getBtnLatencySummary() { return ""; }
+unsigned long getBtnLatencyCount() { return 0; }
+
+// ===== LOOP, BELEUCHTUNG, EMPFANG =====
+
+bool idleIsLoopTask() { return true; }
+void idleWakeFromTask() {}
+bool isDisplayDark() { return false; }
+bool isRxPending() { return false; }
+void processRxWorkQueue() {}
+void processTelegram(String telegramStr) {}
+void setRxBenchmarkMode(bool active) {}
+void setRxBenchmarkPending(bool pending) {}
+bool isButtonLocallyPressed(int buttonIndex) { return false; }
+void requestReportReschedule() {}
+
+// ===== KONFIGURATION UND WEB =====
+
+ConfigManager configManager;
+ConfigManager::ConfigManager() {}
+ConfigManager::~ConfigManager() {}
+
+ConverterWebService webConverter;
+ConverterWebService::ConverterWebService() {}
+bool ConverterWebService::loadButtons() { return false; }
+bool ConverterWebService::applyButtonsToDisplay() { return false; }
+
+WebServerManager webServerManager;
+WebServerManager::WebServerManager() : server(80), serverRunning(false) {}
+void WebServerManager::begin() {}
+void WebServerManager::stop() {}
+bool WebServerManager::isRunning() const { return false; }
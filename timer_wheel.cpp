@@ -0,0 +1,377 @@
+#include "timer_wheel.h"
+
+// Radgeometrie: 3 Ebenen à 64 Slots
+// Ebene 0: 1 ms pro Slot    (0 .. 63 ms)
+// Ebene 1: 64 ms pro Slot   (64 ms .. 4,1 s)
+// Ebene 2: 4096 ms pro Slot (4,1 s .. 262 s, weiter entfernte Aufgaben werden umgeschichtet)
+#define WHEEL_LEVELS 3
+#define WHEEL_SLOT_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_NO_TASK -1
+
+// Aufgabe im festen Pool
+struct TimerTask {
+  const char* name;
+  TimerCallback callback;
+  void* context;
+  unsigned long expires;      // Fälligkeit in Ticks (= millis())
+  unsigned long periodMs;     // 0 = einmalig
+  int8_t level;               // Ebene im Rad, -1 = nicht eingeplant
+  uint8_t slot;
+  int16_t next;               // Verkettung innerhalb eines Slots
+  int16_t prev;
+  bool firing;                // Im aktuellen Tick fällig, Callback steht noch aus
+
+  unsigned long runCount;
+  unsigned long maxRunUs;
+};
+
+TimerTask timerTasks[TIMER_WHEEL_MAX_TASKS];
+int timerTaskCount = 0;
+
+// Slot-Listen und Belegungs-Bitmaps pro Ebene
+int16_t wheelSlots[WHEEL_LEVELS][WHEEL_SLOTS];
+uint64_t wheelOccupancy[WHEEL_LEVELS];
+
+unsigned long wheelCurrentTick = 0;   // Zuletzt abgearbeiteter Tick
+bool wheelInitialized = false;
+
+// Statistik
+unsigned long wheelDispatchCalls = 0;
+unsigned long wheelTicksProcessed = 0;
+unsigned long wheelTasksRun = 0;
+unsigned long wheelMaxLagTicks = 0;
+
+void initTimerWheel() {
+  for (int l = 0; l < WHEEL_LEVELS; l++) {
+    for (int s = 0; s < WHEEL_SLOTS; s++) {
+      wheelSlots[l][s] = WHEEL_NO_TASK;
+    }
+    wheelOccupancy[l] = 0;
+  }
+  wheelCurrentTick = millis();
+  wheelInitialized = true;
+}
+
+// Aufgabe aus ihrem Slot entfernen
+void unlinkTask(int id) {
+  TimerTask& task = timerTasks[id];
+  if (task.level < 0) {
+    return;
+  }
+
+  if (task.prev != WHEEL_NO_TASK) {
+    timerTasks[task.prev].next = task.next;
+  } else {
+    wheelSlots[task.level][task.slot] = task.next;
+  }
+  if (task.next != WHEEL_NO_TASK) {
+    timerTasks[task.next].prev = task.prev;
+  }
+
+  if (wheelSlots[task.level][task.slot] == WHEEL_NO_TASK) {
+    wheelOccupancy[task.level] &= ~(1ULL << task.slot);
+  }
+
+  task.level = -1;
+  task.next = WHEEL_NO_TASK;
+  task.prev = WHEEL_NO_TASK;
+}
+
+// Aufgabe anhand ihrer Fälligkeit in die passende Ebene einsortieren
+// fromCascade: Aufruf beim Umschichten, bevor der aktuelle Tick abgearbeitet wird -
+// dann darf eine genau jetzt fällige Aufgabe noch in den aktuellen Slot
+void linkTask(int id, bool fromCascade = false) {
+  TimerTask& task = timerTasks[id];
+
+  // Überfällige Aufgaben im nächsten Tick ausführen
+  long remaining = (long)(task.expires - wheelCurrentTick);
+  if (remaining < 0 || (remaining == 0 && !fromCascade)) {
+    task.expires = wheelCurrentTick + 1;
+  }
+
+  unsigned long delta = task.expires - wheelCurrentTick;
+  unsigned long target = task.expires;
+  int level;
+
+  if (delta < (1UL << WHEEL_SLOT_BITS)) {
+    level = 0;
+  } else if (delta < (1UL << (2 * WHEEL_SLOT_BITS))) {
+    level = 1;
+  } else {
+    level = 2;
+    // Jenseits der Reichweite: in den letzten Slot, wird beim Umschichten neu einsortiert
+    unsigned long maxDelta = (1UL << (3 * WHEEL_SLOT_BITS)) - 1;
+    if (delta > maxDelta) {
+      target = wheelCurrentTick + maxDelta;
+    }
+  }
+
+  uint8_t slot = (target >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+
+  task.level = level;
+  task.slot = slot;
+  task.prev = WHEEL_NO_TASK;
+  task.next = wheelSlots[level][slot];
+  if (task.next != WHEEL_NO_TASK) {
+    timerTasks[task.next].prev = id;
+  }
+  wheelSlots[level][slot] = id;
+  wheelOccupancy[level] |= (1ULL << slot);
+}
+
+// Alle Aufgaben eines Slots einer höheren Ebene neu einsortieren
+void cascadeSlot(int level, int slot) {
+  int id = wheelSlots[level][slot];
+  wheelSlots[level][slot] = WHEEL_NO_TASK;
+  wheelOccupancy[level] &= ~(1ULL << slot);
+
+  while (id != WHEEL_NO_TASK) {
+    int nextId = timerTasks[id].next;
+    timerTasks[id].level = -1;
+    linkTask(id, true);
+    id = nextId;
+  }
+}
+
+// Aufgabe ausführen und ggf. periodisch neu einplanen
+void runTask(int id) {
+  TimerTask& task = timerTasks[id];
+
+  if (task.periodMs > 0) {
+    // Driftfrei weiterplanen, nach längerer Blockade aber nicht nachholen
+    // (Bezug ist die echte Zeit, nicht der gerade nachgeholte Tick)
+    unsigned long now = millis();
+    task.expires += task.periodMs;
+    if ((long)(task.expires - now) <= 0) {
+      task.expires = now + task.periodMs;
+    }
+    linkTask(id);
+  }
+
+  unsigned long startUs = micros();
+  task.callback(task.context);
+  unsigned long runUs = micros() - startUs;
+
+  task.runCount++;
+  if (runUs > task.maxRunUs) {
+    task.maxRunUs = runUs;
+  }
+  wheelTasksRun++;
+}
+
+// Einen Tick abarbeiten
+void processTick() {
+  wheelCurrentTick++;
+
+  // Beim Überlauf einer Ebene die nächsthöhere umschichten
+  int slot0 = wheelCurrentTick & WHEEL_SLOT_MASK;
+  if (slot0 == 0) {
+    int slot1 = (wheelCurrentTick >> WHEEL_SLOT_BITS) & WHEEL_SLOT_MASK;
+    if (slot1 == 0) {
+      cascadeSlot(2, (wheelCurrentTick >> (2 * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK);
+    }
+    cascadeSlot(1, slot1);
+  }
+
+  if (!(wheelOccupancy[0] & (1ULL << slot0))) {
+    return;
+  }
+
+  // Slot-Liste abtrennen und fällige Aufgaben merken - Callbacks dürfen
+  // Aufgaben (auch noch ausstehende dieses Ticks) neu starten oder stoppen
+  int dueIds[TIMER_WHEEL_MAX_TASKS];
+  int dueCount = 0;
+
+  int id = wheelSlots[0][slot0];
+  wheelSlots[0][slot0] = WHEEL_NO_TASK;
+  wheelOccupancy[0] &= ~(1ULL << slot0);
+
+  while (id != WHEEL_NO_TASK && dueCount < TIMER_WHEEL_MAX_TASKS) {
+    TimerTask& task = timerTasks[id];
+    int nextId = task.next;
+    task.level = -1;
+    task.next = WHEEL_NO_TASK;
+    task.prev = WHEEL_NO_TASK;
+    task.firing = true;
+    dueIds[dueCount++] = id;
+    id = nextId;
+  }
+
+  for (int i = 0; i < dueCount; i++) {
+    if (timerTasks[dueIds[i]].firing) {
+      timerTasks[dueIds[i]].firing = false;
+      runTask(dueIds[i]);
+    }
+  }
+}
+
+int timerWheelRegister(const char* name, TimerCallback callback, void* context) {
+  if (!wheelInitialized) {
+    initTimerWheel();
+  }
+
+  if (timerTaskCount >= TIMER_WHEEL_MAX_TASKS || callback == nullptr) {
+    Serial.print("FEHLER: Timer-Aufgabe konnte nicht registriert werden: ");
+    Serial.println(name);
+    return -1;
+  }
+
+  int id = timerTaskCount++;
+  TimerTask& task = timerTasks[id];
+  task.name = name;
+  task.callback = callback;
+  task.context = context;
+  task.expires = 0;
+  task.periodMs = 0;
+  task.level = -1;
+  task.slot = 0;
+  task.next = WHEEL_NO_TASK;
+  task.prev = WHEEL_NO_TASK;
+  task.firing = false;
+  task.runCount = 0;
+  task.maxRunUs = 0;
+
+  return id;
+}
+
+void timerWheelStart(int id, unsigned long delayMs, unsigned long periodMs) {
+  if (id < 0 || id >= timerTaskCount) {
+    return;
+  }
+
+  unlinkTask(id);
+  timerTasks[id].firing = false;
+
+  // Verzögerung relativ zu "jetzt", auch wenn das Rad noch Ticks nachzuholen hat
+  unsigned long now = millis();
+  TimerTask& task = timerTasks[id];
+  task.expires = now + delayMs;
+  task.periodMs = periodMs;
+  linkTask(id);
+}
+
+void timerWheelStop(int id) {
+  if (id < 0 || id >= timerTaskCount) {
+    return;
+  }
+  unlinkTask(id);
+  timerTasks[id].firing = false;
+}
+
+bool timerWheelIsActive(int id) {
+  if (id < 0 || id >= timerTaskCount) {
+    return false;
+  }
+  return timerTasks[id].level >= 0 || timerTasks[id].firing;
+}
+
+int timerWheelAddPeriodic(const char* name, unsigned long periodMs, TimerCallback callback,
+                          void* context, long firstDelayMs) {
+  int id = timerWheelRegister(name, callback, context);
+  if (id >= 0) {
+    timerWheelStart(id, firstDelayMs < 0 ? periodMs : (unsigned long)firstDelayMs, periodMs);
+  }
+  return id;
+}
+
+// Abstand (in Slots) zum nächsten belegten Slot nach "from", 0 wenn keiner belegt
+int nextOccupiedDistance(uint64_t occupancy, int from) {
+  if (occupancy == 0) {
+    return 0;
+  }
+  // Bitmap so rotieren, dass Bit 0 dem Slot nach "from" entspricht
+  int start = (from + 1) & WHEEL_SLOT_MASK;
+  uint64_t rotated = (occupancy >> start) | (start ? (occupancy << (WHEEL_SLOTS - start)) : 0);
+  return __builtin_ctzll(rotated) + 1;
+}
+
+void timerWheelDispatch() {
+  if (!wheelInitialized) {
+    initTimerWheel();
+  }
+
+  unsigned long now = millis();
+  unsigned long lag = now - wheelCurrentTick;
+
+  wheelDispatchCalls++;
+  if (lag > wheelMaxLagTicks) {
+    wheelMaxLagTicks = lag;
+  }
+
+  while ((long)(now - wheelCurrentTick) > 0) {
+    // Leere Slots der Ebene 0 überspringen: bis zum nächsten belegten Slot, höchstens
+    // bis zur nächsten Umschichtung (Slot 0) und nicht über "jetzt" hinaus
+    int slot0 = wheelCurrentTick & WHEEL_SLOT_MASK;
+    unsigned long step = WHEEL_SLOTS - slot0;
+    int d0 = nextOccupiedDistance(wheelOccupancy[0], slot0);
+    if (d0 > 0 && (unsigned long)d0 < step) {
+      step = d0;
+    }
+    if (step > now - wheelCurrentTick) {
+      step = now - wheelCurrentTick;
+    }
+    wheelCurrentTick += step - 1;
+
+    processTick();
+    wheelTicksProcessed++;
+  }
+}
+
+unsigned long timerWheelNextWakeMs() {
+  if (!wheelInitialized) {
+    return TIMER_WHEEL_NO_DEADLINE;
+  }
+
+  unsigned long best = TIMER_WHEEL_NO_DEADLINE;
+  unsigned long pending = millis() - wheelCurrentTick;  // Noch nicht abgearbeitete Ticks
+
+  // Ebene 0: exakter Zeitpunkt
+  int slot0 = wheelCurrentTick & WHEEL_SLOT_MASK;
+  int d0 = nextOccupiedDistance(wheelOccupancy[0], slot0);
+  if (d0 > 0) {
+    best = d0;
+  }
+
+  // Höhere Ebenen: Zeitpunkt der Umschichtung (frühestmögliche Fälligkeit)
+  for (int level = 1; level < WHEEL_LEVELS; level++) {
+    int shift = level * WHEEL_SLOT_BITS;
+    int current = (wheelCurrentTick >> shift) & WHEEL_SLOT_MASK;
+    int d = nextOccupiedDistance(wheelOccupancy[level], current);
+    if (d == 0) continue;
+
+    unsigned long ticksPerSlot = 1UL << shift;
+    unsigned long intoSlot = wheelCurrentTick & (ticksPerSlot - 1);
+    unsigned long wake = (unsigned long)(d - 1) * ticksPerSlot + (ticksPerSlot - intoSlot);
+    if (wake < best) {
+      best = wake;
+    }
+  }
+
+  if (best == TIMER_WHEEL_NO_DEADLINE) {
+    return best;
+  }
+  return (best > pending) ? best - pending : 0;
+}
+
+void getTimerWheelStats(JsonObject obj) {
+  obj["dispatchCalls"] = wheelDispatchCalls;
+  obj["ticks"] = wheelTicksProcessed;
+  obj["tasksRun"] = wheelTasksRun;
+  obj["maxLagMs"] = wheelMaxLagTicks;
+  unsigned long nextWake = timerWheelNextWakeMs();
+  if (nextWake != TIMER_WHEEL_NO_DEADLINE) {
+    obj["nextWakeMs"] = nextWake;
+  }
+
+  JsonArray tasks = obj.createNestedArray("tasks");
+  for (int i = 0; i < timerTaskCount; i++) {
+    JsonObject t = tasks.createNestedObject();
+    t["name"] = timerTasks[i].name;
+    t["active"] = timerTasks[i].level >= 0;
+    t["periodMs"] = timerTasks[i].periodMs;
+    t["runs"] = timerTasks[i].runCount;
+    t["maxRunUs"] = timerTasks[i].maxRunUs;
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * timer_wheel.h - Hierarchisches Timer-Rad für kooperatives Scheduling
+ *
+ * Ersetzt die verstreuten "millis() - lastX > intervall" Abfragen in loop():
+ * - Subsysteme registrieren periodische oder einmalige Aufgaben
+ * - 3 Ebenen à 64 Slots (1 ms / 64 ms / 4096 ms Auflösung)
+ * - Ausführung fälliger Aufgaben in O(1) pro Tick
+ * - Belegungs-Bitmaps liefern den nächsten Weckzeitpunkt (für Schlafphasen)
+ *
+ * Alle Callbacks laufen im loop()-Kontext (timerWheelDispatch), nie im Interrupt.
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "config.h"
+
+// Callback einer Aufgabe, context wird bei der Registrierung übergeben
+typedef void (*TimerCallback)(void* context);
+
+// Rückgabe von timerWheelNextWakeMs(), wenn keine Aufgabe eingeplant ist
+#define TIMER_WHEEL_NO_DEADLINE 0xFFFFFFFFUL
+
+/**
+ * Registriert eine Aufgabe (zunächst inaktiv)
+ *
+ * @param name          Name für Statistik/Debug
+ * @param callback      Aufzurufende Funktion
+ * @param context       Beliebiger Zeiger, wird an den Callback übergeben
+ * @return Aufgaben-ID oder -1 wenn der Pool (TIMER_WHEEL_MAX_TASKS) voll ist
+ */
+int timerWheelRegister(const char* name, TimerCallback callback, void* context = nullptr);
+
+/**
+ * Startet (oder startet neu) eine registrierte Aufgabe
+ *
+ * @param id            Aufgaben-ID
+ * @param delayMs       Verzögerung bis zur ersten Ausführung
+ * @param periodMs      Periode für Wiederholungen, 0 = einmalig
+ */
+void timerWheelStart(int id, unsigned long delayMs, unsigned long periodMs = 0);
+
+/**
+ * Stoppt eine Aufgabe (bleibt registriert und kann neu gestartet werden)
+ */
+void timerWheelStop(int id);
+
+/**
+ * Prüft, ob eine Aufgabe aktuell eingeplant ist
+ */
+bool timerWheelIsActive(int id);
+
+/**
+ * Registriert und startet eine periodische Aufgabe
+ *
+ * @param name          Name für Statistik/Debug
+ * @param periodMs      Periode in Millisekunden
+ * @param callback      Aufzurufende Funktion
+ * @param context       Wird an den Callback übergeben
+ * @param firstDelayMs  Verzögerung bis zur ersten Ausführung (Standard: eine Periode)
+ * @return Aufgaben-ID oder -1
+ */
+int timerWheelAddPeriodic(const char* name, unsigned long periodMs, TimerCallback callback,
+                          void* context = nullptr, long firstDelayMs = -1);
+
+/**
+ * Führt alle seit dem letzten Aufruf fälligen Aufgaben aus
+ * Muss regelmäßig in der loop() aufgerufen werden
+ */
+void timerWheelDispatch();
+
+/**
+ * Zeit bis zur nächsten möglicherweise fälligen Aufgabe
+ * Kann zu früh sein (Umschichtung aus höheren Ebenen), aber nie zu spät.
+ *
+ * @return Millisekunden bis zum nächsten Weckzeitpunkt (TIMER_WHEEL_NO_DEADLINE wenn leer)
+ */
+unsigned long timerWheelNextWakeMs();
+
+/**
+ * Schreibt Aufgaben und Laufzeit-Statistik in ein JSON-Objekt (für /api/status)
+ */
+void getTimerWheelStats(JsonObject obj);
+
+#endif // TIMER_WHEEL_H
@@ -2,6 +2,10 @@
 #include "menu.h"
 #include "backlight.h"
 #include "communication.h"
+#include "timer_wheel.h"
+#include "btn_latency.h"
+#include "trace.h"
+#include "spi_bus.h"
 
 // Touchscreen-Objekt
 SPIClass touchscreenSPI = SPIClass(HSPI);
@@ -11,6 +15,32 @@ XPT2046_Touchscreen touchscreen(XPT2046_CS, XPT2046_IRQ);
 bool invertTouchX = true;  // Standardmäßig invertiert
 bool invertTouchY = false;  // Standardmäßig invertiert
 
+// *** NEU: Touch-Zustandsmaschine ***
+enum TouchState {
+  TOUCH_STATE_IDLE,      // Kein Finger
+  TOUCH_STATE_SETTLING,  // IRQ erkannt, Entprellzeit läuft
+  TOUCH_STATE_ACTIVE     // Finger liegt auf, Abtastung mit fester Rate
+};
+
+TouchState touchState = TOUCH_STATE_IDLE;
+unsigned long touchSettleStart = 0;
+unsigned long touchLastSample = 0;
+
+// Statistik: loop()-Durchläufe (= pollTouch-Aufrufe) mit und ohne Finger
+unsigned long touchPollsIdle = 0;
+unsigned long touchPollsActive = 0;
+unsigned long touchTimeActiveMs = 0;
+unsigned long touchSamples = 0;
+unsigned long touchStatsStart = 0;
+unsigned long touchActiveSince = 0;
+
+// *** NEU: Zwischen zwei Display-Bändern vorab gelesene Abtastung (siehe spi_bus.h) ***
+bool touchPrefetchValid = false;
+bool touchPrefetchTouched = false;
+int touchPrefetchX = 0;
+int touchPrefetchY = 0;
+unsigned long touchPrefetchCount = 0;
+
 // Initialisiert den Touchscreen
 void setupTouch() {
   touchscreenSPI.begin(XPT2046_CLK, XPT2046_MISO, XPT2046_MOSI, XPT2046_CS);
@@ -83,6 +113,7 @@ void getTouchPoint(int *x, int *y) {
 
 // Zeichnet ein Kalibrierungskreuz
 void drawCalibrationPoint(int x, int y, uint16_t color) {
+  SPI_BUS_SCOPE(SPI_BUS_DISPLAY);
   // Größeres und besser sichtbares Kreuz zeichnen
   tft.drawLine(x - 15, y, x + 15, y, color);
   tft.drawLine(x, y - 15, x, y + 15, color);
@@ -129,8 +160,140 @@ void drawCalibrationPoint(int x, int y, uint16_t color) {
   }
 }
 
+// *** NEU: SPI-Zugriffe auf den Touch-Controller über den gemeinsamen Bus ***
+bool touchReadTouched() {
+  SPI_BUS_SCOPE(SPI_BUS_TOUCH);
+  return touchscreen.touched();
+}
+
+void touchReadPoint(int *x, int *y) {
+  SPI_BUS_SCOPE(SPI_BUS_TOUCH);
+  getTouchPoint(x, y);
+}
+
+TS_Point touchReadRawPoint() {
+  SPI_BUS_SCOPE(SPI_BUS_TOUCH);
+  return touchscreen.getPoint();
+}
+
+bool touchSampleDue() {
+  return touchState == TOUCH_STATE_ACTIVE && !touchPrefetchValid &&
+         millis() - touchLastSample >= TOUCH_SAMPLE_INTERVAL_MS;
+}
+
+void touchPrefetchSample() {
+  SPI_BUS_SCOPE(SPI_BUS_TOUCH);
+  touchLastSample = millis();
+  touchPrefetchTouched = touchscreen.touched();
+  if (touchPrefetchTouched) {
+    getTouchPoint(&touchPrefetchX, &touchPrefetchY);
+  }
+  touchPrefetchValid = true;
+  touchPrefetchCount++;
+}
+
+// Wechsel in den Leerlauf inkl. Zeiterfassung für die Loop-Rate
+void enterTouchIdle() {
+  if (touchState == TOUCH_STATE_ACTIVE) {
+    TRACE_INSTANT(TRACE_TOUCH_UP, 0);
+  }
+  if (touchState != TOUCH_STATE_IDLE) {
+    touchTimeActiveMs += millis() - touchActiveSince;
+  }
+  touchState = TOUCH_STATE_IDLE;
+}
+
+TouchPollResult pollTouch(int *x, int *y) {
+  unsigned long now = millis();
+  if (touchStatsStart == 0) {
+    touchStatsStart = now;
+  }
+
+  switch (touchState) {
+    case TOUCH_STATE_IDLE:
+      touchPollsIdle++;
+      // IRQ-Flag ist billig - SPI-Abfrage nur wenn der Controller etwas meldet
+      if (touchscreen.tirqTouched() && touchReadTouched()) {
+        btnLatencyMarkTouch();
+        touchState = TOUCH_STATE_SETTLING;
+        touchSettleStart = now;
+        touchActiveSince = now;
+        return TOUCH_POLL_NONE;
+      }
+      return TOUCH_POLL_RELEASED;
+
+    case TOUCH_STATE_SETTLING:
+      touchPollsActive++;
+      if (now - touchSettleStart < TOUCH_SETTLE_MS) {
+        return TOUCH_POLL_NONE;
+      }
+      // Entprellzeit vorbei - Finger noch da?
+      if (!touchReadTouched()) {
+        enterTouchIdle();
+        return TOUCH_POLL_RELEASED;
+      }
+      btnLatencyMarkDebounced();
+      TRACE_INSTANT(TRACE_TOUCH_DOWN, 0);
+      touchState = TOUCH_STATE_ACTIVE;
+      touchLastSample = now;
+      touchSamples++;
+      touchReadPoint(x, y);
+      return TOUCH_POLL_PRESSED;
+
+    case TOUCH_STATE_ACTIVE:
+      touchPollsActive++;
+      // *** NEU: Abtastung wurde bereits zwischen zwei Display-Bändern gelesen ***
+      if (touchPrefetchValid) {
+        touchPrefetchValid = false;
+        if (!touchPrefetchTouched) {
+          enterTouchIdle();
+          return TOUCH_POLL_RELEASED;
+        }
+        touchSamples++;
+        *x = touchPrefetchX;
+        *y = touchPrefetchY;
+        return TOUCH_POLL_PRESSED;
+      }
+      if (now - touchLastSample < TOUCH_SAMPLE_INTERVAL_MS) {
+        return TOUCH_POLL_NONE;
+      }
+      touchLastSample = now;
+      if (!touchReadTouched()) {
+        enterTouchIdle();
+        return TOUCH_POLL_RELEASED;
+      }
+      touchSamples++;
+      touchReadPoint(x, y);
+      return TOUCH_POLL_PRESSED;
+  }
+
+  return TOUCH_POLL_NONE;
+}
+
+bool isTouchIdle() {
+  return touchState == TOUCH_STATE_IDLE && !touchscreen.tirqTouched();
+}
+
+void getTouchStats(JsonObject obj) {
+  unsigned long now = millis();
+  unsigned long activeMs = touchTimeActiveMs;
+  if (touchState != TOUCH_STATE_IDLE) {
+    activeMs += now - touchActiveSince;
+  }
+  unsigned long idleMs = (now - touchStatsStart) - activeMs;
+
+  obj["samples"] = touchSamples;
+  obj["touchedMs"] = activeMs;
+  obj["sampleHz"] = activeMs > 0 ? (touchSamples * 1000.0f / activeMs) : 0;
+  obj["prefetchedSamples"] = touchPrefetchCount;
+  obj["loopHzTouched"] = activeMs > 0 ? (touchPollsActive * 1000.0f / activeMs) : 0;
+  obj["loopHzIdle"] = idleMs > 0 ? (touchPollsIdle * 1000.0f / idleMs) : 0;
+}
+
 // Testfunktion für die Kalibrierung der Touch-Koordinaten
 void testTouch() {
+  // Gezeichnet wird direkt (ohne Compositor) - jeder Block belegt den Bus selbst
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   tft.drawCentreString("Touch-Kalibrierungstest", SCREEN_WIDTH/2, 10, 2);
@@ -167,6 +330,7 @@ void testTouch() {
   tft.fillRect(50, 5, 40, 25, TFT_MAROON);
   tft.setTextColor(TFT_WHITE);
   tft.drawCentreString("BL-", 70, 12, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   delay(500);
   
@@ -174,22 +338,19 @@ void testTouch() {
   int lastX = -1, lastY = -1;
   
   // Anzeige der aktuellen Kalibrierungswerte
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   tft.drawString("InvertX: " + String(invertTouchX ? "JA" : "NEIN"), 10, SCREEN_HEIGHT - 70, 1);
   tft.drawString("InvertY: " + String(invertTouchY ? "JA" : "NEIN"), 10, SCREEN_HEIGHT - 55, 1);
   tft.drawString("Backlight: " + String(currentBacklight) + "%", 10, SCREEN_HEIGHT - 40, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   while (testMode) {
-    // Prüfen, ob ein Statusupdate für die Hintergrundbeleuchtung fällig ist
-    unsigned long currentMillis = millis();
-    // *** KORRIGIERT: Konstante direkt verwenden ***
-    if (currentMillis - lastBacklightStatusTime >= 23000) {  // BACKLIGHT_STATUS_INTERVAL = 23000
-      sendBacklightStatus();
-      lastBacklightStatusTime = currentMillis;
-    }
+    // Timer-Rad auch im Testmodus weiterlaufen lassen (Statusmeldungen, Sendepuffer)
+    timerWheelDispatch();
     
-    if (touchscreen.tirqTouched() && touchscreen.touched()) {
-      TS_Point p = touchscreen.getPoint();
+    if (touchscreen.tirqTouched() && touchReadTouched()) {
+      TS_Point p = touchReadRawPoint();
       int x, y;
       
       // Manuelle Kalibrierung zum Testen verschiedener Konfigurationen
@@ -235,11 +396,13 @@ void testTouch() {
       if (x >= SCREEN_WIDTH - 130 && x <= SCREEN_WIDTH - 70 && y >= 5 && y <= 30) {
         invertTouchX = !invertTouchX;
         // Aktualisiere Anzeigetext
+        spiBusAcquire(SPI_BUS_DISPLAY);
         tft.fillRect(0, SCREEN_HEIGHT - 70, 150, 40, TFT_WHITE);
         tft.setTextColor(TFT_BLACK, TFT_WHITE);
         tft.drawString("InvertX: " + String(invertTouchX ? "JA" : "NEIN"), 10, SCREEN_HEIGHT - 70, 1);
         tft.drawString("InvertY: " + String(invertTouchY ? "JA" : "NEIN"), 10, SCREEN_HEIGHT - 55, 1);
         tft.drawString("Backlight: " + String(currentBacklight) + "%", 10, SCREEN_HEIGHT - 40, 1);
+        spiBusRelease(SPI_BUS_DISPLAY);
         
         delay(200);
         continue;
@@ -249,11 +412,13 @@ void testTouch() {
       if (x >= SCREEN_WIDTH - 130 && x <= SCREEN_WIDTH - 70 && y >= 35 && y <= 60) {
         invertTouchY = !invertTouchY;
         // Aktualisiere Anzeigetext
+        spiBusAcquire(SPI_BUS_DISPLAY);
         tft.fillRect(0, SCREEN_HEIGHT - 70, 150, 40, TFT_WHITE);
         tft.setTextColor(TFT_BLACK, TFT_WHITE);
         tft.drawString("InvertX: " + String(invertTouchX ? "JA" : "NEIN"), 10, SCREEN_HEIGHT - 70, 1);
         tft.drawString("InvertY: " + String(invertTouchY ? "JA" : "NEIN"), 10, SCREEN_HEIGHT - 55, 1);
         tft.drawString("Backlight: " + String(currentBacklight) + "%", 10, SCREEN_HEIGHT - 40, 1);
+        spiBusRelease(SPI_BUS_DISPLAY);
         
         delay(200);
         continue;
@@ -264,9 +429,11 @@ void testTouch() {
         // Erhöhe Hintergrundbeleuchtung um 10%
         setBacklight(currentBacklight + 10);
         // Aktualisiere Anzeigetext
+        spiBusAcquire(SPI_BUS_DISPLAY);
         tft.fillRect(0, SCREEN_HEIGHT - 40, 150, 20, TFT_WHITE);
         tft.setTextColor(TFT_BLACK, TFT_WHITE);
         tft.drawString("Backlight: " + String(currentBacklight) + "%", 10, SCREEN_HEIGHT - 40, 1);
+        spiBusRelease(SPI_BUS_DISPLAY);
         
         sendBacklightStatus();
         delay(200);
@@ -278,9 +445,11 @@ void testTouch() {
         // Verringere Hintergrundbeleuchtung um 10%
         setBacklight(currentBacklight - 10);
         // Aktualisiere Anzeigetext
+        spiBusAcquire(SPI_BUS_DISPLAY);
         tft.fillRect(0, SCREEN_HEIGHT - 40, 150, 20, TFT_WHITE);
         tft.setTextColor(TFT_BLACK, TFT_WHITE);
         tft.drawString("Backlight: " + String(currentBacklight) + "%", 10, SCREEN_HEIGHT - 40, 1);
+        spiBusRelease(SPI_BUS_DISPLAY);
         
         sendBacklightStatus();
         delay(200);
@@ -289,6 +458,7 @@ void testTouch() {
       
       // Nur zeichnen, wenn sich die Position geändert hat
       if (x != lastX || y != lastY) {
+        spiBusAcquire(SPI_BUS_DISPLAY);
         // Position ausgeben
         tft.fillRect(10, SCREEN_HEIGHT - 20, SCREEN_WIDTH - 20, 20, TFT_WHITE);
         tft.setTextColor(TFT_BLACK, TFT_WHITE);
@@ -303,6 +473,7 @@ void testTouch() {
         
         // Position markieren
         tft.fillCircle(x, y, 5, TFT_RED);
+        spiBusRelease(SPI_BUS_DISPLAY);
         
         lastX = x;
         lastY = y;
@@ -324,6 +495,7 @@ void testTouch() {
 }
 
 void touchCalibrationWizard() {
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   tft.drawCentreString("TOUCH-KALIBRIERUNG", SCREEN_WIDTH/2, 10, 2);
@@ -383,10 +555,11 @@ void touchCalibrationWizard() {
   tft.setTextColor(TFT_BLACK, TFT_WHITE);
   tft.drawString("Aktueller Modus: " + String(touchMode), 10, 120, 1);
   tft.drawString("Berühren Sie die Kreuze zum Testen", 10, 140, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   while (testActive) {
-    if (touchscreen.tirqTouched() && touchscreen.touched()) {
-      TS_Point rawTouch = touchscreen.getPoint();
+    if (touchscreen.tirqTouched() && touchReadTouched()) {
+      TS_Point rawTouch = touchReadRawPoint();
       int mappedX, mappedY;
       
       // Verschiedene Touch-Modi testen
@@ -422,9 +595,11 @@ void touchCalibrationWizard() {
         }
         
         // Update Modus-Anzeige
+        spiBusAcquire(SPI_BUS_DISPLAY);
         tft.fillRect(10, 120, 200, 15, TFT_WHITE);
         tft.setTextColor(TFT_BLACK);
         tft.drawString("Aktueller Modus: " + String(touchMode), 10, 120, 1);
+        spiBusRelease(SPI_BUS_DISPLAY);
       }
       
       // Exit-Button
@@ -434,6 +609,7 @@ void touchCalibrationWizard() {
       }
       
       // Zeige Touch-Position
+      spiBusAcquire(SPI_BUS_DISPLAY);
       tft.fillRect(10, 160, SCREEN_WIDTH-20, 60, TFT_WHITE);
       tft.setTextColor(TFT_BLACK);
       tft.drawString("Raw: X=" + String(rawTouch.x) + " Y=" + String(rawTouch.y), 10, 165, 1);
@@ -461,11 +637,12 @@ void touchCalibrationWizard() {
       
       // Visueller Touch-Punkt
       tft.fillCircle(mappedX, mappedY, 3, TFT_BLACK);
+      spiBusRelease(SPI_BUS_DISPLAY);
       
       delay(100);
       
       // Warten bis Touch losgelassen
-      while (touchscreen.touched()) {
+      while (touchReadTouched()) {
         delay(10);
       }
     }
@@ -473,6 +650,7 @@ void touchCalibrationWizard() {
   }
   
   // Zeige Empfehlung
+  spiBusAcquire(SPI_BUS_DISPLAY);
   tft.fillScreen(TFT_WHITE);
   tft.setTextColor(TFT_BLACK);
   tft.drawCentreString("KALIBRIERUNG ABGESCHLOSSEN", SCREEN_WIDTH/2, 50, 2);
@@ -493,9 +671,10 @@ void touchCalibrationWizard() {
   
   tft.drawCentreString(recommendation, SCREEN_WIDTH/2, 110, 1);
   tft.drawCentreString("Touch zum Fortfahren...", SCREEN_WIDTH/2, 140, 1);
+  spiBusRelease(SPI_BUS_DISPLAY);
   
   // Warten auf Touch
-  while (!touchscreen.tirqTouched() || !touchscreen.touched()) {
+  while (!touchscreen.tirqTouched() || !touchReadTouched()) {
     delay(100);
   }
   
@@ -9,6 +9,36 @@ void setupTouch();
 // Touchscreen-Koordinaten zu kalibrierten Display-Koordinaten konvertieren
 void getTouchPoint(int *x, int *y);
 
+// *** NEU: Nicht-blockierende Touch-Entprellung ***
+// Ergebnis von pollTouch() - einmal pro loop()-Durchlauf aufrufen
+enum TouchPollResult {
+  TOUCH_POLL_NONE,       // Nichts zu tun (Entprellung läuft oder nächste Abtastung noch nicht fällig)
+  TOUCH_POLL_PRESSED,    // Finger liegt auf, x/y sind gültig
+  TOUCH_POLL_RELEASED    // Kein Finger auf dem Display
+};
+
+// Touch-Zustandsmaschine: IRQ → Entprellzeit (TOUCH_SETTLE_MS) → Abtastung
+// alle TOUCH_SAMPLE_INTERVAL_MS → Loslassen. Ersetzt delay(50) in loop().
+TouchPollResult pollTouch(int *x, int *y);
+
+// Kein Finger auf dem Display und kein unbearbeiteter IRQ (für den Leerlauf)
+bool isTouchIdle();
+
+// *** NEU: Abtastung zwischen zwei Display-Bändern (gemeinsamer SPI-Bus) ***
+// Finger liegt auf und die nächste Abtastung ist fällig
+bool touchSampleDue();
+
+// Liest die Abtastung vorab - pollTouch() übernimmt sie ohne erneuten SPI-Zugriff
+void touchPrefetchSample();
+
+// *** NEU: Einzelne Touch-Lesezugriffe über den gemeinsamen Bus (für Test- und Kalibrier-Bildschirme) ***
+bool touchReadTouched();
+void touchReadPoint(int *x, int *y);    // kalibriert (getTouchPoint)
+TS_Point touchReadRawPoint();           // Rohwerte des XPT2046
+
+// Loop-Rate mit/ohne Touch als JSON (für /api/status)
+void getTouchStats(JsonObject obj);
+
 // Testfunktion für die Kalibrierung der Touch-Koordinaten
 void testTouch();
 
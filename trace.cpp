@@ -0,0 +1,267 @@
+#include "trace.h"
+#include "timer_wheel.h"
+#include <SPIFFS.h>
+
+// Ein Eintrag im Ringpuffer (8 Byte)
+struct TraceEvent {
+  uint32_t tsUs;
+  uint8_t id;
+  char phase;
+  uint16_t arg;
+};
+
+// Spuren (tid) im Trace-Viewer - je Kategorie eine Zeile
+enum TraceTrack : uint8_t {
+  TRACK_COMM = 1,
+  TRACK_TOUCH,
+  TRACK_UI,
+  TRACK_WEB,
+  TRACK_STORAGE
+};
+
+const char* traceTrackNames[] = { "", "comm", "touch", "ui", "web", "storage" };
+
+struct TraceEventInfo {
+  const char* name;
+  TraceTrack track;
+};
+
+const TraceEventInfo traceEventInfo[TRACE_EVENT_COUNT] = {
+  { "rxFrame",     TRACK_COMM },
+  { "rxExec",      TRACK_COMM },
+  { "tx",          TRACK_COMM },
+  { "collision",   TRACK_COMM },
+  { "txDropped",   TRACK_COMM },
+  { "touchDown",   TRACK_TOUCH },
+  { "touchUp",     TRACK_TOUCH },
+  { "menuDraw",    TRACK_UI },
+  { "buttonDraw",  TRACK_UI },
+  { "headerDraw",  TRACK_UI },
+  { "apiStatus",   TRACK_WEB },
+  { "serveFile",   TRACK_WEB },
+  { "saveConfig",  TRACK_WEB },
+  { "eepromSave",  TRACK_STORAGE },
+  { "buttonsSave", TRACK_STORAGE }
+};
+
+#if ENABLE_EVENT_TRACE == 1
+  #if (TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) != 0
+    #error "TRACE_BUFFER_SIZE muss eine Zweierpotenz sein"
+  #endif
+
+  TraceEvent traceBuffer[TRACE_BUFFER_SIZE];
+#endif
+
+// Fortlaufender Schreibindex (Web-Handler laufen in einem eigenen Task → atomar)
+uint32_t traceWriteIndex = 0;
+
+// Ein Export: eingefrorene Kopie des Ringpuffers und Lesefortschritt
+// Gehört dem Aufrufer (Web-Antwort oder processTraceSave), es gibt keinen gemeinsamen Export-Zustand
+struct TraceExport {
+  TraceEvent* events;
+  uint32_t count;
+  int32_t pos;                      // -1 = Kopfzeile noch nicht geschrieben
+  char line[160];
+  size_t lineLen;
+  size_t lineOffset;
+};
+
+// Gleichzeitig offene Exporte (Web-Task und Loop, daher atomar)
+uint32_t traceExportsOpen = 0;
+uint32_t traceExportsRejected = 0;
+
+// Verzögerte Speicherung (Anforderung aus dem Web-Task, Ausführung im loop()-Kontext)
+volatile bool traceSavePending = false;
+
+void traceRecord(TraceEventId id, char phase, uint16_t arg) {
+  #if ENABLE_EVENT_TRACE == 1
+    uint32_t index = __atomic_fetch_add(&traceWriteIndex, 1, __ATOMIC_RELAXED);
+    TraceEvent& e = traceBuffer[index & (TRACE_BUFFER_SIZE - 1)];
+    e.tsUs = micros();
+    e.id = id;
+    e.phase = phase;
+    e.arg = arg;
+  #endif
+}
+
+void traceClear() {
+  __atomic_store_n(&traceWriteIndex, 0, __ATOMIC_RELAXED);
+}
+
+void traceExportEnd(TraceExport* exp) {
+  if (exp == nullptr) {
+    return;
+  }
+  free(exp->events);
+  free(exp);
+  __atomic_fetch_sub(&traceExportsOpen, 1, __ATOMIC_RELAXED);
+}
+
+TraceExport* traceExportBegin(TraceExportResult* result) {
+  TraceExportResult status = TRACE_EXPORT_OK;
+  TraceExport* exp = nullptr;
+
+  // Platz reservieren, bevor kopiert wird (begrenzt den Speicher für Kopien)
+  if (__atomic_add_fetch(&traceExportsOpen, 1, __ATOMIC_RELAXED) > TRACE_MAX_EXPORTS) {
+    __atomic_fetch_sub(&traceExportsOpen, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&traceExportsRejected, 1, __ATOMIC_RELAXED);
+    status = TRACE_EXPORT_BUSY;
+  } else {
+    exp = (TraceExport*)calloc(1, sizeof(TraceExport));
+    if (exp == nullptr) {
+      status = TRACE_EXPORT_NO_MEMORY;
+    } else {
+      exp->pos = -1;
+
+      #if ENABLE_EVENT_TRACE == 1
+        uint32_t writeIndex = __atomic_load_n(&traceWriteIndex, __ATOMIC_RELAXED);
+        uint32_t count = writeIndex < TRACE_BUFFER_SIZE ? writeIndex : TRACE_BUFFER_SIZE;
+        if (count > 0) {
+          exp->events = (TraceEvent*)malloc(count * sizeof(TraceEvent));
+          if (exp->events == nullptr) {
+            free(exp);
+            exp = nullptr;
+            status = TRACE_EXPORT_NO_MEMORY;
+          } else {
+            // Älteste zuerst kopieren
+            uint32_t first = writeIndex - count;
+            for (uint32_t i = 0; i < count; i++) {
+              exp->events[i] = traceBuffer[(first + i) & (TRACE_BUFFER_SIZE - 1)];
+            }
+            exp->count = count;
+          }
+        }
+      #endif
+    }
+    if (exp == nullptr) {
+      __atomic_fetch_sub(&traceExportsOpen, 1, __ATOMIC_RELAXED);
+    }
+  }
+
+  if (result != nullptr) {
+    *result = status;
+  }
+  return exp;
+}
+
+// Erzeugt die nächste JSON-Zeile des Exports in exp->line
+// @return false wenn der Export vollständig ist
+bool traceExportNextLine(TraceExport* exp) {
+  int len = 0;
+
+  if (exp->pos == -1) {
+    // Kopf mit Spur-Namen für Perfetto / chrome://tracing
+    len = snprintf(exp->line, sizeof(exp->line),
+                   "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                   "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ESP32 CYD\"}}");
+  } else if (exp->pos < TRACK_STORAGE) {
+    // Positionen 0..4: Namen der Spuren 1..5
+    int track = exp->pos + 1;
+    len = snprintf(exp->line, sizeof(exp->line),
+                   ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                   track, traceTrackNames[track]);
+  } else {
+    uint32_t i = exp->pos - TRACK_STORAGE;
+    if (i < exp->count) {
+      const TraceEvent& e = exp->events[i];
+      const TraceEventInfo& info = traceEventInfo[e.id < TRACE_EVENT_COUNT ? e.id : 0];
+      // Zeit relativ zum ältesten Eintrag (32-Bit-Überlauf von micros() kompensiert)
+      uint32_t ts = e.tsUs - exp->events[0].tsUs;
+      len = snprintf(exp->line, sizeof(exp->line),
+                     ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%d%s,\"args\":{\"v\":%u}}",
+                     info.name, traceTrackNames[info.track], e.phase, (unsigned long)ts,
+                     info.track, e.phase == 'i' ? ",\"s\":\"t\"" : "", e.arg);
+    } else if (i == exp->count) {
+      len = snprintf(exp->line, sizeof(exp->line), "\n]}\n");
+    } else {
+      return false;
+    }
+  }
+
+  exp->pos++;
+  exp->lineLen = (len > 0) ? min((size_t)len, sizeof(exp->line) - 1) : 0;
+  exp->lineOffset = 0;
+  return true;
+}
+
+size_t traceExportRead(TraceExport* exp, uint8_t* buffer, size_t maxLen) {
+  if (exp == nullptr) {
+    return 0;
+  }
+
+  size_t written = 0;
+  while (written < maxLen) {
+    if (exp->lineOffset >= exp->lineLen && !traceExportNextLine(exp)) {
+      break;
+    }
+    size_t chunk = min(maxLen - written, exp->lineLen - exp->lineOffset);
+    memcpy(buffer + written, exp->line + exp->lineOffset, chunk);
+    exp->lineOffset += chunk;
+    written += chunk;
+  }
+  return written;
+}
+
+void traceRequestSave() {
+  traceSavePending = true;
+}
+
+// Schreibt /trace.json ins SPIFFS (aus dem Timer-Rad, nicht im Web-Task)
+void processTraceSave() {
+  if (!traceSavePending) {
+    return;
+  }
+
+  // Eigene Kopie - ein gleichzeitiger Download im Web-Task hat seine eigene
+  TraceExportResult result;
+  TraceExport* exp = traceExportBegin(&result);
+  if (result == TRACE_EXPORT_BUSY) {
+    return;  // Später erneut versuchen, bis ein Download fertig ist
+  }
+  traceSavePending = false;
+  if (exp == nullptr) {
+    Serial.println("FEHLER: Kein Speicher für Trace-Export");
+    return;
+  }
+
+  File file = SPIFFS.open("/trace.json", "w");
+  if (!file) {
+    Serial.println("FEHLER: /trace.json konnte nicht geöffnet werden");
+    traceExportEnd(exp);
+    return;
+  }
+
+  uint8_t chunk[512];
+  size_t total = 0;
+  size_t len;
+  while ((len = traceExportRead(exp, chunk, sizeof(chunk))) > 0) {
+    file.write(chunk, len);
+    total += len;
+  }
+  file.close();
+  traceExportEnd(exp);
+
+  Serial.print("Trace gespeichert: /trace.json (");
+  Serial.print(total);
+  Serial.println(" Bytes)");
+}
+
+void setupTrace() {
+  traceClear();
+  timerWheelAddPeriodic("traceSave", TRACE_SAVE_CHECK_INTERVAL, [](void*) { processTraceSave(); });
+}
+
+void getTraceStats(JsonObject obj) {
+  uint32_t writeIndex = __atomic_load_n(&traceWriteIndex, __ATOMIC_RELAXED);
+  #if ENABLE_EVENT_TRACE == 1
+    obj["enabled"] = true;
+    obj["capacity"] = TRACE_BUFFER_SIZE;
+    obj["buffered"] = writeIndex < TRACE_BUFFER_SIZE ? writeIndex : TRACE_BUFFER_SIZE;
+    obj["overwritten"] = writeIndex > TRACE_BUFFER_SIZE ? writeIndex - TRACE_BUFFER_SIZE : 0;
+  #else
+    obj["enabled"] = false;
+  #endif
+  obj["recorded"] = writeIndex;
+  obj["exportsOpen"] = __atomic_load_n(&traceExportsOpen, __ATOMIC_RELAXED);
+  obj["exportsRejected"] = __atomic_load_n(&traceExportsRejected, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,100 @@
+/**
+ * trace.h - Ereignis-Ringpuffer mit Export im Chrome-Trace-Format
+ *
+ * Zeichnet Beginn/Ende/Einzel-Ereignisse aus Kommunikation, Touch,
+ * Menü-Darstellung, Web-Handlern und Speicherung in einem festen Ringpuffer
+ * im RAM auf (TRACE_BUFFER_SIZE Einträge à 8 Byte, älteste werden überschrieben).
+ *
+ * Export als Chrome trace_event JSON:
+ * - GET  /api/trace       → direkt in Perfetto / chrome://tracing öffnen
+ * - POST /api/trace/save  → schreibt /trace.json ins SPIFFS
+ *
+ * Ein Eintrag kostet einen micros()-Aufruf und einen atomaren Index-Zugriff,
+ * die Aufzeichnung kann daher im Betrieb eingeschaltet bleiben (ENABLE_EVENT_TRACE).
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "config.h"
+
+// Aufgezeichnete Ereignisse (Namen und Kategorien in trace.cpp)
+enum TraceEventId : uint8_t {
+  TRACE_RX_FRAME = 0,   // comm: Telegramm empfangen und zerlegt
+  TRACE_RX_EXEC,        // comm: Telegramm ausgeführt
+  TRACE_TX,             // comm: Senden mit CSMA/CD
+  TRACE_TX_COLLISION,   // comm: Kollision erkannt
+  TRACE_TX_DROPPED,     // comm: Telegramm verworfen (Puffer voll / Ratenbegrenzung / Versuche)
+  TRACE_TOUCH_DOWN,     // touch: Berührung nach Entprellung
+  TRACE_TOUCH_UP,       // touch: Finger losgelassen
+  TRACE_MENU_DRAW,      // ui: Hauptmenü komplett gezeichnet
+  TRACE_BUTTON_DRAW,    // ui: einzelner Button neu gezeichnet
+  TRACE_HEADER_DRAW,    // ui: Header-Uhr aktualisiert
+  TRACE_WEB_STATUS,     // web: /api/status
+  TRACE_WEB_FILE,       // web: Datei ausgeliefert
+  TRACE_WEB_CONFIG,     // web: Konfiguration gespeichert
+  TRACE_EEPROM_SAVE,    // storage: Service-Konfiguration ins EEPROM
+  TRACE_BUTTONS_SAVE,   // storage: Button-Konfiguration ins EEPROM
+  TRACE_EVENT_COUNT
+};
+
+// Initialisiert den Ringpuffer und die verzögerte Speicherung im Timer-Rad
+void setupTrace();
+
+// Trägt ein Ereignis ein (phase: 'B' = Beginn, 'E' = Ende, 'i' = Einzelereignis)
+void traceRecord(TraceEventId id, char phase, uint16_t arg = 0);
+
+// Leert den Ringpuffer
+void traceClear();
+
+// Ein laufender Export (Kopie des Ringpuffers + Lesefortschritt), Inhalt in trace.cpp
+struct TraceExport;
+
+enum TraceExportResult {
+  TRACE_EXPORT_OK = 0,
+  TRACE_EXPORT_BUSY,        // bereits TRACE_MAX_EXPORTS Exporte offen
+  TRACE_EXPORT_NO_MEMORY
+};
+
+/**
+ * Beginnt einen Export: friert eine eigene Kopie des Ringpuffers ein
+ * Jeder Export gehört seinem Aufrufer, mehrere Exporte (Web-Task, Loop) stören sich nicht.
+ *
+ * @param result        Optional: Grund, wenn kein Export begonnen wurde
+ * @return Export oder nullptr; freigeben mit traceExportEnd()
+ */
+TraceExport* traceExportBegin(TraceExportResult* result = nullptr);
+
+/**
+ * Liefert den nächsten Abschnitt des JSON-Exports (für Chunked-Response)
+ * @return Anzahl geschriebener Bytes, 0 = Export vollständig
+ */
+size_t traceExportRead(TraceExport* exp, uint8_t* buffer, size_t maxLen);
+
+// Gibt die Kopie frei (auch bei abgebrochenem Download)
+void traceExportEnd(TraceExport* exp);
+
+// Fordert das Schreiben von /trace.json an (erfolgt im loop()-Kontext)
+void traceRequestSave();
+
+// Anzahl, Kapazität und Überläufe als JSON (für /api/status)
+void getTraceStats(JsonObject obj);
+
+#if ENABLE_EVENT_TRACE == 1
+// Beginn/Ende eines Abschnitts automatisch beim Verlassen des Blocks
+class TraceScope {
+public:
+  explicit TraceScope(TraceEventId id, uint16_t arg = 0) : id(id) { traceRecord(id, 'B', arg); }
+  ~TraceScope() { traceRecord(id, 'E'); }
+
+private:
+  TraceEventId id;
+};
+
+#define TRACE_SCOPE(id) TraceScope traceScope(id)
+#define TRACE_INSTANT(id, arg) traceRecord(id, 'i', arg)
+#else
+#define TRACE_SCOPE(id)
+#define TRACE_INSTANT(id, arg)
+#endif
+
+#endif // TRACE_H
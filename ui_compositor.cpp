@@ -0,0 +1,860 @@
+#include "ui_compositor.h"
+#include "menu.h"
+#include "header_display.h"
+#include "service_manager.h"
+#include "idle_manager.h"
+#include "communication.h"
+#include "timer_wheel.h"
+#include "stall_monitor.h"
+#include "spi_bus.h"
+#include "backlight.h"
+#include "serial_commands.h"
+
+#ifndef SPI_FREQUENCY
+#define SPI_FREQUENCY 40000000
+#endif
+
+#define UI_BACKGROUND_COLOR TFT_WHITE
+
+struct UiRect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+// Gezeichneter Stand eines Buttons
+struct UiButtonRetained {
+  bool valid;
+  UiRect rect;
+  uint16_t fillColor;
+  uint16_t textColor;
+  String label;
+};
+
+// Gezeichneter Stand des Headers
+struct UiHeaderRetained {
+  bool valid;
+  String time;
+  String date;
+  String deviceId;
+  bool iconActive;
+};
+
+// Overlay am unteren Rand
+struct UiOverlay {
+  bool visible;
+  UiRect rect;
+  String text;
+  uint16_t bgColor;
+};
+
+UiButtonRetained uiButtons[NUM_BUTTONS];
+UiHeaderRetained uiHeader;
+UiOverlay uiOverlay = { false, { 0, 0, 0, 0 }, "", TFT_ORANGE };
+
+// Markierte Bereiche (Zugriff aus Loop- und Web-Task)
+UiRect uiDirty[UI_MAX_DIRTY_RECTS];
+int uiDirtyCount = 0;
+bool uiDirtyOverflow = false;
+portMUX_TYPE uiDirtyMux = portMUX_INITIALIZER_UNLOCKED;
+
+bool uiSceneVisible = false;
+int uiSceneRotation = -1;
+
+// *** NEU: Markierungen aus anderen Tasks (Web-Server) - im Loop-Task nachgeholt ***
+// uiButtons/uiHeader (mit Strings) werden nur im Loop-Task gelesen und geschrieben
+#define UI_PENDING_COMPARE 1
+#define UI_PENDING_FORCE 2
+uint32_t uiPendingButtons = 0;        // Bit i: Button i vergleichen
+uint32_t uiPendingButtonsForce = 0;   // Bit i: Button i immer markieren
+uint8_t uiPendingHeader = 0;          // UI_PENDING_COMPARE / UI_PENDING_FORCE
+bool uiPendingInvalidateAll = false;
+uint32_t uiMarksDeferred = 0;
+
+// Statistik
+uint32_t uiRenders = 0;
+uint32_t uiFullRepaints = 0;
+uint32_t uiRectsMarked = 0;
+uint32_t uiRectsRendered = 0;
+uint32_t uiRectOverflows = 0;
+uint32_t uiSkippedRedraws = 0;
+uint32_t uiHeaderGlyphsChanged = 0;
+uint32_t uiHeaderGlyphsSkipped = 0;
+uint32_t uiHeaderPartRepaints = 0;
+uint64_t uiPixelsPushed = 0;
+uint64_t uiPixelsSkipped = 0;
+uint64_t uiRenderTotalUs = 0;
+uint32_t uiRenderMaxUs = 0;
+unsigned long uiStatsStartMs = 0;
+
+// *** NEU: Frame-Takt - Änderungen sammeln, höchstens ein Frame pro UI_FRAME_INTERVAL_MS ***
+bool uiFramePacing = UI_FRAME_INTERVAL_MS > 0;
+int uiFrameTimerId = -1;
+unsigned long uiLastFrameMs = 0;
+unsigned long uiFirstDirtyMs = 0;   // Zeitpunkt der ersten Markierung seit dem letzten Frame
+uint32_t uiFramesDeferred = 0;
+uint32_t uiFramesRxDeferred = 0;
+
+// Szenen-Burst-Benchmark (vorher: sofort zeichnen, nachher: Frame-Takt)
+struct UiBenchResult {
+  uint32_t telegrams;
+  uint32_t frames;
+  uint32_t avgUs;
+  uint32_t maxUs;
+};
+UiBenchResult uiBenchImmediate;
+UiBenchResult uiBenchPaced;
+bool uiBenchValid = false;
+volatile bool uiBenchRequested = false;
+
+// *** NEU: Display dunkel - Frames verworfen, beim Einschalten einmal komplett gezeichnet ***
+bool uiDarkRepaintPending = false;
+uint32_t uiDarkFramesSkipped = 0;
+uint64_t uiDarkPixelsSkipped = 0;
+uint32_t uiWakeRepaints = 0;
+uint32_t uiWakeRepaintLastUs = 0;
+uint64_t uiWakePixelsPushed = 0;
+
+// *** NEU: Band-Puffer (zwei Sprites, bildschirmbreit, UI_BAND_LINES Zeilen) ***
+TFT_eSprite uiBandA = TFT_eSprite(&tft);
+TFT_eSprite uiBandB = TFT_eSprite(&tft);
+TFT_eSprite* uiBand[2] = { &uiBandA, &uiBandB };
+uint16_t* uiBandBuffer[2] = { nullptr, nullptr };
+int uiBandWidth = 0;          // 0 = keine Bänder, direkt zeichnen
+int uiBandNext = 0;
+bool uiBandDma = false;
+uint32_t uiBandsPushed = 0;
+uint64_t uiBandComposeUs = 0;
+uint64_t uiBandDmaWaitUs = 0;
+
+// Pixel pro Sekunde (gleitendes 1-s-Fenster)
+unsigned long uiWindowStartMs = 0;
+uint32_t uiWindowPixels = 0;
+uint32_t uiPixelsLastSecond = 0;
+
+void setupUiCompositor() {
+  // Weckt nur den Loop - gezeichnet wird in uiRender() am Ende von loop()
+  uiFrameTimerId = timerWheelRegister("uiFrame", [](void*) {});
+
+  // Laufen am Ende des Loop-Durchlaufs, nicht im Timer-Rad
+  registerSerialCommand("scene", uiRequestSceneBenchmark, "Szenen-Burst-Benchmark");
+
+  #if UI_BAND_RENDER == 1
+    int width = max(tft.width(), tft.height());  // passt für alle Rotationen
+    for (int i = 0; i < 2; i++) {
+      uiBandBuffer[i] = (uint16_t*)uiBand[i]->createSprite(width, UI_BAND_LINES);
+    }
+    if (uiBandBuffer[0] == nullptr || uiBandBuffer[1] == nullptr) {
+      uiBand[0]->deleteSprite();
+      uiBand[1]->deleteSprite();
+      uiBandBuffer[0] = uiBandBuffer[1] = nullptr;
+      Serial.println("WARNUNG: Kein Speicher für Band-Puffer - Compositor zeichnet direkt");
+      return;
+    }
+    uiBandWidth = width;
+    uiBandDma = tft.initDMA();
+
+    #if DB_INFO == 1
+      Serial.printf("DEBUG: Band-Puffer 2x %dx%d (%d Byte), DMA: %s\n", width, UI_BAND_LINES,
+                    2 * width * UI_BAND_LINES * (int)sizeof(uint16_t), uiBandDma ? "ja" : "nein");
+    #endif
+  #endif
+}
+
+// ===== Rechteck-Hilfsfunktionen =====
+
+int32_t uiRectArea(const UiRect& r) {
+  return (int32_t)r.w * r.h;
+}
+
+UiRect uiRectUnion(const UiRect& a, const UiRect& b) {
+  int16_t x0 = min(a.x, b.x);
+  int16_t y0 = min(a.y, b.y);
+  int16_t x1 = max(a.x + a.w, b.x + b.w);
+  int16_t y1 = max(a.y + a.h, b.y + b.h);
+  return { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+}
+
+// Schnittfläche (0 wenn keine Überlappung)
+int32_t uiRectIntersectArea(const UiRect& a, const UiRect& b) {
+  int32_t w = min(a.x + a.w, b.x + b.w) - max(a.x, b.x);
+  int32_t h = min(a.y + a.h, b.y + b.h) - max(a.y, b.y);
+  return (w > 0 && h > 0) ? w * h : 0;
+}
+
+bool uiRectEquals(const UiRect& a, const UiRect& b) {
+  return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+UiRect uiButtonRect(int i) {
+  return { (int16_t)buttons[i].x, (int16_t)buttons[i].y, (int16_t)buttons[i].w, (int16_t)buttons[i].h };
+}
+
+UiRect uiHeaderPartRect(HeaderPart part) {
+  int x, y, w, h;
+  getHeaderPartRect(part, &x, &y, &w, &h);
+  return { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+}
+
+// ===== Markieren =====
+
+void uiInvalidate(int x, int y, int w, int h) {
+  // Auf den Bildschirm beschneiden
+  int x1 = min(x + w, (int)tft.width());
+  int y1 = min(y + h, (int)tft.height());
+  x = max(x, 0);
+  y = max(y, 0);
+  if (x1 <= x || y1 <= y) {
+    return;
+  }
+  UiRect rect = { (int16_t)x, (int16_t)y, (int16_t)(x1 - x), (int16_t)(y1 - y) };
+
+  portENTER_CRITICAL(&uiDirtyMux);
+  uiRectsMarked++;
+  if (uiDirtyCount == 0) {
+    uiFirstDirtyMs = millis();
+  }
+  if (uiDirtyCount < UI_MAX_DIRTY_RECTS) {
+    uiDirty[uiDirtyCount++] = rect;
+  } else {
+    // Liste voll - in den letzten Eintrag aufnehmen (wird größer, aber nichts geht verloren)
+    uiDirty[UI_MAX_DIRTY_RECTS - 1] = uiRectUnion(uiDirty[UI_MAX_DIRTY_RECTS - 1], rect);
+    uiDirtyOverflow = true;
+  }
+  portEXIT_CRITICAL(&uiDirtyMux);
+
+  // Markiert aus dem Web-Task - Loop wecken, damit ohne Leerlauf-Verzögerung gezeichnet wird
+  if (!idleIsLoopTask()) {
+    idleWakeFromTask();
+  }
+}
+
+void uiInvalidateRect(const UiRect& rect) {
+  uiInvalidate(rect.x, rect.y, rect.w, rect.h);
+}
+
+// Markierung aus einem anderen Task vormerken und den Loop wecken
+void uiDeferMark() {
+  __atomic_fetch_add(&uiMarksDeferred, 1, __ATOMIC_RELAXED);
+  idleWakeFromTask();
+}
+
+void uiMarkButtonDirty(int buttonIndex, bool force) {
+  if (buttonIndex < 0 || buttonIndex >= NUM_BUTTONS) {
+    return;
+  }
+  if (!idleIsLoopTask()) {
+    __atomic_fetch_or(force ? &uiPendingButtonsForce : &uiPendingButtons, 1UL << buttonIndex, __ATOMIC_RELAXED);
+    uiDeferMark();
+    return;
+  }
+  UiButtonRetained& retained = uiButtons[buttonIndex];
+  UiRect rect = uiButtonRect(buttonIndex);
+  uint16_t fillColor = getButtonFillColor(buttonIndex);
+
+  bool geometryChanged = !retained.valid || !uiRectEquals(retained.rect, rect);
+  if (!force && !geometryChanged &&
+      retained.fillColor == fillColor &&
+      retained.textColor == buttons[buttonIndex].textColor &&
+      retained.label == buttons[buttonIndex].label) {
+    // Unverändert (z.B. wiederholtes LED.ON) - kein SPI-Verkehr
+    uiSkippedRedraws++;
+    uiPixelsSkipped += uiRectArea(rect);
+    return;
+  }
+
+  // Alte Position freigeben, wenn der Button verschoben wurde
+  if (retained.valid && geometryChanged) {
+    uiInvalidateRect(retained.rect);
+  }
+
+  retained.valid = true;
+  retained.rect = rect;
+  retained.fillColor = fillColor;
+  retained.textColor = buttons[buttonIndex].textColor;
+  retained.label = buttons[buttonIndex].label;
+  uiInvalidateRect(rect);
+}
+
+void uiMarkAllButtonsDirty(bool force) {
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    uiMarkButtonDirty(i, force);
+  }
+}
+
+// Vergleicht den gezeichneten mit dem neuen Text Zeichen für Zeichen (Font 1, feste Breite)
+// und markiert nur die Zellen geänderter Zeichen; bei anderer Länge den ganzen Teil
+void uiMarkHeaderTextDirty(HeaderPart part, const String& drawn, const String& text) {
+  UiRect partRect = uiHeaderPartRect(part);
+  if (drawn.length() != text.length()) {
+    uiHeaderPartRepaints++;
+    uiInvalidateRect(partRect);
+    return;
+  }
+
+  int changed = 0;
+  for (unsigned int i = 0; i < text.length(); i++) {
+    int x, y, w, h;
+    getHeaderGlyphRect(part, i, &x, &y, &w, &h);
+    if (drawn.charAt(i) != text.charAt(i)) {
+      uiInvalidate(x, y, w, h);
+      changed++;
+    } else {
+      uiPixelsSkipped += (uint32_t)w * h;
+    }
+  }
+  uiHeaderGlyphsChanged += changed;
+  uiHeaderGlyphsSkipped += text.length() - changed;
+}
+
+void uiMarkHeaderDirty(bool force) {
+  if (!idleIsLoopTask()) {
+    __atomic_fetch_or(&uiPendingHeader, (uint8_t)(force ? UI_PENDING_FORCE : UI_PENDING_COMPARE), __ATOMIC_RELAXED);
+    uiDeferMark();
+    return;
+  }
+
+  String time = formatTime();
+  String date = formatDate();
+  String deviceId = "ID:" + serviceManager.getDeviceID();
+  bool iconActive = serviceManager.isServiceMode();
+
+  if (force || !uiHeader.valid) {
+    int x, y, w, h;
+    getHeaderRect(&x, &y, &w, &h);
+    uiInvalidate(x, y, w, h);
+  } else {
+    // *** NEU: Uhrzeit und Datum zeichenweise - nur geänderte Glyphen-Zellen ***
+    uiMarkHeaderTextDirty(HEADER_PART_TIME, uiHeader.time, time);
+    uiMarkHeaderTextDirty(HEADER_PART_DATE, uiHeader.date, date);
+
+    struct { bool changed; HeaderPart part; } parts[] = {
+      { uiHeader.deviceId != deviceId,     HEADER_PART_DEVICE_ID },
+      { uiHeader.iconActive != iconActive, HEADER_PART_ICON },
+    };
+    for (auto& p : parts) {
+      UiRect rect = uiHeaderPartRect(p.part);
+      if (p.changed) {
+        uiInvalidateRect(rect);
+      } else {
+        uiPixelsSkipped += uiRectArea(rect);
+      }
+    }
+  }
+
+  uiHeader.valid = true;
+  uiHeader.time = time;
+  uiHeader.date = date;
+  uiHeader.deviceId = deviceId;
+  uiHeader.iconActive = iconActive;
+}
+
+void uiShowOverlay(const String& text, uint16_t bgColor) {
+  uiOverlay.visible = true;
+  uiOverlay.rect = { 0, (int16_t)(SCREEN_HEIGHT - 30), (int16_t)SCREEN_WIDTH, 30 };
+  uiOverlay.text = text;
+  uiOverlay.bgColor = bgColor;
+  uiInvalidateRect(uiOverlay.rect);
+}
+
+void uiHideOverlay() {
+  if (!uiOverlay.visible) {
+    return;
+  }
+  uiOverlay.visible = false;
+  uiInvalidateRect(uiOverlay.rect);
+}
+
+void uiInvalidateAll() {
+  if (!idleIsLoopTask()) {
+    __atomic_store_n(&uiPendingInvalidateAll, true, __ATOMIC_RELAXED);
+    uiDeferMark();
+    return;
+  }
+
+  uiSceneRotation = tft.getRotation();
+  uiHeader.valid = false;
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    uiButtons[i].valid = false;
+  }
+  uiMarkHeaderDirty(true);
+  uiMarkAllButtonsDirty(true);
+
+  // Eine Fläche für den ganzen Bildschirm statt vieler Einzelbereiche
+  portENTER_CRITICAL(&uiDirtyMux);
+  uiDirty[0] = { 0, 0, (int16_t)tft.width(), (int16_t)tft.height() };
+  uiDirtyCount = 1;
+  uiDirtyOverflow = false;
+  portEXIT_CRITICAL(&uiDirtyMux);
+}
+
+void uiSetSceneVisible(bool visible) {
+  uiSceneVisible = visible;
+}
+
+// Vorgemerkte Markierungen aus anderen Tasks ausführen (im Loop-Task, vor dem Zeichnen)
+void uiApplyPendingMarks() {
+  if (__atomic_exchange_n(&uiPendingInvalidateAll, false, __ATOMIC_RELAXED)) {
+    uiInvalidateAll();
+  }
+
+  uint32_t force = __atomic_exchange_n(&uiPendingButtonsForce, 0, __ATOMIC_RELAXED);
+  uint32_t compare = __atomic_exchange_n(&uiPendingButtons, 0, __ATOMIC_RELAXED);
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    if (force & (1UL << i)) {
+      uiMarkButtonDirty(i, true);
+    } else if (compare & (1UL << i)) {
+      uiMarkButtonDirty(i, false);
+    }
+  }
+
+  uint8_t header = __atomic_exchange_n(&uiPendingHeader, 0, __ATOMIC_RELAXED);
+  if (header != 0) {
+    uiMarkHeaderDirty((header & UI_PENDING_FORCE) != 0);
+  }
+}
+
+// ===== Zeichnen =====
+
+// Bereiche zusammenfassen, solange die Vereinigung nicht größer ist als beide zusammen
+// (angrenzende Buttons einer Reihe, überlappende Bereiche)
+int uiMergeRects(UiRect* rects, int count) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (int i = 0; i < count && !merged; i++) {
+      for (int j = i + 1; j < count; j++) {
+        UiRect u = uiRectUnion(rects[i], rects[j]);
+        if (uiRectArea(u) <= uiRectArea(rects[i]) + uiRectArea(rects[j])) {
+          rects[i] = u;
+          rects[j] = rects[--count];
+          merged = true;
+          break;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+// Zeichnet Hintergrund, Header, Buttons und Overlay eines Bereichs auf gfx
+// (originX/Y: Bildschirmposition von (0,0) in gfx). Ergebnis: gezeichnete Pixel inkl. Überdeckung
+uint32_t uiComposeRect(const UiRect& rect, TFT_eSPI& gfx, int originX, int originY) {
+  uint32_t drawn = 0;
+
+  int x, y, w, h;
+  getHeaderRect(&x, &y, &w, &h);
+  UiRect headerRect = { (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h };
+  int32_t headerArea = uiRectIntersectArea(rect, headerRect);
+
+  int32_t buttonArea = 0;
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    buttonArea += uiRectIntersectArea(rect, uiButtonRect(i));
+  }
+
+  // Hintergrund nur, wo weder Header noch Buttons liegen
+  int32_t area = uiRectArea(rect);
+  if (headerArea + buttonArea < area) {
+    gfx.fillRect(rect.x - originX, rect.y - originY, rect.w, rect.h, UI_BACKGROUND_COLOR);
+    drawn += area;
+  }
+
+  if (headerArea > 0) {
+    paintHeader(gfx, originX, originY);
+    drawn += headerArea;
+  }
+
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    int32_t a = uiRectIntersectArea(rect, uiButtonRect(i));
+    if (a > 0) {
+      paintButton(i, gfx, originX, originY);
+      drawn += a;
+    }
+  }
+
+  if (uiOverlay.visible) {
+    int32_t a = uiRectIntersectArea(rect, uiOverlay.rect);
+    if (a > 0) {
+      int ox = uiOverlay.rect.x - originX;
+      int oy = uiOverlay.rect.y - originY;
+      gfx.fillRect(ox, oy, uiOverlay.rect.w, uiOverlay.rect.h, uiOverlay.bgColor);
+      gfx.setTextColor(TFT_BLACK);
+      gfx.drawCentreString(uiOverlay.text, ox + uiOverlay.rect.w / 2, oy + 10, 1);
+      drawn += a;
+    }
+  }
+
+  return drawn;
+}
+
+void uiCountPixels(uint32_t pixels) {
+  uiPixelsPushed += pixels;
+  uiWindowPixels += pixels;
+}
+
+// Direkt auf das Display - alle Zeichenbefehle werden auf den Viewport beschnitten
+// (Rückfall, wenn kein Speicher für die Bänder frei ist)
+void uiRenderRectDirect(const UiRect& rect) {
+  tft.setViewport(rect.x, rect.y, rect.w, rect.h, false);
+  uiCountPixels(uiComposeRect(rect, tft, 0, 0));
+  tft.resetViewport();
+}
+
+// In Bändern: jedes Band wird im Sprite zusammengesetzt und als Ganzes übertragen,
+// während der DMA-Übertragung wird bereits das nächste Band im anderen Sprite gezeichnet
+void uiRenderRectBanded(const UiRect& rect) {
+  for (int by = rect.y; by < rect.y + rect.h; by += UI_BAND_LINES) {
+    UiRect band = { rect.x, (int16_t)by, rect.w, (int16_t)min(UI_BAND_LINES, rect.y + rect.h - by) };
+    TFT_eSprite* sprite = uiBand[uiBandNext];
+    uint16_t* buffer = uiBandBuffer[uiBandNext];
+
+    uint32_t composeStart = micros();
+    uiComposeRect(band, *sprite, band.x, band.y);
+
+    // Zeilen hintereinander legen (Sprite ist bildschirmbreit, übertragen wird nur band.w)
+    if (band.w < uiBandWidth) {
+      for (int row = 1; row < band.h; row++) {
+        memmove(buffer + row * band.w, buffer + row * uiBandWidth, band.w * sizeof(uint16_t));
+      }
+    }
+    uiBandComposeUs += micros() - composeStart;
+
+    // Vorherige Übertragung abwarten - nur diese Zeit blockiert die CPU
+    uint32_t waitStart = micros();
+    if (uiBandDma) {
+      tft.dmaWait();
+      uiBandDmaWaitUs += micros() - waitStart;
+      // *** NEU: Bus ist zwischen zwei Bändern frei - fällige Touch-Abtastung einschieben ***
+      spiBusYieldToTouch();
+      tft.pushImageDMA(band.x, band.y, band.w, band.h, buffer);
+    } else {
+      tft.pushImage(band.x, band.y, band.w, band.h, buffer);
+      uiBandDmaWaitUs += micros() - waitStart;
+      spiBusYieldToTouch();
+    }
+    spiBusCountBytes(SPI_BUS_DISPLAY, uiRectArea(band) * sizeof(uint16_t));
+
+    uiBandNext ^= 1;
+    uiBandsPushed++;
+    uiCountPixels(uiRectArea(band));
+  }
+}
+
+void uiRender(bool force) {
+  // Gezeichnet wird nur im Loop-Task (z.B. showMenu() aus einem Web-Handler)
+  if (!idleIsLoopTask()) {
+    idleWakeFromTask();
+    return;
+  }
+
+  unsigned long now = millis();
+  if (now - uiWindowStartMs >= 1000) {
+    uiPixelsLastSecond = uiWindowPixels;
+    uiWindowPixels = 0;
+    uiWindowStartMs = now;
+  }
+
+  // Benchmark aus dem Web-Task angefordert - hier im Loop-Task ausführen
+  if (uiBenchRequested) {
+    uiBenchRequested = false;
+    uiRunSceneBenchmark(UI_BENCH_ROUNDS);
+  }
+
+  uiApplyPendingMarks();
+
+  if (uiDirtyCount == 0) {
+    return;
+  }
+
+  // Menü nicht sichtbar (Startbildschirm, Service-Modus) - showMenu() zeichnet später alles
+  if (!uiSceneVisible || serviceManager.isServiceMode()) {
+    portENTER_CRITICAL(&uiDirtyMux);
+    uiDirtyCount = 0;
+    portEXIT_CRITICAL(&uiDirtyMux);
+    return;
+  }
+
+  // *** NEU: Display dunkel - nichts übertragen, der Zustand ist bereits gemerkt ***
+  if (isDisplayDark()) {
+    UiRect rects[UI_MAX_DIRTY_RECTS];
+    portENTER_CRITICAL(&uiDirtyMux);
+    int count = uiDirtyCount;
+    memcpy(rects, uiDirty, count * sizeof(UiRect));
+    uiDirtyCount = 0;
+    uiDirtyOverflow = false;
+    portEXIT_CRITICAL(&uiDirtyMux);
+
+    count = uiMergeRects(rects, count);
+    for (int i = 0; i < count; i++) {
+      uiDarkPixelsSkipped += uiRectArea(rects[i]);
+    }
+    uiDarkFramesSkipped++;
+    uiDarkRepaintPending = true;
+    return;
+  }
+
+  // *** NEU: Frame-Takt - Telegramm-Bursts (Szene mit 6 LEDs) in einem Frame zeichnen ***
+  if (!force && uiFramePacing) {
+    // Empfang läuft noch - erst die restlichen Telegramme abarbeiten (begrenzt)
+    if (isRxPending() && now - uiFirstDirtyMs < UI_FRAME_MAX_DELAY_MS) {
+      uiFramesRxDeferred++;
+      return;
+    }
+    // Letzter Frame zu kurz her - Timer weckt den Loop zum nächsten Frame
+    unsigned long sinceFrame = now - uiLastFrameMs;
+    if (sinceFrame < UI_FRAME_INTERVAL_MS) {
+      if (!timerWheelIsActive(uiFrameTimerId)) {
+        timerWheelStart(uiFrameTimerId, UI_FRAME_INTERVAL_MS - sinceFrame);
+      }
+      uiFramesDeferred++;
+      return;
+    }
+  }
+  uiLastFrameMs = now;
+
+  // Rotation geändert (Service-Menü) - Geometrie stimmt nicht mehr
+  if (tft.getRotation() != uiSceneRotation) {
+    uiInvalidateAll();
+  }
+
+  // Markierte Bereiche übernehmen
+  UiRect rects[UI_MAX_DIRTY_RECTS];
+  portENTER_CRITICAL(&uiDirtyMux);
+  int count = uiDirtyCount;
+  memcpy(rects, uiDirty, count * sizeof(UiRect));
+  if (uiDirtyOverflow) {
+    uiRectOverflows++;
+    uiDirtyOverflow = false;
+  }
+  uiDirtyCount = 0;
+  portEXIT_CRITICAL(&uiDirtyMux);
+
+  uint32_t startUs = micros();
+
+  count = uiMergeRects(rects, count);
+  // *** NEU: Display belegt den gemeinsamen HSPI-Bus für den ganzen Frame ***
+  spiBusAcquire(SPI_BUS_DISPLAY);
+  if (uiBandWidth > 0) {
+    tft.startWrite();
+    for (int i = 0; i < count; i++) {
+      uiRenderRectBanded(rects[i]);
+    }
+    // Letztes Band muss vor dem Freigeben des Busses fertig sein
+    if (uiBandDma) {
+      uint32_t waitStart = micros();
+      tft.dmaWait();
+      uiBandDmaWaitUs += micros() - waitStart;
+    }
+    tft.endWrite();
+  } else {
+    for (int i = 0; i < count; i++) {
+      uiRenderRectDirect(rects[i]);
+      spiBusCountBytes(SPI_BUS_DISPLAY, uiRectArea(rects[i]) * sizeof(uint16_t));
+    }
+  }
+  spiBusRelease(SPI_BUS_DISPLAY);
+
+  uint32_t us = micros() - startUs;
+  uiRenders++;
+  uiRectsRendered += count;
+  uiRenderTotalUs += us;
+  if (us > uiRenderMaxUs) {
+    uiRenderMaxUs = us;
+  }
+  if (count == 1 && rects[0].w == tft.width() && rects[0].h == tft.height()) {
+    uiFullRepaints++;
+  }
+}
+
+void uiRepaintBeforeWake() {
+  if (!uiDarkRepaintPending) {
+    return;
+  }
+  uiDarkRepaintPending = false;
+
+  // Eine komplette Szene statt der einzeln verworfenen Bereiche
+  uint32_t startUs = micros();
+  uint64_t pixelsBefore = uiPixelsPushed;
+  uiInvalidateAll();
+  uiRender(true);
+  uiWakeRepaintLastUs = micros() - startUs;
+  uiWakePixelsPushed += uiPixelsPushed - pixelsBefore;
+  uiWakeRepaints++;
+}
+
+void getUiStats(JsonObject obj) {
+  unsigned long elapsed = millis() - uiStatsStartMs;
+
+  obj["sceneVisible"] = uiSceneVisible;
+  obj["renders"] = uiRenders;
+  obj["fullRepaints"] = uiFullRepaints;
+  obj["rectsMarked"] = uiRectsMarked;
+  obj["rectsRendered"] = uiRectsRendered;
+  obj["rectOverflows"] = uiRectOverflows;
+  obj["skippedRedraws"] = uiSkippedRedraws;
+  obj["marksDeferred"] = uiMarksDeferred;
+  obj["pixelsPushed"] = uiPixelsPushed;
+  obj["pixelsSkipped"] = uiPixelsSkipped;
+  obj["pixelsLastSecond"] = uiPixelsLastSecond;
+  obj["pixelsPerSecondAvg"] = elapsed > 0 ? (uint32_t)(uiPixelsPushed * 1000ULL / elapsed) : 0;
+  obj["renderAvgUs"] = uiRenders > 0 ? (uint32_t)(uiRenderTotalUs / uiRenders) : 0;
+  obj["renderMaxUs"] = uiRenderMaxUs;
+
+  // Ersparnis bei dunklem Display: SPI-Zeit wie unten, CPU-Zeit über die mittlere Zeit pro Pixel
+  JsonObject darkObj = obj.createNestedObject("dark");
+  darkObj["active"] = isDisplayDark();
+  darkObj["repaintPending"] = uiDarkRepaintPending;
+  darkObj["framesSkipped"] = uiDarkFramesSkipped;
+  darkObj["pixelsSkipped"] = uiDarkPixelsSkipped;
+  darkObj["spiMsSaved"] = (uint32_t)(uiDarkPixelsSkipped * 16ULL * 1000ULL / SPI_FREQUENCY);
+  darkObj["cpuMsSavedEst"] = uiPixelsPushed > 0 ?
+      (uint32_t)((double)uiDarkPixelsSkipped * uiRenderTotalUs / uiPixelsPushed / 1000.0) : 0;
+  darkObj["wakeRepaints"] = uiWakeRepaints;
+  darkObj["wakeRepaintLastUs"] = uiWakeRepaintLastUs;
+  darkObj["wakePixelsPushed"] = uiWakePixelsPushed;
+
+  JsonObject bandObj = obj.createNestedObject("band");
+  bandObj["enabled"] = uiBandWidth > 0;
+  bandObj["dma"] = uiBandDma;
+  bandObj["lines"] = UI_BAND_LINES;
+  bandObj["bufferBytes"] = 2 * uiBandWidth * UI_BAND_LINES * (int)sizeof(uint16_t);
+  bandObj["bandsPushed"] = uiBandsPushed;
+  bandObj["composeUs"] = uiBandComposeUs;
+  bandObj["dmaWaitUs"] = uiBandDmaWaitUs;
+
+  JsonObject headerObj = obj.createNestedObject("header");
+  headerObj["glyphsChanged"] = uiHeaderGlyphsChanged;
+  headerObj["glyphsSkipped"] = uiHeaderGlyphsSkipped;
+  headerObj["partRepaints"] = uiHeaderPartRepaints;
+
+  JsonObject frameObj = obj.createNestedObject("frame");
+  frameObj["pacing"] = uiFramePacing;
+  frameObj["intervalMs"] = UI_FRAME_INTERVAL_MS;
+  frameObj["deferred"] = uiFramesDeferred;
+  frameObj["rxDeferred"] = uiFramesRxDeferred;
+
+  if (uiBenchValid) {
+    JsonObject benchObj = obj.createNestedObject("sceneBenchmark");
+    JsonObject immediateObj = benchObj.createNestedObject("immediate");
+    immediateObj["telegrams"] = uiBenchImmediate.telegrams;
+    immediateObj["frames"] = uiBenchImmediate.frames;
+    immediateObj["rxLatencyAvgUs"] = uiBenchImmediate.avgUs;
+    immediateObj["rxLatencyMaxUs"] = uiBenchImmediate.maxUs;
+    JsonObject pacedObj = benchObj.createNestedObject("paced");
+    pacedObj["telegrams"] = uiBenchPaced.telegrams;
+    pacedObj["frames"] = uiBenchPaced.frames;
+    pacedObj["rxLatencyAvgUs"] = uiBenchPaced.avgUs;
+    pacedObj["rxLatencyMaxUs"] = uiBenchPaced.maxUs;
+  }
+
+  // Gesparte SPI-Zeit: 16 Bit pro Pixel bei SPI_FREQUENCY (ohne Adressierung)
+  obj["spiMsSaved"] = (uint32_t)(uiPixelsSkipped * 16ULL * 1000ULL / SPI_FREQUENCY);
+}
+
+// ===== Szenen-Burst-Benchmark =====
+
+// Spielt rounds Szenen (je 6 LED-Telegramme direkt hintereinander) ab und misst pro
+// Telegramm die Zeit, bis der Loop wieder empfangen könnte (Zerlegen, Ausführen, Zeichnen).
+// Während eines Bursts meldet isRxPending() die noch folgenden Telegramme (simuliert),
+// die Pause zwischen zwei Szenen wird nicht abgewartet, sondern im Frame-Takt vorweggenommen.
+void uiBenchmarkBursts(UiBenchResult& result, int rounds) {
+  String deviceId = serviceManager.getDeviceID();
+  uint64_t totalUs = 0;
+  uint32_t rendersBefore = uiRenders;
+  result = { 0, 0, 0, 0 };
+
+  for (int r = 0; r < rounds; r++) {
+    // Jede Runde schaltet alle Buttons um, damit jedes Telegramm den Zustand ändert
+    String action = (r % 2 == 0) ? "ON.100" : "ON.0";
+
+    // Pause seit der letzten Szene: ein Frame-Intervall ist verstrichen
+    uiLastFrameMs = millis() - UI_FRAME_INTERVAL_MS;
+
+    for (int i = 0; i < NUM_BUTTONS; i++) {
+      String telegram = String((char)START_BYTE) + deviceId + ".LED." + String(49 + i) + "." +
+                        action + String((char)END_BYTE);
+
+      // Weitere Telegramme des Bursts sind noch im Empfang
+      setRxBenchmarkPending(i < NUM_BUTTONS - 1);
+
+      uint32_t startUs = micros();
+      processTelegram(telegram);
+      processRxWorkQueue();
+      uiRender();
+      uint32_t us = micros() - startUs;
+
+      totalUs += us;
+      result.telegrams++;
+      if (us > result.maxUs) {
+        result.maxUs = us;
+      }
+    }
+    // Noch ausstehender Frame der Szene (nicht gemessen)
+    uiRender(true);
+  }
+  timerWheelStop(uiFrameTimerId);
+
+  result.frames = uiRenders - rendersBefore;
+  result.avgUs = result.telegrams > 0 ? (uint32_t)(totalUs / result.telegrams) : 0;
+}
+
+void uiRunSceneBenchmark(int rounds) {
+  // Benchmark zeichnet 2 x rounds Szenen am Stück - nicht als Stall melden
+  STALL_PHASE(STALL_PHASE_NONE);
+
+  if (!uiSceneVisible || serviceManager.isServiceMode()) {
+    Serial.println("Szenen-Benchmark: Hauptmenü nicht sichtbar - abgebrochen");
+    return;
+  }
+  // Echte Telegramme bzw. ein gedrückter Button würden vom Zurücksetzen überschrieben
+  bool buttonPressed = false;
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    buttonPressed |= isButtonLocallyPressed(i);
+  }
+  if (isRxPending() || buttonPressed || isDisplayDark()) {
+    Serial.println("Szenen-Benchmark: Empfang, Touch aktiv oder Display dunkel - abgebrochen");
+    return;
+  }
+
+  // Kompletten Button-Zustand sichern (Benchmark schaltet die LEDs um)
+  Button savedButtons[NUM_BUTTONS];
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    savedButtons[i] = buttons[i];
+  }
+  bool savedPacing = uiFramePacing;
+
+  // Ohne Empfangs-LED und Bildschirmschoner-Wecken, Empfang wird simuliert
+  setRxBenchmarkMode(true);
+
+  // Vorher: jedes Telegramm zeichnet sofort
+  uiFramePacing = false;
+  uiBenchmarkBursts(uiBenchImmediate, rounds);
+
+  // Nachher: Frame-Takt
+  uiFramePacing = true;
+  uiBenchmarkBursts(uiBenchPaced, rounds);
+
+  setRxBenchmarkMode(false);
+  uiFramePacing = savedPacing;
+  uiBenchValid = true;
+
+  for (int i = 0; i < NUM_BUTTONS; i++) {
+    buttons[i] = savedButtons[i];
+    redrawButton(i);
+  }
+  uiRender(true);
+
+  Serial.println("=== Szenen-Burst-Benchmark (6 LED-Telegramme pro Szene) ===");
+  Serial.printf("Sofort zeichnen: %lu Telegramme, %lu Frames, RX-Latenz avg %lu us, max %lu us\n",
+                (unsigned long)uiBenchImmediate.telegrams, (unsigned long)uiBenchImmediate.frames,
+                (unsigned long)uiBenchImmediate.avgUs, (unsigned long)uiBenchImmediate.maxUs);
+  Serial.printf("Frame-Takt:      %lu Telegramme, %lu Frames, RX-Latenz avg %lu us, max %lu us\n",
+                (unsigned long)uiBenchPaced.telegrams, (unsigned long)uiBenchPaced.frames,
+                (unsigned long)uiBenchPaced.avgUs, (unsigned long)uiBenchPaced.maxUs);
+}
+
+void uiRequestSceneBenchmark() {
+  uiBenchRequested = true;
+  idleWakeFromTask();
+}
@@ -0,0 +1,75 @@
+/**
+ * ui_compositor.h - Dirty-Rect-Compositor für das Hauptmenü
+ *
+ * Das Hauptmenü wird als Szene mit gemerktem Zustand geführt:
+ * - Header (Uhrzeit, Datum, Device ID, Service-Icon als eigene Bereiche)
+ * - Button-Raster (Füllfarbe, Textfarbe, Beschriftung, Position)
+ * - Ein Overlay am unteren Rand (z.B. Timeout-Warnung)
+ *
+ * Zustandsänderungen vergleichen mit dem zuletzt gezeichneten Stand und
+ * markieren nur geänderte Bereiche. uiRender() fasst überlappende bzw.
+ * angrenzende Bereiche zusammen und zeichnet sie - auf den Bereich beschnitten
+ * (TFT_eSPI-Viewport) - in der Reihenfolge Hintergrund, Header, Buttons, Overlay.
+ *
+ * Der gemerkte Zustand gehört dem Loop-Task: uiMark*() und uiInvalidateAll() aus
+ * einem anderen Task (Web-Server) werden nur vorgemerkt und vor dem nächsten Frame
+ * im Loop-Task ausgeführt. uiInvalidate() ist aus jedem Task erlaubt (portMUX),
+ * Overlay nur im Loop-Task. Gezeichnet wird nur im Loop-Task und nur, solange das
+ * Hauptmenü sichtbar ist (nicht im Service-Modus). Telegramme ändern nur den
+ * Zustand; gezeichnet wird im Frame-Takt (UI_FRAME_INTERVAL_MS).
+ *
+ * Gezeichnet wird in Bändern (UI_BAND_LINES Zeilen) in zwei abwechselnden
+ * Sprites: ein Band wird per DMA übertragen, während das nächste entsteht.
+ * Kein Flackern (jedes Pixel wird einmal übertragen), RAM bleibt begrenzt.
+ */
+#ifndef UI_COMPOSITOR_H
+#define UI_COMPOSITOR_H
+
+#include "config.h"
+
+// Band-Puffer anlegen und DMA einrichten (nach setupDisplay())
+void setupUiCompositor();
+
+// Hauptmenü sichtbar (showMenu) - vorher (Startbildschirm) wird nichts gezeichnet
+void uiSetSceneVisible(bool visible);
+
+// Markiert einen Bildschirmbereich als neu zu zeichnen
+void uiInvalidate(int x, int y, int w, int h);
+
+// Komplette Szene neu zeichnen (z.B. nach Rotation oder Rückkehr ins Menü)
+void uiInvalidateAll();
+
+// Button mit dem gezeichneten Stand vergleichen, nur bei Änderung markieren
+// (force: immer markieren, z.B. nach Konfigurationsänderung)
+void uiMarkButtonDirty(int buttonIndex, bool force = false);
+
+// Alle Buttons markieren
+void uiMarkAllButtonsDirty(bool force = false);
+
+// Header-Bereiche (Zeit, Datum, Device ID, Icon) vergleichen und nur geänderte markieren
+void uiMarkHeaderDirty(bool force = false);
+
+// Overlay am unteren Rand ein-/ausblenden
+void uiShowOverlay(const String& text, uint16_t bgColor);
+void uiHideOverlay();
+
+// Zeichnet alle markierten Bereiche (am Ende jedes loop()-Durchlaufs aufrufen)
+// Frame-Takt: höchstens ein Frame pro UI_FRAME_INTERVAL_MS, verschoben solange noch
+// Telegramme empfangen werden (force: sofort zeichnen, z.B. in showMenu())
+void uiRender(bool force = false);
+
+// *** NEU: Während das Display dunkel war, wurde nicht gezeichnet - Szene jetzt komplett
+// zeichnen (setBacklight() ruft das vor dem Einschalten der Beleuchtung auf) ***
+void uiRepaintBeforeWake();
+
+// Szenen-Burst-Benchmark: RX-Latenz bei sofortigem Zeichnen und mit Frame-Takt
+// (Serial "scene", Ergebnis auch unter ui.sceneBenchmark in /api/status)
+void uiRunSceneBenchmark(int rounds);
+
+// Benchmark aus einem anderen Task anfordern (läuft im nächsten loop()-Durchlauf)
+void uiRequestSceneBenchmark();
+
+// Zeichenvorgänge, übertragene/gesparte Pixel und Renderzeit als JSON (für /api/status)
+void getUiStats(JsonObject obj);
+
+#endif // UI_COMPOSITOR_H
@@ -2,6 +2,34 @@
 
 #include "web_server_manager.h"
 #include "header_display.h"
+#include "report_scheduler.h"
+#include "timer_wheel.h"
+#include "touch.h"
+#include "profiler.h"
+#include "btn_latency.h"
+#include "trace.h"
+#include "stall_monitor.h"
+#include "idle_manager.h"
+#include "cpu_freq.h"
+#include "boot_report.h"
+#include "rtc_snapshot.h"
+#include "ui_compositor.h"
+#include "label_cache.h"
+#include "icons.h"
+#include "spi_bus.h"
+#include "screensaver.h"
+#include <memory>
+
+// *** NEU: Jede Anfrage als Aktivität melden (CPU-Takt hochschalten) ***
+// Rewrites werden vor allen Handlern geprüft - match() schreibt nichts um.
+class WebActivityRewrite : public AsyncWebRewrite {
+public:
+    WebActivityRewrite() : AsyncWebRewrite("", "") {}
+    bool match(AsyncWebServerRequest *request) override {
+        cpuFreqNoteWebActivity();
+        return false;
+    }
+};
 
 // Globale WebServerManager Instanz
 WebServerManager webServerManager;
@@ -34,6 +62,8 @@ bool WebServerManager::isRunning() const {
 }
 
 void WebServerManager::setupRoutes() {
+    server.addRewrite(new WebActivityRewrite());
+    
     // Haupt-Route - leitet zur index.html weiter
     server.on("/", HTTP_GET, [this](AsyncWebServerRequest *request) {
         serveFile(request, "/www/index.html", "text/html");
@@ -97,6 +127,15 @@ void WebServerManager::setupRoutes() {
         handleAPISetBrightness(request);
     });
 
+    // *** NEU: Bildschirmschoner (Timeout, Dimmstufe, Ausschalten, Weck-Telegramme) ***
+    server.on("/api/screensaver", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        handleAPIGetScreensaver(request);
+    });
+
+    server.on("/api/screensaver", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        handleAPISetScreensaver(request);
+    });
+
     server.on("/api/orientation", HTTP_POST, [this](AsyncWebServerRequest *request) {
         handleAPISetOrientation(request);
     });
@@ -125,6 +164,58 @@ void WebServerManager::setupRoutes() {
         handleAPIFactoryReset(request);
     });
 
+    // *** NEU: Loop-Profiler zurücksetzen ***
+    server.on("/api/profiler/reset", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        requestProfilerReset();  // Messwerte gehören dem Loop-Task
+        sendSuccess(request, "Profiler zurückgesetzt");
+    });
+
+    // *** NEU: Ereignis-Trace (Chrome trace_event JSON für Perfetto) ***
+    server.on("/api/trace", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        TraceExportResult result;
+        TraceExport* exp = traceExportBegin(&result);
+        if (result == TRACE_EXPORT_BUSY) {
+            sendError(request, "Trace-Export läuft bereits", 409);
+            return;
+        }
+        if (exp == nullptr) {
+            sendError(request, "Kein Speicher für Trace-Export", 503);
+            return;
+        }
+        // Die Kopie gehört der Antwort: freigegeben, wenn AsyncWebServer die Antwort löscht
+        // (fertig oder Verbindung abgebrochen)
+        std::shared_ptr<TraceExport> owned(exp, traceExportEnd);
+        AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+            [owned](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return traceExportRead(owned.get(), buffer, maxLen);
+            });
+        response->addHeader("Content-Disposition", "attachment; filename=trace.json");
+        request->send(response);
+    });
+
+    server.on("/api/trace/save", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        traceRequestSave();
+        sendSuccess(request, "Trace wird nach /trace.json geschrieben");
+    });
+
+    server.on("/api/trace/clear", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        traceClear();
+        sendSuccess(request, "Trace geleert");
+    });
+
+    // *** NEU: Stall-Log (übersteht Neustarts) löschen ***
+    server.on("/api/stalls/clear", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        clearStallLog();
+        sendSuccess(request, "Stall-Log gelöscht");
+    });
+
+    // *** NEU: Szenen-Burst-Benchmark (läuft im Loop-Task, Ergebnis unter ui.sceneBenchmark) ***
+    server.on("/api/ui/benchmark", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        uiRequestSceneBenchmark();
+        sendSuccess(request, "Szenen-Benchmark gestartet");
+    });
+
+
     // *** NEU: Converter Service API-Routen ***
     server.on("/api/buttons/save", HTTP_POST, [this](AsyncWebServerRequest *request) {
     String jsonData = request->getParam("buttonData", true)->value();
@@ -233,6 +324,7 @@ void WebServerManager::setupRoutes() {
 }
 
 void WebServerManager::serveFile(AsyncWebServerRequest *request, const String& path, const String& type) {
+    TRACE_SCOPE(TRACE_WEB_FILE);
     if (SPIFFS.exists(path)) {
         File file = SPIFFS.open(path, "r");
         if (file) {
@@ -278,8 +370,9 @@ void WebServerManager::handleNotFound(AsyncWebServerRequest *request) {
 }
 
 void WebServerManager::handleAPIStatus(AsyncWebServerRequest *request) {
+    TRACE_SCOPE(TRACE_WEB_STATUS);
     // KORRIGIERT: Größeren JSON-Buffer für alle Daten
-    DynamicJsonDocument doc(2048);  // War 1024 - zu klein für Button-Daten + Zeit
+    DynamicJsonDocument doc(16384);  // War 2048 - zusätzlich Bus-, Meldungs-, Timer-Rad-, Profiler- und UI-Statistik
     
     // System-Informationen
     doc["uptime"] = millis() / 1000;
@@ -309,6 +402,48 @@ void WebServerManager::handleAPIStatus(AsyncWebServerRequest *request) {
     doc["totalCollisions"] = totalCollisions;
     doc["totalRetries"] = totalRetries;
     
+    // Wartezeit-Verteilung (Sendepuffer → Bus) pro Priorität
+    JsonArray latencyArray = doc.createNestedArray("txLatency");
+    getPriorityLatencyStats(latencyArray);
+    JsonObject rateObj = doc.createNestedObject("rateLimited");
+    getRateLimitStats(rateObj);
+    JsonArray reportArray = doc.createNestedArray("periodicReports");
+    getReportSchedulerStats(reportArray);
+    JsonObject statusCacheObj = doc.createNestedObject("statusCache");
+    getStatusCacheStats(statusCacheObj);
+    JsonObject rxWorkObj = doc.createNestedObject("rxWork");
+    getRxWorkStats(rxWorkObj);
+    JsonObject timerObj = doc.createNestedObject("timerWheel");
+    getTimerWheelStats(timerObj);
+    JsonObject touchObj = doc.createNestedObject("touch");
+    getTouchStats(touchObj);
+    JsonObject profilerObj = doc.createNestedObject("profiler");
+    getProfilerStats(profilerObj);
+    JsonObject btnLatencyObj = doc.createNestedObject("btnLatency");
+    getBtnLatencyStats(btnLatencyObj);
+    JsonObject traceObj = doc.createNestedObject("trace");
+    getTraceStats(traceObj);
+    JsonObject stallObj = doc.createNestedObject("stalls");
+    getStallStats(stallObj);
+    JsonObject idleObj = doc.createNestedObject("idle");
+    getIdleStats(idleObj);
+    JsonObject cpuFreqObj = doc.createNestedObject("cpuFreq");
+    getCpuFreqStats(cpuFreqObj);
+    JsonObject bootObj = doc.createNestedObject("boot");
+    getBootStats(bootObj);
+    JsonObject snapshotObj = doc.createNestedObject("rtcSnapshot");
+    getRtcSnapshotStats(snapshotObj);
+    JsonObject uiObj = doc.createNestedObject("ui");
+    getUiStats(uiObj);
+    JsonObject labelCacheObj = doc.createNestedObject("labelCache");
+    getLabelCacheStats(labelCacheObj);
+    JsonObject iconsObj = doc.createNestedObject("icons");
+    getIconStats(iconsObj);
+    JsonObject spiBusObj = doc.createNestedObject("spiBus");
+    getSpiBusStats(spiBusObj);
+    JsonObject screensaverObj = doc.createNestedObject("screensaver");
+    getScreensaverStats(screensaverObj);
+    
     // Button-Daten hinzufügen
     JsonArray buttonArray = doc.createNestedArray("buttons");
     for (int i = 0; i < NUM_BUTTONS; i++) {
@@ -402,6 +537,7 @@ void WebServerManager::handleAPIGetConfig(AsyncWebServerRequest *request) {
 }
 
 void WebServerManager::handleAPISaveConfig(AsyncWebServerRequest *request) {
+    TRACE_SCOPE(TRACE_WEB_CONFIG);
     if (request->hasParam("deviceID", true)) {
         String newID = request->getParam("deviceID", true)->value();
         if (newID.length() == 4) {
@@ -431,6 +567,50 @@ void WebServerManager::handleAPISetBrightness(AsyncWebServerRequest *request) {
     }
 }
 
+void WebServerManager::handleAPIGetScreensaver(AsyncWebServerRequest *request) {
+    DynamicJsonDocument doc(512);
+    getScreensaverConfig(doc.to<JsonObject>());
+    sendJSON(request, doc, 200);
+}
+
+// Nicht übergebene Parameter behalten ihren Wert
+void WebServerManager::handleAPISetScreensaver(AsyncWebServerRequest *request) {
+    DynamicJsonDocument current(512);
+    JsonObject config = current.to<JsonObject>();
+    getScreensaverConfig(config);
+
+    int timeout = config["screenTimeout"];
+    bool enabled = config["screensaverEnabled"];
+    int dimPercent = config["dimPercent"];
+    int offDelay = config["offDelay"];
+    String wakeTelegrams = config["wakeTelegrams"].as<String>();
+
+    if (request->hasParam("screenTimeout", true)) {
+        timeout = request->getParam("screenTimeout", true)->value().toInt();
+    }
+    if (request->hasParam("screensaverEnabled", true)) {
+        String value = request->getParam("screensaverEnabled", true)->value();
+        enabled = (value == "true" || value == "1");
+    }
+    if (request->hasParam("dimPercent", true)) {
+        dimPercent = request->getParam("dimPercent", true)->value().toInt();
+    }
+    if (request->hasParam("offDelay", true)) {
+        offDelay = request->getParam("offDelay", true)->value().toInt();
+    }
+    if (request->hasParam("wakeTelegrams", true)) {
+        wakeTelegrams = request->getParam("wakeTelegrams", true)->value();
+    }
+
+    if (timeout < 0 || dimPercent < 0 || dimPercent > 100 || offDelay < 0) {
+        sendError(request, "Ungültige Bildschirmschoner-Parameter", 400);
+        return;
+    }
+
+    screensaverSetConfig(timeout, enabled, dimPercent, offDelay, wakeTelegrams);
+    sendSuccess(request, "Bildschirmschoner-Einstellungen gespeichert");
+}
+
 void WebServerManager::handleAPISetOrientation(AsyncWebServerRequest *request) {
     if (request->hasParam("value", true)) {
         int orientation = request->getParam("value", true)->value().toInt();
@@ -439,7 +619,9 @@ void WebServerManager::handleAPISetOrientation(AsyncWebServerRequest *request) {
             serviceManager.saveConfig();
             
             // Orientierung direkt anwenden - aber über öffentliche Methode
+            spiBusAcquire(SPI_BUS_DISPLAY);
             tft.setRotation(orientation);
+            spiBusRelease(SPI_BUS_DISPLAY);
             
             sendSuccess(request, "Orientierung geändert auf " + String(orientation == 0 ? "Portrait" : "Landscape"));
         } else {
@@ -722,7 +904,9 @@ void WebServerManager::handleSaveButtonConfig(AsyncWebServerRequest *request) {
             serviceManager.saveConfig();
             
             // Display-Orientierung sofort anwenden
+            spiBusAcquire(SPI_BUS_DISPLAY);
             tft.setRotation(orientation == 0 ? ROTATION_0 : ROTATION_270);
+            spiBusRelease(SPI_BUS_DISPLAY);
             
             Serial.println("✅ Orientierung mit gespeichert: " + String(orientation));
         }
@@ -1251,23 +1435,9 @@ String WebServerManager::color565ToHex(uint16_t color565) {
 }
 
 // Icon-Typ basierend auf Label bestimmen
+// *** GEÄNDERT: Gleiche Zuordnung wie die Icons auf dem Display (icons.cpp) ***
 String WebServerManager::getIconTypeFromLabel(String label) {
-    String lowerLabel = label;
-    lowerLabel.toLowerCase();
-    
-    if (lowerLabel.indexOf("licht") >= 0 || lowerLabel.indexOf("lampe") >= 0) {
-        return "LIGHT";
-    } else if (lowerLabel.indexOf("rollade") >= 0 || lowerLabel.indexOf("rolladen") >= 0) {
-        return "SHUTTER";
-    } else if (lowerLabel.indexOf("heizung") >= 0 || lowerLabel.indexOf("temperatur") >= 0) {
-        return "TEMPERATURE";
-    } else if (lowerLabel.indexOf("lüftung") >= 0 || lowerLabel.indexOf("ventil") >= 0) {
-        return "VENTILATION";
-    } else if (lowerLabel.indexOf("dimmer") >= 0) {
-        return "DIMMER";
-    } else {
-        return "SWITCH";
-    }
+    return iconTypeName(iconFromLabel(label));
 }
 
 // Icon für Icon-Typ zurückgeben
@@ -36,6 +36,8 @@ public:
     void handleAPIGetConfig(AsyncWebServerRequest *request);
     void handleAPISaveConfig(AsyncWebServerRequest *request);
     void handleAPISetBrightness(AsyncWebServerRequest *request);
+    void handleAPIGetScreensaver(AsyncWebServerRequest *request);   // *** NEU ***
+    void handleAPISetScreensaver(AsyncWebServerRequest *request);   // *** NEU ***
     void handleAPISetOrientation(AsyncWebServerRequest *request);
     void handleAPISetDeviceID(AsyncWebServerRequest *request);
     void handleAPIButtonControl(AsyncWebServerRequest *request);